@@ -0,0 +1,42 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <cstdint>
+
+// Heap allocation counters fed by the global operator new/delete replacement in
+// AllocationTracker.cpp. The hook only exists when built with the CMake option
+// ENGINE_TRACK_ALLOCATIONS; otherwise isCompiledIn() is false and every counter reads 0.
+//
+// Each allocation costs a few relaxed atomic adds plus a thread-local counter.
+// ProfileScope snapshots the thread-local counters so allocations are also
+// attributed to profiler zones (inclusive of child zones).
+class AllocationTracker
+{
+public:
+    static bool isCompiledIn();
+
+    // Frame boundary, main thread only (called next to Profiler::endFrame)
+    static void endFrame();
+
+    // Last completed frame, all threads
+    static uint64_t getFrameAllocations();
+    static uint64_t getFrameBytes();
+    static uint64_t getFrameFrees();
+    static uint64_t getPeakFrameAllocations(); // since the last resetBudgetStats()
+
+    // Monotonic totals for the calling thread (used by ProfileScope)
+    static void getThreadCounters(uint64_t& allocations, uint64_t& bytes);
+
+    // Allocations-per-frame budget, 0 = no budget.
+    // Every frame over budget is counted; the first one after a reset is logged.
+    static void setFrameBudget(uint64_t allocationsPerFrame);
+    static uint64_t getFrameBudget();
+    static uint64_t getFramesOverBudget();
+    static bool wasLastFrameOverBudget();
+
+    // Clears peak / over-budget counts and ignores the next ignoreFrames frames
+    // (e.g. the frame Test mode spawns its cube stack)
+    static void resetBudgetStats(int ignoreFrames = 0);
+};
+
+#endif // ALLOCATION_TRACKER_H
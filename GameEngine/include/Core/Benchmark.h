@@ -0,0 +1,148 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../include/Scene/RenderComponent.h"
+#include "../include/Physics/Trigger.h"
+#include "../include/Physics/ForceGenerator.h"
+
+class Scene;
+
+/**
+ * @brief A repeatable benchmark setup loaded from assets/benchmarks/*.json.
+ *
+ * Describes which scene to start from, what to spawn on top of it and how many
+ * frames to measure. The same file runs headless (HeadlessSim --scenario) or
+ * windowed (Test mode panel), so results are comparable across commits.
+ *
+ * Spawn groups use the same grid layout as the Test mode cube stack:
+ * index i goes to origin + spacing * (i % columns, i / (columns * rows), (i / columns) % rows).
+ */
+struct BenchmarkScenario
+{
+    struct SpawnGroup {
+        ShapeType shape = ShapeType::CUBE;
+        int count = 0;
+        glm::vec3 size{ 1.0f };
+        float mass = 1.0f;
+        std::string material = "Default";
+        glm::vec3 origin{ 0.0f, 10.0f, 0.0f };
+        float spacing = 2.0f;
+        int columns = 10;
+        int rows = 10;
+    };
+
+    struct TriggerGroup {
+        TriggerType type = TriggerType::SPEED_ZONE;
+        int count = 0;
+        glm::vec3 size{ 2.0f };
+        glm::vec3 origin{ 0.0f, 1.0f, 0.0f };
+        float spacing = 6.0f;                  // along +X
+        glm::vec3 force{ 0.0f, 1.0f, 0.0f };   // SPEED_ZONE direction * magnitude
+        glm::vec3 destination{ 0.0f, 20.0f, 0.0f }; // TELEPORT
+    };
+
+    struct GeneratorGroup {
+        ForceGeneratorType type = ForceGeneratorType::VORTEX;
+        int count = 0;
+        glm::vec3 origin{ 0.0f, 5.0f, 0.0f };
+        float spacing = 20.0f;                 // along +X
+        float radius = 15.0f;
+        float strength = 10.0f;
+        glm::vec3 direction{ 0.0f, 0.0f, 1.0f }; // WIND direction / VORTEX axis
+    };
+
+    std::string name;
+    std::string scenePath;      // resolved relative to the scenario file, empty = empty scene
+    bool groundPlane = true;    // 100x100 static ground, like the Test mode stack
+    std::vector<SpawnGroup> spawns;
+    std::vector<TriggerGroup> triggers;
+    std::vector<GeneratorGroup> generators;
+    int warmupFrames = 60;      // run but not recorded
+    int frames = 600;           // recorded frames (ticks when headless)
+    double fixedDt = 1.0 / 60.0;
+
+    static bool loadFromFile(const std::string& path, BenchmarkScenario& out);
+
+    // Loads the scene (or clears it) and spawns everything, bodies are left awake
+    bool populate(Scene& scene) const;
+};
+
+// Summary of one run, one CSV row / JSON object
+struct BenchmarkResult
+{
+    std::string scenario;
+    std::string mode;       // "headless" or "windowed"
+    std::string commit;     // ENGINE_GIT_COMMIT at configure time
+    std::string timestamp;  // UTC, ISO 8601
+    int frames = 0;
+    int rigidBodies = 0;
+    int physicsThreads = 1; // 1 = single-threaded world or Mt world on one thread
+
+    double frameMinMs = 0.0;
+    double frameAvgMs = 0.0;
+    double frameP50Ms = 0.0;
+    double frameP99Ms = 0.0;
+    double frameMaxMs = 0.0;
+
+    double physicsAvgMs = 0.0;
+    double physicsP99Ms = 0.0;
+    double physicsMaxMs = 0.0;
+
+    // Heap allocations, 0 unless built with ENGINE_TRACK_ALLOCATIONS
+    double allocsPerFrameAvg = 0.0;
+    uint64_t allocsPerFramePeak = 0;
+    double allocKBPerFrameAvg = 0.0;
+
+    double peakResidentMB = 0.0; // process peak working set / max RSS
+
+    // ".csv" appends a row (header written for new files, files with other columns
+    // are moved aside first), anything else writes JSON
+    bool writeToFile(const std::string& path) const;
+    void print() const;
+};
+
+/**
+ * @brief Collects per-frame samples for a running scenario.
+ *
+ * Call addFrame() once per frame after AllocationTracker::endFrame(); it returns
+ * true when the last recorded frame has been added and finish() can be called.
+ */
+class BenchmarkRecorder
+{
+public:
+    void begin(const BenchmarkScenario& scenario, const std::string& mode);
+    bool addFrame(double frameMs, double physicsMs);
+    BenchmarkResult finish(int rigidBodyCount);
+    void cancel() { running = false; }
+
+    bool isRunning() const { return running; }
+    const std::string& getScenarioName() const { return scenarioName; }
+    int getFramesDone() const { return framesDone; }
+    int getFramesTotal() const { return warmupFrames + recordFrames; }
+
+    bool hasLastResult() const { return hasResult; }
+    const BenchmarkResult& getLastResult() const { return lastResult; }
+
+private:
+    bool running = false;
+    std::string scenarioName;
+    std::string mode;
+    int warmupFrames = 0;
+    int recordFrames = 0;
+    int framesDone = 0;
+
+    std::vector<double> frameMs;
+    std::vector<double> physicsMs;
+    uint64_t totalAllocations = 0;
+    uint64_t totalAllocBytes = 0;
+    uint64_t peakAllocations = 0;
+
+    bool hasResult = false;
+    BenchmarkResult lastResult;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,164 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressed hash map from Key to a uint32_t index (linear probing,
+// backward-shift deletion, no tombstones). Keys and values live in one flat
+// array, so a lookup is a hash and a short scan of adjacent slots instead of
+// a bucket node per entry. Erasing never shrinks the table, so a map that
+// has reached its working size doesn't touch the heap again.
+//
+// Hash must return a well mixed value, the low bits pick the slot.
+// NotFound (0xFFFFFFFF) is reserved and can't be stored as a value.
+template <typename Key, typename Hash>
+class FlatHashMap
+{
+public:
+    static constexpr uint32_t NotFound = 0xFFFFFFFFu;
+
+    FlatHashMap() = default;
+
+    // NotFound if the key isn't in the map
+    uint32_t find(const Key& key) const
+    {
+        if (count == 0)
+            return NotFound;
+
+        for (size_t i = Hash()(key) & mask;; i = (i + 1) & mask)
+        {
+            const Slot& slot = slots[i];
+            if (slot.value == NotFound)
+                return NotFound;
+            if (slot.key == key)
+                return slot.value;
+        }
+    }
+
+    // Inserts or overwrites
+    void set(const Key& key, uint32_t value)
+    {
+        if ((count + 1) * 4 > slots.size() * 3)
+            grow();
+
+        for (size_t i = Hash()(key) & mask;; i = (i + 1) & mask)
+        {
+            Slot& slot = slots[i];
+            if (slot.value == NotFound)
+            {
+                slot.key = key;
+                slot.value = value;
+                count++;
+                return;
+            }
+            if (slot.key == key)
+            {
+                slot.value = value;
+                return;
+            }
+        }
+    }
+
+    bool erase(const Key& key)
+    {
+        if (count == 0)
+            return false;
+
+        size_t hole = Hash()(key) & mask;
+        for (;; hole = (hole + 1) & mask)
+        {
+            if (slots[hole].value == NotFound)
+                return false;
+            if (slots[hole].key == key)
+                break;
+        }
+
+        // Pull later entries of the probe run back into the hole so lookups
+        // never stop early at an empty slot
+        for (size_t next = (hole + 1) & mask;; next = (next + 1) & mask)
+        {
+            Slot& slot = slots[next];
+            if (slot.value == NotFound)
+                break;
+
+            size_t home = Hash()(slot.key) & mask;
+            bool homeBetween = hole <= next
+                ? (hole < home && home <= next)
+                : (hole < home || home <= next);
+            if (homeBetween)
+                continue;
+
+            slots[hole] = slot;
+            hole = next;
+        }
+
+        slots[hole].value = NotFound;
+        count--;
+        return true;
+    }
+
+    // Keeps the table allocated
+    void clear()
+    {
+        for (Slot& slot : slots)
+            slot.value = NotFound;
+        count = 0;
+    }
+
+    void reserve(size_t entries)
+    {
+        while (entries * 4 > slots.size() * 3)
+            grow();
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Iterate every entry, f(key, value)
+    template <typename Func>
+    void forEach(Func&& f) const
+    {
+        for (const Slot& slot : slots)
+            if (slot.value != NotFound)
+                f(slot.key, slot.value);
+    }
+
+private:
+    struct Slot
+    {
+        Key key{};
+        uint32_t value = NotFound;
+    };
+
+    void grow()
+    {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.resize(old.empty() ? 16 : old.size() * 2);
+        mask = slots.size() - 1;
+        count = 0;
+
+        for (const Slot& slot : old)
+            if (slot.value != NotFound)
+                set(slot.key, slot.value);
+    }
+
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t count = 0;
+};
+
+// 64-bit finalizer (MurmurHash3 fmix64), spreads clustered keys over the low bits
+inline uint64_t mixHash64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+#endif // FLAT_HASH_MAP_H
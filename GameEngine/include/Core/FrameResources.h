@@ -0,0 +1,31 @@
+#ifndef FRAME_RESOURCES_H
+#define FRAME_RESOURCES_H
+
+#include <cstdint>
+
+// Engine state touched by per-frame systems, used as read/write sets in TaskGraph.
+// Two tasks may run concurrently only if neither writes something the other touches.
+using FrameResourceMask = uint64_t;
+
+namespace FrameResource
+{
+    constexpr FrameResourceMask None            = 0;
+    constexpr FrameResourceMask SceneObjects    = 1ull << 0;  // gameObjects container (spawn/destroy)
+    constexpr FrameResourceMask Transforms      = 1ull << 1;  // GameObject position/rotation/scale
+    constexpr FrameResourceMask PhysicsPoses    = 1ull << 2;  // PhysicsComponent pose history
+    constexpr FrameResourceMask RenderPoses     = 1ull << 3;  // RenderComponent interpolated pose
+    constexpr FrameResourceMask SpatialGrid     = 1ull << 4;
+    constexpr FrameResourceMask PhysicsWorld    = 1ull << 5;  // Bullet world and bodies
+    constexpr FrameResourceMask Constraints     = 1ull << 6;
+    constexpr FrameResourceMask Triggers        = 1ull << 7;
+    constexpr FrameResourceMask ForceGenerators = 1ull << 8;
+    constexpr FrameResourceMask Materials       = 1ull << 9;
+    constexpr FrameResourceMask PointLights     = 1ull << 10;
+    constexpr FrameResourceMask DebugViews      = 1ull << 11; // DebugUIContext view structs
+    constexpr FrameResourceMask RenderSnapshot  = 1ull << 12;
+    constexpr FrameResourceMask GLContext       = 1ull << 13; // anything issuing GL/ImGui calls (main thread)
+
+    constexpr FrameResourceMask All = ~0ull;
+}
+
+#endif // FRAME_RESOURCES_H
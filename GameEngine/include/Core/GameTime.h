@@ -6,8 +6,16 @@
 
 //Time management class for tracking frame time, delta time, and FPS
 class Time {
+public:
+    //Frame statistics window and jitter histogram layout
+    static constexpr int FrameHistorySize = 600;     //last 10 s at 60 FPS
+    static constexpr int JitterBinCount = 33;        //odd so the middle bin is "on target"
+    static constexpr float JitterBinWidthMs = 0.25f; //bins cover roughly +-4ms around the target
+
 private:
-    using Clock = std::chrono::high_resolution_clock; //High-precision timer
+    //steady_clock is monotonic (high_resolution_clock may be the wall clock),
+    //which the absolute-deadline pacer relies on
+    using Clock = std::chrono::steady_clock;
     using TimePoint = std::chrono::time_point<Clock>; //A point in time
 
     //timing data
@@ -23,6 +31,27 @@ private:
     static bool fpsLimitEnabled;
     static float targetFrameTime;  //Target time per frame (1/targetFPS)
 
+    //Frame pacing (absolute deadlines, see WaitForNextFrame)
+    static TimePoint nextFrameDeadline; //when the next frame should start
+    static bool deadlineValid;
+    static float spinMargin;    //seconds spun before the deadline instead of slept, adapts to oversleep
+    static float lastOversleep; //how late the last sleep woke up (seconds)
+    static float lastSpinTime;  //seconds spent in the spin tail last frame
+
+    //Frame time statistics (ms), ring buffer over the last FrameHistorySize frames
+    static float frameTimeHistory[FrameHistorySize];
+    static int jitterBinHistory[FrameHistorySize]; //bin each sample was counted in
+    static int frameHistoryIndex;
+    static int frameHistoryCount;
+    static int jitterHistogram[JitterBinCount];
+    static float frameTimeP50;
+    static float frameTimeP95;
+    static float frameTimeP99;
+
+    static void RecordFrameTime(float frameTimeMs);
+    static void UpdateFramePercentiles();
+    static void SleepUntil(TimePoint wakeTime);
+
 public:
     //Initialize the time system (call once at startup)
     static void Initialize();
@@ -36,13 +65,31 @@ public:
     static float GetFPS() { return fps; }                   //Current FPS
     static int GetFrameCount() { return frameCount; }      //Total frames rendered
 
+    //Replaces this frame's delta time (input replay drives recorded frame times)
+    //call right after Update()
+    static void OverrideDeltaTime(float dt) { deltaTime = dt; }
+
     //FPS Limiting
     static void SetTargetFPS(float targetFPS);
     static void EnableFPSLimit(bool enable) { fpsLimitEnabled = enable; }
     static bool IsFPSLimitEnabled() { return fpsLimitEnabled; }
 
     //Wait if frame finished too quickly (for FPS limiting)
+    //Sleeps to an absolute deadline and only spins for a short adaptive tail
     static void WaitForNextFrame();
+
+    //Frame time percentiles over the history window (ms, refreshed every second)
+    static float GetFrameTimeP50() { return frameTimeP50; }
+    static float GetFrameTimeP95() { return frameTimeP95; }
+    static float GetFrameTimeP99() { return frameTimeP99; }
+
+    //Histogram of frame time minus the target frame time (or minus p50 when unlimited)
+    static const int* GetJitterHistogram() { return jitterHistogram; }
+
+    //Pacer diagnostics
+    static float GetSpinMargin() { return spinMargin; }
+    static float GetLastSpinTime() { return lastSpinTime; }
+    static float GetLastOversleep() { return lastOversleep; }
 };
 
 #endif //TIME_H
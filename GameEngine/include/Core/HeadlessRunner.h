@@ -0,0 +1,67 @@
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include <string>
+
+// Settings for a headless run (no window, no GL context, no ImGui)
+struct HeadlessConfig
+{
+    std::string scenePath;          // scene JSON to load, empty = built-in cube stack
+    std::string scenarioPath;       // benchmark scenario JSON, overrides scenePath/ticks/warmup/dt/cubes
+    std::string outputPath;         // write a BenchmarkResult here (.csv appends, otherwise JSON)
+    int ticks = 600;                // number of fixed ticks to simulate
+    int warmupTicks = 60;           // ticks run before timing starts (not counted in stats)
+    double fixedDt = 1.0 / 60.0;    // fixed timestep, same as the windowed engine
+    int stackCubeCount = 750;       // cube count for the built-in scene (matches Test mode)
+    int allocationBudget = 0;       // allocations per tick, 0 = none (needs ENGINE_TRACK_ALLOCATIONS)
+    int physicsThreads = 0;         // 0 = single-threaded world, N = btDiscreteDynamicsWorldMt on N threads (ENGINE_BULLET_MT)
+    std::string spatialIndex;       // "grid", "octree" or "aabbtree", empty = whatever the scene saved
+    int spatialQueriesPerTick = 0;  // radius + k-nearest query pairs per tick around object positions
+};
+
+// Timing results from a headless run, all tick times in milliseconds
+struct HeadlessStats
+{
+    int ticks = 0;
+    double totalSeconds = 0.0;      // wall time of the timed ticks, profiler drains included
+    double ticksPerSecond = 0.0;    // from the tick times alone
+    double avgTickMs = 0.0;
+    double minTickMs = 0.0;
+    double maxTickMs = 0.0;
+    double p50TickMs = 0.0;
+    double p99TickMs = 0.0;
+    int rigidBodyCount = 0;
+    int activeBodyCount = 0; // bodies still awake after the last tick
+    int physicsThreads = 1;
+
+    // Scene::updateSpatialGrid() plus the spatial queries, per tick
+    double avgSpatialMs = 0.0;
+
+    // Heap allocations per tick (0 unless built with ENGINE_TRACK_ALLOCATIONS)
+    double avgAllocationsPerTick = 0.0;
+    unsigned long long peakAllocationsPerTick = 0;
+    unsigned long long ticksOverBudget = 0;
+};
+
+// Steps Physics + Scene for a fixed number of ticks without GLFW or OpenGL.
+// The per-tick work mirrors the fixed-step block in Start() so the numbers are
+// comparable with the windowed engine. Without a scenario the scene path / cube
+// stack settings are turned into one, so every run goes through BenchmarkScenario.
+// Prints a summary and optionally fills outStats.
+// Returns 0 on success, -1 if the scenario/scene failed to load, or 1 if an allocation
+// budget was set and a timed tick exceeded it.
+int RunHeadless(const HeadlessConfig& config, HeadlessStats* outStats = nullptr);
+
+// Runs the same scenario with the multithreaded world on 1..maxThreads threads
+// (maxThreads 0 = every pool worker + the main thread) and prints the speed-up
+// of each count over one thread. Each run is appended to config.outputPath if set.
+// Needs the ENGINE_BULLET_MT build option.
+int RunHeadlessThreadSweep(const HeadlessConfig& config, int maxThreads = 0);
+
+// Runs the same scenario once per spatial index backend (grid, octree, aabbtree)
+// and prints the spatial update + query time of each next to the grid's.
+// config.spatialQueriesPerTick sets the query load. Each run is appended to
+// config.outputPath if set.
+int RunHeadlessSpatialSweep(const HeadlessConfig& config);
+
+#endif // HEADLESS_RUNNER_H
@@ -0,0 +1,97 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+// Debug-level messages compile out of release builds unless forced on with -DENGINE_LOG_DEBUG=1
+#ifndef ENGINE_LOG_DEBUG
+#ifdef NDEBUG
+#define ENGINE_LOG_DEBUG 0
+#else
+#define ENGINE_LOG_DEBUG 1
+#endif
+#endif
+
+enum class LogCategory : uint8_t
+{
+    Core,
+    Physics,
+    Trigger,
+    Scene,
+    Render,
+    Count
+};
+
+enum class LogLevel : uint8_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+// Asynchronous logger for messages that can fire per tick or per object.
+//
+// Producers format into a fixed-size slot of a lock-free bounded ring
+// (any thread may log) and a background writer thread drains it to
+// stdout (Debug/Info) or stderr (Warning/Error). A full ring drops the
+// message and counts it rather than blocking the frame. Before
+// initialize() and after shutdown() messages are written synchronously.
+//
+// Use the LOG_* macros so the message is only formatted when its
+// category/level is enabled:
+//   LOG_INFO(LogCategory::Physics, "Created body " << name);
+class Log
+{
+public:
+    static constexpr size_t MaxMessageLength = 240; // longer messages are truncated
+    static constexpr size_t RingCapacity = 4096;    // power of two
+
+    // Starts the writer thread (call once at startup)
+    static void initialize();
+
+    // Drains pending messages and stops the writer thread
+    static void shutdown();
+
+    // Runtime level per category, messages below it are skipped before formatting
+    static void setLevel(LogCategory category, LogLevel level);
+    static void setAllLevels(LogLevel level);
+    static LogLevel getLevel(LogCategory category);
+    static bool isEnabled(LogCategory category, LogLevel level);
+
+    static void write(LogCategory category, LogLevel level, const std::string& message);
+
+    // Messages lost because the ring was full
+    static uint64_t getDroppedCount();
+
+    static const char* getCategoryName(LogCategory category);
+    static const char* getLevelName(LogLevel level);
+
+    // Parses "debug", "info", "warn", "error" or "off"
+    static bool parseLevel(const std::string& text, LogLevel& out);
+};
+
+#define ENGINE_LOG_AT(category, level, expr) \
+    do { \
+        if (Log::isEnabled(category, level)) { \
+            std::ostringstream logStream_; \
+            logStream_ << expr; \
+            Log::write(category, level, logStream_.str()); \
+        } \
+    } while (0)
+
+#if ENGINE_LOG_DEBUG
+#define LOG_DEBUG(category, expr) ENGINE_LOG_AT(category, LogLevel::Debug, expr)
+#else
+#define LOG_DEBUG(category, expr) do { } while (0)
+#endif
+
+#define LOG_INFO(category, expr) ENGINE_LOG_AT(category, LogLevel::Info, expr)
+#define LOG_WARN(category, expr) ENGINE_LOG_AT(category, LogLevel::Warning, expr)
+#define LOG_ERROR(category, expr) ENGINE_LOG_AT(category, LogLevel::Error, expr)
+
+#endif // LOG_H
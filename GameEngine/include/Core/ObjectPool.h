@@ -0,0 +1,73 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-type object pool. Memory is allocated in chunks of ChunkSize objects
+// and freed slots are reused LIFO, so mass spawn/despawn doesn't touch the
+// heap after warm-up and live objects stay packed in a few large blocks.
+//
+// The pool doesn't track which slots are live: every create() must be paired
+// with a destroy() before the pool itself is destroyed.
+template <typename T, size_t ChunkSize = 256>
+class ObjectPool
+{
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        if (freeSlots.empty())
+            addChunk();
+
+        void* memory = freeSlots.back();
+        freeSlots.pop_back();
+        T* object = ::new (memory) T(std::forward<Args>(args)...);
+        liveCount++;
+        return object;
+    }
+
+    void destroy(T* object)
+    {
+        if (!object)
+            return;
+
+        object->~T();
+        freeSlots.push_back(object);
+        liveCount--;
+    }
+
+    size_t getLiveCount() const { return liveCount; }
+    size_t getCapacity() const { return chunks.size() * ChunkSize; }
+
+private:
+    // Raw, correctly aligned storage for one T
+    struct alignas(alignof(T)) Slot
+    {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    void addChunk()
+    {
+        chunks.push_back(std::unique_ptr<Slot[]>(new Slot[ChunkSize]));
+        Slot* chunk = chunks.back().get();
+
+        // Reversed so the first create() after a new chunk takes its first slot
+        freeSlots.reserve(freeSlots.size() + ChunkSize);
+        for (size_t i = ChunkSize; i > 0; i--)
+            freeSlots.push_back(&chunk[i - 1]);
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    std::vector<void*> freeSlots;
+    size_t liveCount = 0;
+};
+
+#endif // OBJECT_POOL_H
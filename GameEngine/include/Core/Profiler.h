@@ -0,0 +1,125 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One completed CPU zone. Names must be string literals (stored by pointer).
+struct ProfileZoneEvent
+{
+    const char* name = nullptr;
+    uint64_t startNs = 0;   // nanoseconds since profiler start
+    uint64_t endNs = 0;
+    uint32_t depth = 0;     // nesting depth on its thread, 0 = outermost zone
+    uint32_t threadIndex = 0;
+    uint32_t allocCount = 0; // heap allocations inside the zone (ENGINE_TRACK_ALLOCATIONS builds)
+    uint64_t allocBytes = 0;
+};
+
+// Hierarchical CPU frame profiler.
+// Zones are recorded with PROFILE_SCOPE("Name") into a per-thread ring buffer
+// (single producer = owning thread, single consumer = main thread in endFrame),
+// so recording never takes a lock. The main thread drains every buffer once per
+// frame and keeps the last frame for the flame view in ProfilerPanel.
+// A capture of N frames can be exported as Chrome trace_event JSON
+// (open in chrome://tracing or https://ui.perfetto.dev).
+class Profiler
+{
+public:
+    static Profiler& getInstance();
+
+    // Frame boundaries, main thread only.
+    // beginFrame() at the top of the main loop, endFrame() after the buffer swap.
+    void beginFrame();
+    void endFrame();
+
+    void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Called by ProfileScope, safe from any thread
+    void recordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth,
+        uint32_t allocCount = 0, uint64_t allocBytes = 0);
+    uint64_t nowNs() const;
+
+    // Record the next frameCount frames and write them to path as Chrome trace JSON
+    void startCapture(int frameCount, const std::string& path);
+    bool isCapturing() const { return captureFramesLeft > 0; }
+    const std::string& getLastCapturePath() const { return lastCapturePath; }
+
+    // Last completed frame (main thread only, valid until the next endFrame)
+    const std::vector<ProfileZoneEvent>& getLastFrameEvents() const { return lastFrameEvents; }
+    uint64_t getLastFrameStartNs() const { return lastFrameStartNs; }
+    uint64_t getLastFrameEndNs() const { return lastFrameEndNs; }
+    uint32_t getThreadCount() const;
+    uint64_t getDroppedZoneCount() const { return droppedZones.load(std::memory_order_relaxed); }
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Fixed-size SPSC ring, one per thread that has recorded a zone
+    struct ThreadBuffer
+    {
+        static constexpr uint32_t Capacity = 8192; // power of two
+        ProfileZoneEvent events[Capacity];
+        std::atomic<uint32_t> head{ 0 }; // written by the owning thread
+        std::atomic<uint32_t> tail{ 0 }; // written by the draining thread
+        uint32_t threadIndex = 0;
+    };
+
+    ThreadBuffer* getThreadBuffer();
+    void drainBuffers(std::vector<ProfileZoneEvent>& out);
+    bool writeChromeTrace(const std::string& path) const;
+
+    std::atomic<bool> enabled{ true };
+    uint64_t epochNs = 0;
+
+    // Buffers are never freed before shutdown so threads can keep raw pointers
+    mutable std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::atomic<uint64_t> droppedZones{ 0 };
+
+    // Frame state (main thread)
+    uint64_t frameStartNs = 0;
+    uint64_t lastFrameStartNs = 0;
+    uint64_t lastFrameEndNs = 0;
+    std::vector<ProfileZoneEvent> frameEvents;     // reused every frame
+    std::vector<ProfileZoneEvent> lastFrameEvents;
+
+    // Capture state (main thread)
+    int captureFramesLeft = 0;
+    std::string capturePath;
+    std::string lastCapturePath;
+    std::vector<ProfileZoneEvent> captureEvents;
+};
+
+// RAII zone, records [construction, destruction) on the current thread
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t startNs;
+    uint32_t depth;
+    uint64_t startAllocs = 0; // thread allocation counters at zone entry
+    uint64_t startAllocBytes = 0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Times the enclosing scope: PROFILE_SCOPE("Physics::update");
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif // PROFILER_H
@@ -0,0 +1,26 @@
+#ifndef SPATIAL_GRID_BENCHMARK_H
+#define SPATIAL_GRID_BENCHMARK_H
+
+// Settings for the SpatialGrid micro-benchmark (HeadlessSim --spatial-bench)
+struct SpatialBenchConfig
+{
+    int objectCount = 10000;    // objects scattered over a 400 x 40 x 400 area
+    int frames = 60;            // update passes, every object moves a little per pass
+    int queries = 10000;        // radius queries at random points
+    float queryRadius = 15.0f;
+    float cellSize = 10.0f;
+    int k = 8;                  // k-nearest queries at the same points
+    float kRadius = 50.0f;
+    unsigned seed = 1234;       // same layout and queries on every run
+    int repeats = 5;            // each phase reports its fastest run
+};
+
+// Times insert, per-frame update and radius/nearest/k-nearest queries on SpatialGrid
+// against the previous node-based grid (unordered_map of unordered_sets) with the
+// same objects and queries, and prints both along with the speed-up. The two grids
+// alternate over config.repeats fresh runs and each phase keeps its fastest time,
+// so a noisy machine does not skew one side.
+// Returns 0, or 1 if the two grids disagree on a query result.
+int RunSpatialGridBenchmark(const SpatialBenchConfig& config);
+
+#endif // SPATIAL_GRID_BENCHMARK_H
@@ -0,0 +1,76 @@
+#ifndef STARTUP_TIMELINE_H
+#define STARTUP_TIMELINE_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Wall-clock timeline of engine startup, printed once the first frame is on screen.
+// Steps are recorded with STARTUP_SCOPE("Name") from the main thread or from pool
+// workers running startup tasks, so the overlap between CPU loading and GL setup
+// is visible next to the total time-to-first-frame.
+class StartupTimeline
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static StartupTimeline& getInstance();
+
+    // Start of the timeline (first thing in Start())
+    void begin();
+
+    // Called by StartupScope, safe from any thread
+    void record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    // Ends the timeline and prints it, later calls do nothing
+    void markFirstFrame();
+
+    // Time-to-first-frame above this is reported as over budget, 0 = no budget
+    void setBudgetMs(double ms) { budgetMs = ms; }
+    double getBudgetMs() const { return budgetMs; }
+
+    double getTimeToFirstFrameMs() const { return timeToFirstFrameMs; }
+    bool hasFirstFrame() const { return firstFrameDone; }
+
+    void print() const;
+
+private:
+    StartupTimeline() = default;
+
+    struct Step
+    {
+        const char* name;
+        double startMs; // relative to begin()
+        double endMs;
+        int worker;     // pool worker index, -1 = main thread
+    };
+
+    Clock::time_point startTime = Clock::now();
+    mutable std::mutex stepsMutex;
+    std::vector<Step> steps;
+    double budgetMs = 0.0;
+    double timeToFirstFrameMs = 0.0;
+    bool firstFrameDone = false;
+};
+
+// Records the enclosing block as one startup step. name must be a string literal.
+class StartupScope
+{
+public:
+    explicit StartupScope(const char* name) : name(name), start(StartupTimeline::Clock::now()) {}
+    ~StartupScope() { StartupTimeline::getInstance().record(name, start, StartupTimeline::Clock::now()); }
+
+    StartupScope(const StartupScope&) = delete;
+    StartupScope& operator=(const StartupScope&) = delete;
+
+private:
+    const char* name;
+    StartupTimeline::Clock::time_point start;
+};
+
+#define STARTUP_SCOPE_CONCAT_INNER(a, b) a##b
+#define STARTUP_SCOPE_CONCAT(a, b) STARTUP_SCOPE_CONCAT_INNER(a, b)
+#define STARTUP_SCOPE(name) StartupScope STARTUP_SCOPE_CONCAT(startupScope_, __LINE__)(name)
+
+#endif // STARTUP_TIMELINE_H
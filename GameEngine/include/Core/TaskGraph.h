@@ -0,0 +1,70 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include "FrameResources.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Small declarative dependency graph for per-frame engine systems.
+ *
+ * Tasks are added in the order the serial frame would run them, each with the
+ * set of FrameResources it reads and writes. A task depends on every earlier
+ * task it conflicts with (write/read, read/write or write/write on a shared
+ * bit), so the result is always equivalent to running them in insertion order.
+ * Tasks with disjoint sets run concurrently on the ThreadPool.
+ *
+ * Tasks writing FrameResource::GLContext always run on the thread calling
+ * execute(), since GL and ImGui calls are tied to the main thread.
+ *
+ * Build the graph once and call execute() every frame: tasks should capture
+ * references to state that outlives the graph, so steady-state frames don't
+ * allocate. Edge building is O(n^2), fine for a handful of systems.
+ */
+class TaskGraph {
+public:
+    using TaskId = int;
+
+    // name must be a string literal (used as the profiler zone name)
+    TaskId addTask(const char* name, FrameResourceMask reads, FrameResourceMask writes, std::function<void()> fn);
+
+    // Runs every task and blocks until all have finished. The calling thread helps.
+    void execute(ThreadPool& pool);
+
+    void clear();
+    size_t getTaskCount() const { return tasks.size(); }
+
+    // Number of dependencies of a task, for debugging the generated graph
+    int getDependencyCount(TaskId id) const;
+
+private:
+    struct Task {
+        const char* name = nullptr;
+        FrameResourceMask reads = 0;
+        FrameResourceMask writes = 0;
+        std::function<void()> fn;
+        std::vector<TaskId> dependents;
+        int dependencyCount = 0;
+        std::atomic<int> remainingDependencies{ 0 };
+        bool mainThreadOnly = false;
+    };
+
+    void runTask(TaskId id);
+    void schedule(TaskId id);
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    ThreadPool* pool = nullptr; // set for the duration of execute()
+
+    std::atomic<int> tasksRemaining{ 0 };
+
+    // Main-thread-only tasks that became ready, picked up by the execute() loop
+    std::vector<TaskId> readyMainThreadTasks;
+    std::atomic<int> readyMainThreadCount{ 0 };
+    std::atomic_flag mainQueueLock = ATOMIC_FLAG_INIT;
+};
+
+#endif // TASK_GRAPH_H
@@ -0,0 +1,105 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool shared by engine systems.
+ *
+ * Each worker owns a deque: it pushes/pops its own work at the back (LIFO, cache
+ * warm) and steals from the front of other workers' deques when it runs dry.
+ * Tasks submitted from outside the pool are spread round-robin.
+ *
+ * Threads waiting on pool work (TaskGraph::execute, parallelFor) should call
+ * tryRunPendingTask() instead of blocking, so a wait never idles a core and
+ * a pool with zero workers still makes progress on the calling thread.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    static ThreadPool& getInstance();
+
+    // threadCount = 0 uses hardware_concurrency - 1 (the main thread also runs tasks)
+    void initialize(unsigned int threadCount = 0);
+    void shutdown();
+
+    void submit(Task task);
+
+    // Run one queued task on the calling thread, returns false if none was found
+    bool tryRunPendingTask();
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    // Index of the calling pool worker, -1 for threads outside the pool
+    static int getCurrentWorkerIndex();
+
+private:
+    ThreadPool() = default;
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(unsigned int index);
+    bool popLocal(unsigned int index, Task& out);
+    bool steal(unsigned int thiefIndex, Task& out);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // one per worker, plus one for outside threads when there are no workers
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<int> pendingTasks{ 0 };
+    std::atomic<unsigned int> nextQueue{ 0 };
+    bool stopping = false;
+};
+
+/**
+ * @brief Tracks a batch of pool tasks so the submitter can wait for just those.
+ *
+ * Used for one-off fan-out work such as startup loading; per-frame systems go
+ * through TaskGraph. wait() helps with pool work like TaskGraph::execute, and
+ * the destructor waits so captured locals outlive the tasks.
+ *
+ * Hot paths that fan out every frame (Bullet's parallel loops, raycast batches)
+ * use run(Job&) instead: the pool task only holds a pointer to the caller's Job,
+ * so std::function stores it inline and nothing is heap allocated per range.
+ */
+class TaskGroup {
+public:
+    // Function pointer + context, owned by the caller until wait() returns
+    struct Job {
+        void (*function)(void* context) = nullptr;
+        void* context = nullptr;
+        TaskGroup* group = nullptr; // set by run()
+    };
+
+    explicit TaskGroup(ThreadPool& pool) : pool(pool) {}
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(ThreadPool::Task task);
+    void run(Job& job);
+    void wait();
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    ThreadPool& pool;
+    std::atomic<int> pending{ 0 };
+};
+
+#endif // THREAD_POOL_H
@@ -2,6 +2,7 @@
 
 #include "TimeDebugView.h"
 #include "PhysicsDebugView.h"
+#include "MemoryDebugView.h"
 #include "SceneDebugCommands.h"
 #include "LightingDebugCommands.h"
 #include "ConstraintDebugView.h"
@@ -14,6 +15,7 @@ struct DebugUIContext
 {
     TimeDebugView time;
     PhysicsDebugView physics;
+    MemoryDebugView memory;
     SceneDebugCommands scene;
     LightingDebugCommands lighting;
     ConstraintDebugView constraints;
@@ -25,5 +27,7 @@ struct DebugUIContext
     GameObject* selectedObject = nullptr;
 
     std::function<void()> applyTriggerScripts;
+    // Threads for the multithreaded physics world (applied before the next step)
+    std::function<void(int)> setPhysicsThreadCount;
 
 };
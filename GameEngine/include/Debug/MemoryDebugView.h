@@ -0,0 +1,16 @@
+#pragma once
+
+// Heap allocation stats for the last frame (see AllocationTracker)
+struct MemoryDebugView
+{
+    bool trackingCompiledIn = false; // built with ENGINE_TRACK_ALLOCATIONS
+
+    int allocationsPerFrame = 0;
+    int freesPerFrame = 0;
+    float kilobytesPerFrame = 0.0f;
+    int peakAllocationsPerFrame = 0;
+
+    // Budget set from the Test panel, 0 = none
+    int allocationBudget = 0;
+    int framesOverBudget = 0;
+};
@@ -6,7 +6,15 @@
 struct PhysicsDebugView
 {
     int rigidBodyCount;
+    int collisionShapeCount;   // distinct shapes shared by the rigid bodies
+    int broadphasePairs = 0;   // overlapping pairs left after layer filtering
     bool physicsEnabled;
+    float tickRate;            // fixed physics ticks per second
+    float interpolationAlpha;  // render blend between the last two ticks
+    bool pipelined;            // physics stepping overlapped with rendering (P)
+    bool multithreaded = false; // btDiscreteDynamicsWorldMt (ENGINE_BULLET_MT)
+    int solverThreads = 1;
+    int maxSolverThreads = 1;
 
     // Available materials for dropdown
     std::vector<std::string> availableMaterials;
@@ -42,6 +42,8 @@ struct SceneDebugCommands
     )> loadAndSpawnModel;
     //
     std::function<void(GameObject*, const glm::vec3&)> setObjectPhysicsScale;
+    // Move a physics object to another collision layer (CollisionLayers index)
+    std::function<void(GameObject*, int)> setObjectCollisionLayer;
 	// Set object scale (handles both render and physics resizing)
     std::function<void(GameObject*, const glm::vec3&)> setObjectScale;
 
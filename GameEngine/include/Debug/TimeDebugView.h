@@ -4,4 +4,18 @@ struct TimeDebugView
 {
     float deltaTime;
     float fps;
-};
\ No newline at end of file
+
+    // Frame time percentiles over the last Time::FrameHistorySize frames (ms)
+    float frameTimeP50;
+    float frameTimeP95;
+    float frameTimeP99;
+
+    // Frame time minus target, Time::JitterBinCount bins of jitterBinWidthMs centred on 0
+    const int* jitterHistogram = nullptr;
+    int jitterBinCount = 0;
+    float jitterBinWidthMs = 0.0f;
+
+    // Pacer: spin tail kept before each deadline and time actually spun last frame (ms)
+    float spinMarginMs;
+    float lastSpinMs;
+};
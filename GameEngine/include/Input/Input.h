@@ -1,10 +1,29 @@
 ﻿#pragma once
 #include <GLFW/glfw3.h>
+#include <cstdint>
 
 class CameraController;
 
 namespace Input
 {
+    constexpr int MaxKeys = 1024;
+    constexpr int MaxMouseButtons = 8;
+
+    // State bits stored per key / mouse button in InputState
+    constexpr uint8_t StateDown = 1 << 0;
+    constexpr uint8_t StatePressed = 1 << 1;
+    constexpr uint8_t StateReleased = 1 << 2;
+
+    // Everything the query functions return for one frame.
+    // Used by InputReplay to record a session and play it back.
+    struct InputState
+    {
+        uint8_t keys[MaxKeys] = {};
+        uint8_t mouseButtons[MaxMouseButtons] = {};
+        double mouseDeltaX = 0.0;
+        double mouseDeltaY = 0.0;
+    };
+
     // Must be called once after window creation.
     // Registers all GLFW callbacks for keyboard and mouse input
     void Initialize(GLFWwindow* window);
@@ -29,4 +48,14 @@ namespace Input
     // Sets the active camera controller to receive mouse movement.
     // Used for editor orbit / free-look camera control
     void SetCameraController(CameraController* controller);
+
+    // Copies this frame's input state (call after glfwPollEvents)
+    void CaptureState(InputState& out);
+
+    // Replaces this frame's input state, call after glfwPollEvents so the
+    // callbacks don't overwrite it. Used for replaying a recorded session.
+    void ApplyState(const InputState& state);
+
+    // Releases every key and button, e.g. when a replay ends mid-hold
+    void ResetState();
 }
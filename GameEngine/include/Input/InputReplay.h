@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <glm/glm.hpp>
+#include "../include/Core/Engine.h"
+#include "Input.h"
+
+// Records per-frame input, delta time and fixed tick counts to a compact
+// binary log, and plays it back so the exact same session can be profiled
+// before and after a change.
+//
+// File layout (little endian):
+//   header  "EINP", version, fixedDt, pipelined flag, start mode, camera,
+//           scene snapshot path, frame count, tick count
+//   frames  deltaTime (float), fixedTicks (u16), mode (u8), flags (u8),
+//           changed key count (u16) + (key u16, state u8) per changed key,
+//           [mouse button states, 8 x u8]  if flags & MouseButtons
+//           [mouse delta x/y, 2 x double]  if flags & MouseDelta
+// Keys are stored as changes against the previous frame, so a frame
+// with no input activity is 10 bytes.
+namespace InputReplay
+{
+    // State the session starts from, restored before the first replayed frame
+    struct SessionHeader
+    {
+        double fixedDt = 1.0 / 60.0;
+        bool pipelinedPhysics = false;
+        EngineMode mode = EngineMode::Game;
+        glm::vec3 cameraPosition{ 0.0f };
+        float cameraYaw = 0.0f;
+        float cameraPitch = 0.0f;
+        std::string scenePath; // scene saved when recording started
+
+        // Filled in when the recording is closed
+        uint32_t frameCount = 0;
+        uint32_t tickCount = 0;
+    };
+
+    struct Frame
+    {
+        float deltaTime = 0.0f;
+        int fixedTicks = 0;
+        EngineMode mode = EngineMode::Game;
+        Input::InputState input;
+    };
+
+    // --- Recording ---
+    bool StartRecording(const std::string& path, const SessionHeader& header);
+
+    // Call once per frame after the fixed ticks have run.
+    // Captures the current Input state along with the frame's timing.
+    void RecordFrame(float deltaTime, int fixedTicks, EngineMode mode);
+
+    void StopRecording();
+    bool IsRecording();
+
+    // --- Replay ---
+    bool StartReplay(const std::string& path, SessionHeader& header);
+
+    // Reads the next frame, returns false (and stops) at the end of the log
+    bool NextFrame(Frame& out);
+
+    void StopReplay();
+    bool IsReplaying();
+
+    // Frames recorded / replayed so far and the replay's total (0 if unknown)
+    uint32_t GetFrameIndex();
+    uint32_t GetFrameCount();
+}
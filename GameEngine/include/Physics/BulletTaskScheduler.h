@@ -0,0 +1,50 @@
+#ifndef BULLET_TASK_SCHEDULER_H
+#define BULLET_TASK_SCHEDULER_H
+
+// Only built with the ENGINE_BULLET_MT option (Bullet compiled with BT_THREADSAFE)
+#ifdef ENGINE_BULLET_MT
+
+#include <LinearMath/btThreads.h>
+
+class ThreadPool;
+
+/**
+ * @brief Bullet task scheduler that runs btParallelFor/btParallelSum on the
+ * engine ThreadPool instead of Bullet's own threads.
+ *
+ * Used by btDiscreteDynamicsWorldMt (island solving, narrowphase, integration).
+ * A loop is split into at most getNumThreads() contiguous ranges; the calling
+ * thread runs the first range and helps with pool work until the rest finish,
+ * so one thread means the loop runs inline.
+ *
+ * getMaxNumThreads() counts every thread that can touch Bullet's per-thread
+ * arrays (workers plus two stepping threads), which is one more than the
+ * number of threads a loop is split across. getNumThreads() starts at that
+ * full count so the Mt dispatcher is built with enough slots; call
+ * setNumThreads() afterwards to drop to the loop count.
+ */
+class BulletTaskScheduler : public btITaskScheduler {
+public:
+    explicit BulletTaskScheduler(ThreadPool& pool);
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override { return numThreads; }
+    void setNumThreads(int numThreads) override;
+
+    // Threads that can work on one loop: pool workers plus the calling thread
+    int getMaxLoopThreads() const;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    ThreadPool& pool;
+    int numThreads;
+
+    // Number of ranges to split [iBegin, iEnd) into
+    int rangeCount(int iBegin, int iEnd, int grainSize) const;
+};
+
+#endif // ENGINE_BULLET_MT
+
+#endif // BULLET_TASK_SCHEDULER_H
@@ -0,0 +1,82 @@
+#ifndef COLLISION_LAYERS_H
+#define COLLISION_LAYERS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Named collision layers and the matrix of which layers collide.
+ *
+ * Each layer is one bit of Bullet's broadphase filter group; its mask is the
+ * layer's row of the matrix. Bodies are added with
+ * addRigidBody(body, getGroup(layer), getMask(layer)) and trigger ghosts with
+ * addCollisionObject(...), so pairs between layers that don't collide
+ * (e.g. Static vs Static, Trigger vs Static) never reach the narrowphase.
+ *
+ * Bit 15 (QueryGroup) is reserved for scene queries: every mask includes it,
+ * so rays/sweeps that use it as their group can still hit every layer.
+ *
+ * The layers and matrix are saved with the scene ("collisionLayers").
+ * Physics re-applies the filters to existing objects before the next step
+ * whenever getVersion() changes.
+ */
+class CollisionLayers {
+public:
+    static constexpr int MaxLayers = 15;
+    static constexpr int QueryGroup = 1 << 15;
+
+    // Built-in layers, always present at these indices
+    enum DefaultLayer {
+        Static = 0,
+        Dynamic,
+        Player,
+        Trigger,
+        Debris,
+        DefaultLayerCount
+    };
+
+    static CollisionLayers& getInstance();
+
+    int getLayerCount() const { return static_cast<int>(names.size()); }
+    const std::string& getLayerName(int layer) const;
+
+    // -1 if there is no layer with that name
+    int findLayer(const std::string& name) const;
+
+    // Returns the existing index for a known name, -1 when all layers are used
+    int addLayer(const std::string& name);
+
+    bool shouldCollide(int layerA, int layerB) const;
+    // Symmetric, sets both A-B and B-A
+    void setCollides(int layerA, int layerB, bool collide);
+
+    // Broadphase filter values for a layer (invalid layers collide with everything)
+    int getGroup(int layer) const;
+    int getMask(int layer) const;
+
+    // Bumped on every matrix/layer change
+    uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+
+    // Built-in layers and matrix, custom layers are removed
+    void resetDefaults();
+
+    // Layer used by bodies that don't specify one
+    static int defaultLayerForMass(float mass) { return mass > 0.0f ? Dynamic : Static; }
+
+private:
+    CollisionLayers();
+    CollisionLayers(const CollisionLayers&) = delete;
+    CollisionLayers& operator=(const CollisionLayers&) = delete;
+
+    bool isValid(int layer) const { return layer >= 0 && layer < getLayerCount(); }
+
+    std::vector<std::string> names;          // main thread only
+    // Row per layer, bit N = collides with layer N. Atomic because the physics
+    // thread reads it while re-applying filters.
+    std::atomic<uint32_t> matrix[MaxLayers];
+    std::atomic<uint64_t> version{ 1 };
+};
+
+#endif // COLLISION_LAYERS_H
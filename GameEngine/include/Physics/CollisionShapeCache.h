@@ -0,0 +1,75 @@
+#ifndef COLLISION_SHAPE_CACHE_H
+#define COLLISION_SHAPE_CACHE_H
+
+#include <btBulletDynamicsCommon.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+enum class ShapeType;
+
+/**
+ * @brief Reference-counted pool of rigid body collision shapes.
+ *
+ * Bodies with the same shape type and (quantized) size share one
+ * btCollisionShape, so a scene of identical cubes holds a single btBoxShape.
+ * Shapes are immutable once shared: never call setLocalScaling or similar on
+ * a shape obtained here, resize the body instead (Physics::resizeRigidBody).
+ *
+ * Each shape's user pointer refers back to its cache entry, which makes
+ * release() O(1).
+ */
+class CollisionShapeCache {
+public:
+    // Sizes closer than this (in metres) map to the same shape
+    static constexpr float Quantum = 1.0e-4f;
+
+    CollisionShapeCache() = default;
+    ~CollisionShapeCache();
+
+    CollisionShapeCache(const CollisionShapeCache&) = delete;
+    CollisionShapeCache& operator=(const CollisionShapeCache&) = delete;
+
+    // Returns a shape for type/size (same size convention as Physics::createRigidBody)
+    // and adds a reference to it. Creates the shape on first use.
+    btCollisionShape* acquire(ShapeType type, const glm::vec3& size);
+
+    // Drops one reference, the shape is deleted with its last reference.
+    // Shapes that didn't come from this cache are ignored.
+    void release(btCollisionShape* shape);
+
+    // Deletes every shape regardless of references (physics teardown)
+    void clear();
+
+    size_t getShapeCount() const { return entries.size(); }
+    int getReferenceCount(const btCollisionShape* shape) const;
+
+private:
+    struct Key {
+        int type;
+        int32_t x, y, z;
+
+        bool operator==(const Key& other) const {
+            return type == other.type && x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        btCollisionShape* shape = nullptr;
+        int refCount = 0;
+        const Key* key = nullptr; // points at the map's own key, for erase on release
+    };
+
+    // Node-based map: entry addresses stay valid while other entries come and go
+    std::unordered_map<Key, Entry, KeyHash> entries;
+
+    static Key makeKey(ShapeType type, const glm::vec3& size);
+    static btCollisionShape* createShape(ShapeType type, const glm::vec3& size);
+};
+
+#endif // COLLISION_SHAPE_CACHE_H
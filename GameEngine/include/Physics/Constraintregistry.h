@@ -6,6 +6,7 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <cstdint>
 
 class GameObject;
 class btDiscreteDynamicsWorld;
@@ -18,6 +19,7 @@ private:
     std::unordered_map<std::string, Constraint*> nameIndex;
     std::unordered_map<GameObject*, std::vector<Constraint*>> objectIndex;
     btDiscreteDynamicsWorld* dynamicsWorld;
+    uint64_t version = 0; // bumped whenever the constraint list changes
 
     ConstraintRegistry();
 
@@ -48,6 +50,8 @@ public:
     std::vector<Constraint*> findBreakableConstraints() const;
     std::vector<Constraint*> getAllConstraints() const;
     bool hasConstraint(const std::string& name) const;
+    // Changes on add/remove/break, lets cached views skip rebuilding
+    uint64_t getVersion() const { return version; }
 
     // Update
     void update();
@@ -0,0 +1,93 @@
+#ifndef CONTACT_EVENTS_H
+#define CONTACT_EVENTS_H
+
+#include <btBulletDynamicsCommon.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class GameObject;
+
+enum class ContactEventType {
+    Enter,
+    Stay,
+    Exit
+};
+
+// One touching pair, reported for both objects. normal points from B towards A.
+// Exit events carry the last contact point seen before the pair separated, impulse 0.
+struct ContactEvent {
+    ContactEventType type;
+    GameObject* objectA;
+    GameObject* objectB;
+    glm::vec3 point;
+    glm::vec3 normal;
+    float impulse;
+};
+
+/**
+ * @brief Collision enter/stay/exit events built from the dispatcher's manifolds.
+ *
+ * collect() runs once after each stepSimulation: it walks the persistent
+ * manifolds, keeps one entry per touching pair (a manifold touches when one of
+ * its points has distance <= 0, the rest are speculative), keyed by the sorted body
+ * pointers) and merges the sorted list against the previous step's list to
+ * queue Enter, Stay and Exit events. Both pair lists and the queue are
+ * reused, so a step makes no per-pair heap allocations once they have grown.
+ *
+ * Pairs with a trigger ghost (no contact response) are left to Trigger, and
+ * pairs where neither body belongs to a GameObject are ignored.
+ *
+ * collect() may run on the physics worker (PhysicsStepThread); forget() and
+ * takeEvents() run on the main thread while no step is running. forget() only
+ * records the body, both lists are compacted once for all removals at the next
+ * collect() or takeEvents(), so destroying many bodies in a frame stays linear.
+ */
+class ContactEvents {
+public:
+    // Diff this step's touching pairs against the previous step's
+    void collect(btDispatcher& dispatcher);
+
+    // Drop a body about to be removed: its pairs end without an Exit event
+    // and queued events that reference it are discarded (deferred, see above)
+    void forget(const btCollisionObject* body);
+
+    // Swaps the queued events into out (cleared first), pass the same vector
+    // every time so neither side reallocates
+    void takeEvents(std::vector<ContactEvent>& out);
+
+    void clear();
+
+    size_t getTouchingPairCount() const { return previousPairs.size(); }
+
+private:
+    struct PairState {
+        uintptr_t keyA;                  // lower body pointer
+        uintptr_t keyB;                  // higher body pointer
+        GameObject* objectA;
+        GameObject* objectB;
+        glm::vec3 point;
+        glm::vec3 normal;                // from B towards A
+        float impulse;
+        float distance;                  // deepest point, used to merge manifolds of one pair
+
+        bool operator<(const PairState& other) const {
+            return keyA != other.keyA ? keyA < other.keyA : keyB < other.keyB;
+        }
+        bool samePair(const PairState& other) const {
+            return keyA == other.keyA && keyB == other.keyB;
+        }
+    };
+
+    void queue(ContactEventType type, const PairState& pair);
+    // Applies the forget() calls since the last flush
+    void flushForgotten();
+
+    std::vector<PairState> previousPairs;    // sorted
+    std::vector<PairState> currentPairs;     // scratch, sorted in collect()
+    std::vector<ContactEvent> events;
+    std::vector<uintptr_t> forgottenBodies;  // body keys removed since the last flush
+    std::vector<GameObject*> forgottenObjects;
+};
+
+#endif // CONTACT_EVENTS_H
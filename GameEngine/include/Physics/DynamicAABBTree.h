@@ -0,0 +1,132 @@
+#ifndef DYNAMIC_AABB_TREE_H
+#define DYNAMIC_AABB_TREE_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "../include/Core/FlatHashMap.h"
+#include "../include/Physics/SpatialIndex.h"
+
+class GameObject;
+
+/**
+ * @brief Dynamic AABB tree spatial index (bounding volume hierarchy).
+ *
+ * Every object is a leaf holding its box grown by a margin (the fat box).
+ * Inner nodes hold the union of their two children and the tree is kept
+ * balanced with AVL-style rotations, so depth stays O(log n) no matter how
+ * large or clustered the objects are. There is no cell size or world bound.
+ *
+ * Updates are incremental: while the object's box stays inside its fat box
+ * only the stored position changes. Once it leaves, the leaf is taken out,
+ * re-fattened and inserted again where it adds the least surface area, and
+ * the boxes on both paths to the root are refit.
+ *
+ * Nodes live in one array with a free list, objects in dense arrays like
+ * SpatialGrid (swap-and-pop on removal).
+ */
+class DynamicAABBTree : public ISpatialIndex {
+public:
+    /**
+     * @param fatMargin How far a leaf's box reaches past the object's box on each
+     *                  side, larger values re-insert less often but cull worse
+     */
+    explicit DynamicAABBTree(float fatMargin = 0.25f);
+
+    SpatialIndexType getType() const override { return SpatialIndexType::AABBTree; }
+
+    void insertObject(GameObject* obj) override;
+    void removeObject(GameObject* obj) override;
+    void updateObject(GameObject* obj) override;
+    void clear() override;
+
+    std::vector<GameObject*> queryRadius(
+        const glm::vec3& center,
+        float radius,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    GameObject* queryNearest(
+        const glm::vec3& position,
+        float maxRadius,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    void queryKNearest(
+        const glm::vec3& position,
+        int k,
+        float maxRadius,
+        std::vector<GameObject*>& out,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    void queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const override;
+
+    int getObjectCount() const override { return static_cast<int>(objects.size()); }
+    int getHeight() const { return root == NoNode ? 0 : nodes[root].height; }
+    int getNodeCount() const { return nodeCount; }
+    void printStats() const override;
+
+private:
+    static constexpr int32_t NoNode = -1;
+
+    struct Node {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+        int32_t parent = NoNode;         // next free node while on the free list
+        int32_t child1 = NoNode;
+        int32_t child2 = NoNode;         // leaves have no children
+        int32_t height = 0;              // 0 for leaves, -1 while free
+        uint32_t object = 0;             // dense object index, leaves only
+
+        bool isLeaf() const { return child1 == NoNode; }
+    };
+
+    float fatMargin;
+
+    std::vector<Node> nodes;
+    int32_t root = NoNode;
+    int32_t freeList = NoNode;
+    int nodeCount = 0;
+
+    // Object arrays, all indexed by the same dense object index
+    std::vector<GameObject*> objects;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> halfExtents;
+    std::vector<int32_t> objectLeaf;
+    FlatHashMap<const GameObject*, SpatialObjectHash> objectIndex;
+
+    // Query scratch
+    mutable std::vector<int32_t> nodeStack;
+    mutable NearestCandidates nearestCandidates;
+
+    static float surfaceArea(const glm::vec3& min, const glm::vec3& max) {
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    static void setUnion(Node& out, const Node& a, const Node& b) {
+        out.min = glm::min(a.min, b.min);
+        out.max = glm::max(a.max, b.max);
+    }
+
+    int32_t allocateNode();
+    void freeNode(int32_t node);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    // Rotates the taller grandchild up if the children's heights differ by more than one
+    int32_t balance(int32_t node);
+    // Recomputes the boxes and heights from node up to the root, balancing on the way
+    void refitUpwards(int32_t node);
+    void setFatBox(int32_t leaf, uint32_t index);
+
+    // Squared distance from a point to a node's box, 0 inside
+    float distSquaredToNode(const Node& node, const glm::vec3& point) const;
+
+    // visit(index, distSquared) for positions within the bound, nearest boxes first.
+    // bound() is re-read as visits shrink it.
+    template <typename Visit, typename Bound>
+    void forEachNearestFirst(const glm::vec3& position, Visit&& visit, Bound&& bound) const;
+};
+
+#endif // DYNAMIC_AABB_TREE_H
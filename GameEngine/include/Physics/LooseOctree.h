@@ -0,0 +1,131 @@
+#ifndef LOOSE_OCTREE_H
+#define LOOSE_OCTREE_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "../include/Core/FlatHashMap.h"
+#include "../include/Physics/SpatialIndex.h"
+
+class GameObject;
+
+/**
+ * @brief Loose octree spatial index.
+ *
+ * Each node has a tight cube and a loose cube twice its size. An object is
+ * stored in the deepest node whose tight cube contains its position and whose
+ * half size is at least the object's largest half extent. Its box then always
+ * fits the node's loose cube. Big objects (a 100x100 ground plane) stay near
+ * the root as one entry, small ones sink to small nodes, so no object is
+ * stored more than once whatever the mix of sizes.
+ *
+ * - Position queries (radius, nearest) cull nodes by their tight cube, which
+ *   holds every position stored below it. AABB queries cull by the loose cube.
+ * - The root starts around the first object and doubles towards any object
+ *   outside it, so there are no fixed world bounds.
+ * - Children are created eight at a time when an object sinks into them and
+ *   returned to a free list once the block and everything below it is empty.
+ *
+ * Objects live in dense arrays like SpatialGrid (swap-and-pop on removal).
+ */
+class LooseOctree : public ISpatialIndex {
+public:
+    /**
+     * @param minNodeSize Edge of the smallest node, objects smaller than this share it
+     * @param initialRootSize Edge of the root before it grows to fit the objects
+     */
+    explicit LooseOctree(float minNodeSize = 1.0f, float initialRootSize = 64.0f);
+
+    SpatialIndexType getType() const override { return SpatialIndexType::LooseOctree; }
+
+    void insertObject(GameObject* obj) override;
+    void removeObject(GameObject* obj) override;
+    void updateObject(GameObject* obj) override;
+    void clear() override;
+
+    std::vector<GameObject*> queryRadius(
+        const glm::vec3& center,
+        float radius,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    GameObject* queryNearest(
+        const glm::vec3& position,
+        float maxRadius,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    void queryKNearest(
+        const glm::vec3& position,
+        int k,
+        float maxRadius,
+        std::vector<GameObject*>& out,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    void queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const override;
+
+    int getObjectCount() const override { return static_cast<int>(objects.size()); }
+    int getNodeCount() const { return static_cast<int>(nodes.size() - freeBlocks.size() * 8); }
+    void printStats() const override;
+
+private:
+    static constexpr int32_t NoNode = -1;
+
+    struct Node {
+        glm::vec3 center{ 0.0f };
+        float halfSize = 0.0f;           // tight cube, the loose cube is twice as big
+        int32_t parent = NoNode;
+        int32_t firstChild = NoNode;     // eight consecutive nodes, octant bit 0 = +x, 1 = +y, 2 = +z
+        std::vector<uint32_t> objects;   // dense object indices
+    };
+
+    float minNodeSize;
+    float initialRootSize;
+
+    std::vector<Node> nodes;
+    std::vector<int32_t> freeBlocks;     // first node of each unused child block
+    int32_t root = NoNode;
+
+    // Object arrays, all indexed by the same dense object index
+    std::vector<GameObject*> objects;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> halfExtents;
+    std::vector<int32_t> objectNode;
+    std::vector<uint32_t> objectSlot;    // position in the node's object array
+    FlatHashMap<const GameObject*, SpatialObjectHash> objectIndex;
+
+    // Query scratch
+    mutable std::vector<int32_t> nodeStack;
+    mutable NearestCandidates nearestCandidates;
+
+    static float largestExtent(const glm::vec3& halfExtent) {
+        return glm::max(halfExtent.x, glm::max(halfExtent.y, halfExtent.z));
+    }
+    static int octantOf(const Node& node, const glm::vec3& position) {
+        return (position.x >= node.center.x ? 1 : 0)
+            | (position.y >= node.center.y ? 2 : 0)
+            | (position.z >= node.center.z ? 4 : 0);
+    }
+
+    // Grows the root until it holds position and an object of this extent
+    void growRootToFit(const glm::vec3& position, float extent);
+    // Deepest node for an object, creating child blocks on the way down
+    int32_t findNode(const glm::vec3& position, float extent);
+    // True if the object already sits where findNode() would put it
+    bool staysInNode(int32_t node, const glm::vec3& position, float extent) const;
+    int32_t createChildren(int32_t parent);
+    void attach(uint32_t index, int32_t node);
+    void detach(uint32_t index);
+    void pruneEmpty(int32_t node);
+
+    // Squared distance from a point to a node's tight cube, 0 inside
+    float distSquaredToNode(const Node& node, const glm::vec3& point) const;
+
+    // visit(index, distSquared) for positions within the bound, nearest nodes first.
+    // bound() is re-read as visits shrink it.
+    template <typename Visit, typename Bound>
+    void forEachNearestFirst(const glm::vec3& position, Visit&& visit, Bound&& bound) const;
+};
+
+#endif // LOOSE_OCTREE_H
@@ -6,11 +6,16 @@
 #include <vector>
 #include <memory>  
 #include <string>
+#include <atomic>
 #include "../include/Physics/PhysicsQuery.h"
+#include "../include/Physics/CollisionShapeCache.h"
+#include "../include/Physics/RigidBodyStore.h"
+#include "../include/Physics/ContactEvents.h"
 
 enum class ShapeType;
 
 class PhysicsMaterial;
+class btITaskScheduler;
 
 
 class Physics {
@@ -19,13 +24,37 @@ private:
     btDefaultCollisionConfiguration* collisionConfiguration;
     btCollisionDispatcher* dispatcher;
     btBroadphaseInterface* broadphase;
-    btSequentialImpulseConstraintSolver* solver;
+    btConstraintSolver* solver;          // btConstraintSolverPoolMt in the multithreaded world
+    btConstraintSolver* solverMt;        // batched island solver, multithreaded world only
     btDiscreteDynamicsWorld* dynamicsWorld;
 
+    // Multithreaded world (ENGINE_BULLET_MT builds), chosen before initialize()
+    bool multithreaded = false;
+    btITaskScheduler* taskScheduler = nullptr;
+    // Applied by stepWorld() so a UI change never lands mid-step, 0 = no change
+    std::atomic<int> requestedSolverThreads{ 0 };
+
+    // CollisionLayers version the world's broadphase filters were built with
+    uint64_t appliedLayerVersion = 0;
+    // Objects whose filter changed in the current refresh, kept to reuse its capacity
+    std::vector<btCollisionObject*> filterChanged;
+
+    // Writes group/mask into the object's broadphase proxy, false if unchanged
+    bool setProxyFilter(btCollisionObject* object, int group, int mask);
+    // Drops broadphase pairs the current filters reject and pairs the changed objects
+    // with everything their new filter accepts. Existing allowed pairs keep their manifolds.
+    void repairFilteredPairs(btCollisionObject* const* changed, int count);
+
+    // Adds a body with its layer's group/mask, the layer is kept in the body's user index 2
+    void addToWorld(btRigidBody* body, int layer);
+
     std::unique_ptr<PhysicsQuery> querySystem;
-    // store created rigid bodies and shapes in collections for cleanup
-    std::vector<btRigidBody*> rigidBodies;
-    std::vector<btCollisionShape*> collisionShapes;
+    // identical bodies share one collision shape
+    CollisionShapeCache shapeCache;
+    // every created rigid body, slot map with pooled storage (O(1) removal)
+    RigidBodyStore bodies;
+    // touching pairs diffed after every step (collision enter/stay/exit)
+    ContactEvents contactEvents;
 
     void applyMaterial(btRigidBody* body, const PhysicsMaterial& material);
 
@@ -36,6 +65,18 @@ public:
     // Initialize the physics world and ground plane
     void initialize();
 
+    // Build the world as btDiscreteDynamicsWorldMt (island solving on the ThreadPool).
+    // Must be called before initialize(); needs the ENGINE_BULLET_MT build option.
+    void setMultithreaded(bool enabled);
+    bool isMultithreaded() const { return multithreaded && taskScheduler != nullptr; }
+    static bool isMultithreadingAvailable();
+
+    // Threads used by the multithreaded world, applied before the next step.
+    // Clamped to [1, getMaxSolverThreadCount()]. No effect on the single-threaded world.
+    void setSolverThreadCount(int count);
+    int getSolverThreadCount() const;
+    int getMaxSolverThreadCount() const;
+
     // Clean up physics resources
     void cleanup();
     
@@ -63,8 +104,43 @@ public:
         const std::string& materialName
     );
 
+    // Collision layer of a body or trigger ghost (see CollisionLayers), -1 if none.
+    // setCollisionLayer updates the broadphase filter in place (no remove/re-add, so
+    // contacts the new filter still allows are kept). Main thread, no step running.
+    void setCollisionLayer(btCollisionObject* object, int layer);
+    int getCollisionLayer(const btCollisionObject* object) const;
+    // Records the layer only, the broadphase keeps the old filter until the next
+    // refreshCollisionFilters(). For batches such as scene loading.
+    void assignCollisionLayer(btCollisionObject* object, int layer) { if (object) object->setUserIndex2(layer); }
+
+    // Re-applies the layer matrix to every object in the world.
+    void refreshCollisionFilters();
+    // refreshCollisionFilters() if the layer matrix changed since the last one. Called on
+    // the main thread before stepping (update() and the engine's tick loop), never from
+    // stepWorld(), which may run on the physics worker.
+    void applyCollisionLayerChanges();
+
+    // Broadphase pairs currently in the overlapping pair cache
+    int getBroadphasePairCount() const;
+
     //delete old rigid bodies
     void removeRigidBody(btRigidBody* body);
+    void removeRigidBody(RigidBodyHandle handle);
+
+    // Generational handles: hold these instead of raw pointers when the body
+    // may be removed meanwhile, getRigidBody() returns nullptr once it is
+    btRigidBody* getRigidBody(RigidBodyHandle handle) const;
+    RigidBodyHandle getRigidBodyHandle(const btRigidBody* body) const;
+
+    // Bodies Bullet moved since the last clearMovedBodies() (active dynamic bodies only).
+    // Read and clear on the main thread while no step is running.
+    const std::vector<btRigidBody*>& getMovedBodies() const { return bodies.getMovedBodies(); }
+    void clearMovedBodies() { bodies.clearMovedBodies(); }
+
+    // Collision enter/stay/exit events queued by the steps since the last call,
+    // swapped into out. Main thread, while no step is running.
+    void takeContactEvents(std::vector<ContactEvent>& out) { contactEvents.takeEvents(out); }
+    size_t getTouchingPairCount() const { return contactEvents.getTouchingPairCount(); }
 
     //querys
     PhysicsQuery& getQuerySystem() { return *querySystem; }
@@ -75,11 +151,24 @@ public:
 
     // Step the physics simulation by fixed deltaTime (always 1/60s)
     // This should be called from Engine's fixed timestep loop
+    // Same as stepWorld(1, dt) followed by postStep(dt)
     void update(float fixedDeltaTime);
 
+    // Advance the Bullet world by tickCount fixed ticks, one stepSimulation each.
+    // Only touches the dynamics world, so it may run on the physics worker
+    // (PhysicsStepThread) while the main thread renders. Forces are cleared after
+    // every tick and postStep() is not run in between, so the engine passes 1.
+    void stepWorld(int tickCount, float fixedDeltaTime);
+
+    // Main-thread work after stepping: breakable constraints and trigger events
+    void postStep(float fixedDeltaTime);
+
     // Get number of active rigid bodies
     int getRigidBodyCount() const;
 
+    // Distinct collision shapes currently shared by the rigid bodies
+    size_t getCollisionShapeCount() const { return shapeCache.getShapeCount(); }
+
 };
 
 
@@ -4,6 +4,8 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 /**
  * @brief Defines physical material properties for rigid bodies.
@@ -55,6 +57,7 @@ class MaterialRegistry {
 private:
     MaterialRegistry();  // Private constructor for singleton
     std::unordered_map<std::string, PhysicsMaterial> materials;
+    uint64_t version = 0; // bumped on every registerMaterial()
 
     // Prevent copying
     MaterialRegistry(const MaterialRegistry&) = delete;
@@ -144,6 +147,14 @@ public:
      */
     std::vector<std::string> getAllMaterialNames() const;
 
+    /**
+     * @brief Changes whenever a material is registered or replaced.
+     *
+     * Lets callers that cache getAllMaterialNames() (debug UI) refresh only
+     * when the registry actually changed.
+     */
+    uint64_t getVersion() const { return version; }
+
     /**
     * @brief Initializes the registry with preset materials.
     *
@@ -0,0 +1,42 @@
+#ifndef PHYSICS_MOTION_STATE_H
+#define PHYSICS_MOTION_STATE_H
+
+#include <btBulletDynamicsCommon.h>
+#include <vector>
+
+/**
+ * @brief Motion state that records which bodies Bullet moved.
+ *
+ * Bullet only calls setWorldTransform() for active dynamic bodies (from
+ * synchronizeMotionStates at the end of a step, single-threaded even in the
+ * multithreaded world). Each call stores the transform and, the first time
+ * since the list was last cleared, appends the body to the owner's moved list,
+ * so transform sync only visits bodies that actually moved. Static and
+ * sleeping bodies never show up in it.
+ */
+ATTRIBUTE_ALIGNED16(class) PhysicsMotionState : public btMotionState {
+public:
+    BT_DECLARE_ALIGNED_ALLOCATOR();
+
+    PhysicsMotionState(const btTransform& startTransform, std::vector<btRigidBody*>* movedList)
+        : worldTransform(startTransform), movedList(movedList) {
+    }
+
+    void getWorldTransform(btTransform& outTransform) const override { outTransform = worldTransform; }
+    void setWorldTransform(const btTransform& transform) override;
+
+    // The body this motion state belongs to (set once the body is constructed)
+    void setBody(btRigidBody* owner) { body = owner; }
+
+    // True while the body is in the moved list
+    bool isQueued() const { return queued; }
+    void clearQueued() { queued = false; }
+
+private:
+    btTransform worldTransform;
+    std::vector<btRigidBody*>* movedList;
+    btRigidBody* body = nullptr;
+    bool queued = false;
+};
+
+#endif // PHYSICS_MOTION_STATE_H
@@ -3,9 +3,11 @@
 
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <vector>
 
 class GameObject;
+struct OverlapResults;
 
 struct RaycastHit {
     GameObject* object;
@@ -23,6 +25,21 @@ struct RaycastHit {
     }
 };
 
+// One ray of a raycastBatch(), collisionMask selects the layers it can hit
+struct Ray {
+    glm::vec3 from;
+    glm::vec3 to;
+    short collisionMask;
+
+    Ray()
+        : from(0), to(0), collisionMask(btBroadphaseProxy::AllFilter) {
+    }
+
+    Ray(const glm::vec3& from, const glm::vec3& to, short collisionMask = btBroadphaseProxy::AllFilter)
+        : from(from), to(to), collisionMask(collisionMask) {
+    }
+};
+
 class PhysicsQuery {
 private:
     btDiscreteDynamicsWorld* dynamicsWorld;
@@ -34,6 +51,13 @@ private:
         RaycastHit& hitInfo
     ) const;
 
+    bool sweepShape(const btConvexShape& shape, const glm::vec3& from, const glm::vec3& to,
+        const glm::quat& rotation, RaycastHit& hitInfo, short collisionMask) const;
+    void overlapShape(btCollisionShape& shape, const glm::vec3& center, const glm::quat& rotation,
+        OverlapResults& results, short collisionMask) const;
+    void collectAABB(const glm::vec3& min, const glm::vec3& max,
+        OverlapResults& results, short collisionMask) const;
+
 public:
     explicit PhysicsQuery(btDiscreteDynamicsWorld* world);
 
@@ -44,6 +68,51 @@ public:
     // Get all hits along ray
     std::vector<RaycastHit> raycastAll(const glm::vec3& from, const glm::vec3& to) const;
 
+    // Closest hit for each ray, written to hits[i] in place (count entries each).
+    // Rays are split across the engine ThreadPool when Bullet is built thread-safe
+    // (ENGINE_BULLET_MT), otherwise they run on the calling thread. The world is only
+    // read, so call it between steps (scripts, main thread), never while physics steps.
+    // Returns the number of rays that hit something.
+    size_t raycastBatch(const Ray* rays, RaycastHit* hits, size_t count) const;
+    // Resizes hits to rays.size(), reuse the vector to avoid allocating
+    size_t raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits) const;
+
+    // Shape sweeps: closest hit of the shape moved from -> to without rotating.
+    // hitInfo.distance is how far the shape travelled before touching,
+    // point/normal are the contact on the hit object. Triggers never block a sweep.
+    bool sweepSphere(const glm::vec3& from, const glm::vec3& to, float radius,
+        RaycastHit& hitInfo, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    bool sweepBox(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents,
+        const glm::quat& rotation, RaycastHit& hitInfo, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    // Y-up capsule, height is the total height like a capsule rigid body
+    bool sweepCapsule(const glm::vec3& from, const glm::vec3& to, float radius, float height,
+        RaycastHit& hitInfo, short collisionMask = btBroadphaseProxy::AllFilter) const;
+
+    // Overlap queries: objects touching the shape, written to results (at most
+    // maxResults, each object once). Returns the number written. Objects with no
+    // GameObject (trigger ghosts) are skipped.
+    size_t overlapSphere(const glm::vec3& center, float radius,
+        GameObject** results, size_t maxResults, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    size_t overlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& rotation,
+        GameObject** results, size_t maxResults, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    size_t overlapCapsule(const glm::vec3& center, float radius, float height,
+        GameObject** results, size_t maxResults, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    // Broadphase only: objects whose bounding box intersects [min, max].
+    // Much cheaper than the exact queries, but may report objects that don't touch.
+    size_t overlapAABB(const glm::vec3& min, const glm::vec3& max,
+        GameObject** results, size_t maxResults, short collisionMask = btBroadphaseProxy::AllFilter) const;
+
+    // Same queries into a caller-owned vector (cleared first, no cap). Reuse the
+    // vector across calls so it stops allocating once it has grown.
+    size_t overlapSphere(const glm::vec3& center, float radius,
+        std::vector<GameObject*>& results, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    size_t overlapBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& rotation,
+        std::vector<GameObject*>& results, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    size_t overlapCapsule(const glm::vec3& center, float radius, float height,
+        std::vector<GameObject*>& results, short collisionMask = btBroadphaseProxy::AllFilter) const;
+    size_t overlapAABB(const glm::vec3& min, const glm::vec3& max,
+        std::vector<GameObject*>& results, short collisionMask = btBroadphaseProxy::AllFilter) const;
+
     // Convenience methods
     bool isGrounded(const glm::vec3& position, float maxDistance = 0.2f) const;
     bool hasLineOfSight(const glm::vec3& from, const glm::vec3& to) const;
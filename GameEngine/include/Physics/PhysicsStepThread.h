@@ -0,0 +1,54 @@
+#ifndef PHYSICS_STEP_THREAD_H
+#define PHYSICS_STEP_THREAD_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class Physics;
+
+/**
+ * @brief Persistent worker that runs Physics::stepWorld off the main thread.
+ *
+ * Used by the pipelined frame in Start(): the main thread publishes the render
+ * snapshot, kicks the frame's last tick here, and renders while Bullet steps.
+ * wait() must be called before the main thread touches the physics world or
+ * the scene again (start of the next frame).
+ *
+ * Only stepWorld runs on the worker. Constraints, triggers, forces and scripts
+ * stay on the main thread and run once per tick, which is why the engine kicks
+ * one tick at a time.
+ */
+class PhysicsStepThread {
+private:
+    Physics& physics;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeWorker;
+    std::condition_variable stepDone;
+
+    int pendingTicks = 0;
+    float pendingDt = 0.0f;
+    bool busy = false;
+    bool stopRequested = false;
+
+    void run();
+
+public:
+    explicit PhysicsStepThread(Physics& physics);
+    ~PhysicsStepThread();
+
+    PhysicsStepThread(const PhysicsStepThread&) = delete;
+    PhysicsStepThread& operator=(const PhysicsStepThread&) = delete;
+
+    // Start stepping tickCount fixed ticks. Does nothing if tickCount <= 0.
+    void kick(int tickCount, float fixedDeltaTime);
+
+    // Block until the current step (if any) has finished.
+    // Returns the number of ticks that were stepped, 0 if nothing was in flight.
+    int wait();
+
+    bool isBusy();
+};
+
+#endif // PHYSICS_STEP_THREAD_H
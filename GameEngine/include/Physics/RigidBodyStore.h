@@ -0,0 +1,98 @@
+#ifndef RIGID_BODY_STORE_H
+#define RIGID_BODY_STORE_H
+
+#include <btBulletDynamicsCommon.h>
+#include <cstdint>
+#include <vector>
+#include "../include/Core/ObjectPool.h"
+#include "../include/Physics/PhysicsMotionState.h"
+
+/**
+ * @brief Generational reference to a rigid body owned by Physics.
+ *
+ * Stays safe to hold after the body is removed: Physics::getRigidBody()
+ * returns nullptr for a handle whose slot has since been reused.
+ */
+struct RigidBodyHandle {
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == InvalidIndex; }
+    bool operator==(const RigidBodyHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const RigidBodyHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Slot map of rigid bodies with pooled body/motion state storage.
+ *
+ * - Slots hold a generation that is bumped on every removal, so stale
+ *   handles are detected instead of dangling.
+ * - Live bodies are also kept in a dense array (swap-and-pop on removal),
+ *   used for iteration; each slot knows its dense position.
+ * - btRigidBody and PhysicsMotionState come from ObjectPools, so spawning
+ *   and despawning many bodies doesn't hit the heap per object.
+ * - Bodies Bullet moved since the last clearMovedBodies() are collected in a
+ *   moved list by their motion states (see PhysicsMotionState).
+ *
+ * A body's Bullet user index holds its slot index (the user pointer stays
+ * free for the owning GameObject).
+ */
+class RigidBodyStore {
+public:
+    RigidBodyStore() = default;
+    ~RigidBodyStore();
+
+    RigidBodyStore(const RigidBodyStore&) = delete;
+    RigidBodyStore& operator=(const RigidBodyStore&) = delete;
+
+    // Constructs a body and its motion state (not added to any world)
+    RigidBodyHandle create(btScalar mass, const btTransform& transform,
+        btCollisionShape* shape, const btVector3& localInertia);
+
+    // Destroys the body and its motion state. Returns false for stale/null handles.
+    // The caller must have removed the body from the dynamics world.
+    bool destroy(RigidBodyHandle handle);
+
+    // nullptr if the handle is stale or null
+    btRigidBody* get(RigidBodyHandle handle) const;
+
+    // Handle of a body created here, null handle otherwise
+    RigidBodyHandle handleOf(const btRigidBody* body) const;
+
+    // Destroys every body (world removal is the caller's job)
+    void clear();
+
+    // Live bodies, densely packed. Order changes on removal.
+    const std::vector<btRigidBody*>& getBodies() const { return dense; }
+    size_t size() const { return dense.size(); }
+
+    // Bodies whose motion state was written since the last clearMovedBodies(), each once
+    const std::vector<btRigidBody*>& getMovedBodies() const { return movedBodies; }
+    void clearMovedBodies();
+
+private:
+    struct Slot {
+        btRigidBody* body = nullptr;
+        PhysicsMotionState* motionState = nullptr;
+        uint32_t generation = 1;
+        uint32_t denseIndex = 0;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    std::vector<btRigidBody*> dense;
+    std::vector<uint32_t> denseToSlot;
+
+    std::vector<btRigidBody*> movedBodies;
+
+    ObjectPool<btRigidBody> bodyPool;
+    ObjectPool<PhysicsMotionState> motionStatePool;
+
+    // Takes a body out of the moved list before it is destroyed
+    void unqueueMoved(Slot& slot);
+};
+
+#endif // RIGID_BODY_STORE_H
@@ -2,25 +2,26 @@
 #define SPATIALGRID_H
 
 #include <glm/glm.hpp>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
 #include <vector>
 #include <functional>
+#include "../include/Core/FlatHashMap.h"
+#include "../include/Physics/SpatialIndex.h"
 
 class GameObject;
 
 /**
- * @brief Hash function for grid cell coordinates.
- * Enables use of glm::ivec3 as unordered_map keys.
+ * @brief Hash function for grid cell coordinates (FlatHashMap keys).
  */
 struct GridCellHash {
     std::size_t operator()(const glm::ivec3& cell) const {
-        // FNV-1a hash for good spatial distribution
-        std::size_t h = 2166136261u;
-        h = (h ^ static_cast<std::size_t>(cell.x)) * 16777619u;
-        h = (h ^ static_cast<std::size_t>(cell.y)) * 16777619u;
-        h = (h ^ static_cast<std::size_t>(cell.z)) * 16777619u;
-        return h;
+        uint64_t h = static_cast<uint32_t>(cell.x);
+        h = h * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(cell.y);
+        h = h * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(cell.z);
+        return static_cast<std::size_t>(mixHash64(h));
     }
 };
 
@@ -32,12 +33,27 @@ struct GridCellHash {
  *
  * Performance: O(k) queries where k = objects in nearby cells (vs O(n) for all objects)
  *
+ * Layout (no per-object or per-cell nodes):
+ * - Objects live in dense arrays (swap-and-pop on removal): the GameObject,
+ *   its position and half size packed together, so a candidate costs one cache
+ *   line to test, and the inclusive range of cells it covers.
+ * - Cells are found through an open-addressed FlatHashMap from cell coordinate
+ *   to a 64-byte block holding the coordinate and the first object indices, so
+ *   visiting a cell is one cache line. Crowded cells chain more blocks. Blocks
+ *   come from one pool with a free list, so a warmed-up grid doesn't allocate.
+ * - An object spanning several cells is only reported once per query without a
+ *   dedup set: sphere queries report it from the cell holding its center, AABB
+ *   queries from the first cell shared with the query box, and segment queries
+ *   stamp it with the query's number the first time it is seen. The rules hold
+ *   for single-cell objects too, so cell entries are bare indices and an object
+ *   that moves only touches the cells it leaves or joins.
+ *
  * Use cases:
  * - Find objects in radius (explosions, AI detection)
  * - Find nearest object (pathfinding, targeting)
  * - Custom collision filtering
  */
-class SpatialGrid {
+class SpatialGrid : public ISpatialIndex {
 public:
     /**
      * @param cellSize Size of each grid cell in world units
@@ -46,12 +62,14 @@ public:
      */
     explicit SpatialGrid(float cellSize = 10.0f);
 
+    SpatialIndexType getType() const override { return SpatialIndexType::UniformGrid; }
+
     // === Core Operations (call these from Scene) ===
 
-    void insertObject(GameObject* obj);   // Call when spawning
-    void removeObject(GameObject* obj);   // Call when destroying
-    void updateObject(GameObject* obj);   // Call every frame for moving objects
-    void clear();                         // Call when resetting scene
+    void insertObject(GameObject* obj) override;   // Call when spawning
+    void removeObject(GameObject* obj) override;   // Call when destroying
+    void updateObject(GameObject* obj) override;   // Call when the object moved or was resized
+    void clear() override;                         // Call when resetting scene
 
     // === Queries (use these for gameplay) ===
 
@@ -63,36 +81,319 @@ public:
         const glm::vec3& center,
         float radius,
         std::function<bool(GameObject*)> filter = nullptr
-    ) const;
+    ) const override;
 
     /**
      * Find the single nearest object to a point.
+     * Searches outwards from the point's cell like queryKNearest.
      */
     GameObject* queryNearest(
         const glm::vec3& position,
         float maxRadius,
         std::function<bool(GameObject*)> filter = nullptr
-    ) const;
+    ) const override;
+
+    /**
+     * Find the k objects nearest to a point within maxRadius, closest first.
+     * Cells are searched in shells around the point's cell and the search stops
+     * once the k-th best distance is closer than anything the next shell can hold.
+     * out is cleared first, reuse it across calls to avoid allocating.
+     */
+    void queryKNearest(
+        const glm::vec3& position,
+        int k,
+        float maxRadius,
+        std::vector<GameObject*>& out,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const override;
+
+    // Collects visitAABB into out (cleared first)
+    void queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const override;
+
+    // === Visitor queries ===
+    // The callable is a template parameter, so it is inlined and nothing is
+    // allocated: collect into a reused vector, count, or keep the best hit.
+
+    /**
+     * visit(GameObject*) for every object whose position is within radius of center.
+     */
+    template <typename Visitor>
+    void visitSphere(const glm::vec3& center, float radius, Visitor&& visit) const;
+
+    /**
+     * visit(GameObject*) for every object whose box (position +- scale / 2)
+     * overlaps the box [min, max].
+     */
+    template <typename Visitor>
+    void visitAABB(const glm::vec3& min, const glm::vec3& max, Visitor&& visit) const;
+
+    /**
+     * visit(GameObject*, float t) for every object whose box the segment
+     * from -> to passes through. t in [0, 1] is where the segment enters the
+     * box (0 if it starts inside). Cells are walked front to back (3D-DDA), so
+     * the cost grows with the cells crossed, objects inside one cell are unsorted.
+     * Not reentrant: don't start another segment query from inside visit.
+     */
+    template <typename Visitor>
+    void visitSegment(const glm::vec3& from, const glm::vec3& to, Visitor&& visit) const;
 
     // === Debug Info ===
 
-    int getObjectCount() const { return objectToCells.size(); }
-    int getActiveCellCount() const { return cells.size(); }
-    void printStats() const;
+    int getObjectCount() const override { return static_cast<int>(objects.size()); }
+    int getActiveCellCount() const { return static_cast<int>(cellLookup.size()); }
+    float getCellSize() const { return cellSize; }
+    void printStats() const override;
 
 private:
+    struct ObjectBox {
+        glm::vec3 position;
+        glm::vec3 halfSize;              // half the scale, the box the object is binned with
+    };
+
+    static constexpr uint32_t BlockEntries = 11;
+    static constexpr uint32_t NoBlock = 0xFFFFFFFFu;
+
+    // One cache line of a cell. The block the cell lookup points at is the only
+    // one that may be partly filled, the blocks chained behind it are full.
+    struct alignas(64) CellBlock {
+        glm::ivec3 coord;
+        uint32_t count;                      // entries used in this block
+        uint32_t next;                       // next block of the same cell or NoBlock
+        uint32_t objects[BlockEntries];      // object indices
+    };
+    static_assert(sizeof(CellBlock) == 64, "a cell block should fill exactly one cache line");
+
     float cellSize;
+    float invCellSize;
+
+    // Object arrays, all indexed by the same dense object index
+    std::vector<GameObject*> objects;
+    std::vector<ObjectBox> boxes;
+    std::vector<glm::ivec3> cellMin;     // inclusive cell range the object covers
+    std::vector<glm::ivec3> cellMax;
+    FlatHashMap<const GameObject*, SpatialObjectHash> objectIndex;
+
+    // Cell blocks, the lookup maps a live cell to its first block
+    std::vector<CellBlock> blocks;
+    std::vector<uint32_t> freeBlocks;
+    FlatHashMap<glm::ivec3, GridCellHash> cellLookup;
 
-    // Grid storage: cell coordinate -> objects in that cell
-    std::unordered_map<glm::ivec3, std::unordered_set<GameObject*>, GridCellHash> cells;
+    // Segment query dedup: an object already visited carries the query's stamp
+    mutable std::vector<uint32_t> visitStamps;
+    mutable uint32_t currentStamp = 0;
 
-    // Reverse lookup: object -> cells it occupies (for fast updates/removal)
-    std::unordered_map<GameObject*, std::unordered_set<glm::ivec3, GridCellHash>> objectToCells;
+    // queryKNearest scratch
+    mutable NearestCandidates nearestCandidates;
 
     // Helper methods
-    glm::ivec3 worldToCell(const glm::vec3& worldPos) const;
-    std::vector<glm::ivec3> getObjectCells(const glm::vec3& position, const glm::vec3& size) const;
-    std::vector<glm::ivec3> getCellsInAABB(const glm::vec3& min, const glm::vec3& max) const;
+    glm::ivec3 worldToCell(const glm::vec3& worldPos) const {
+        return glm::ivec3(floorToCell(worldPos.x), floorToCell(worldPos.y), floorToCell(worldPos.z));
+    }
+    // floor() without the libm call, positions are far inside int range
+    int floorToCell(float v) const {
+        float f = v * invCellSize;
+        int i = static_cast<int>(f);
+        return i - (f < static_cast<float>(i) ? 1 : 0);
+    }
+    void getObjectCellRange(const GameObject* obj, glm::ivec3& outMin, glm::ivec3& outMax) const;
+
+    uint32_t allocateBlock(const glm::ivec3& coord);
+    void addToCell(const glm::ivec3& coord, uint32_t index);
+    void removeFromCell(const glm::ivec3& coord, uint32_t index);
+    void renumberInCell(const glm::ivec3& coord, uint32_t from, uint32_t to);
+
+    uint32_t nextStamp() const;
+
+    // visit(coord, firstBlock) for every live cell in [min, max] that accept(coord)
+    // keeps, accept runs before the hash lookup so it can cull cells cheaply
+    template <typename Accept, typename VisitCell>
+    void forEachCell(const glm::ivec3& min, const glm::ivec3& max, Accept&& accept, VisitCell&& visitCell) const;
+
+    // visit(index, distSquared) once for every object whose position is within radius
+    template <typename Visit>
+    void forEachInSphere(const glm::vec3& center, float radius, Visit&& visit) const;
+
+    // visit(index, distSquared) for objects within maxRadius, searching shells of
+    // cells outwards from the point's cell. bound() is the squared distance past
+    // which nothing is wanted any more, the search stops when the next shell is past it.
+    template <typename Visit, typename Bound>
+    void forEachNearestFirst(const glm::vec3& position, float maxRadius, Visit&& visit, Bound&& bound) const;
+
+    // f(index) for every object in the cell starting at block
+    template <typename Func>
+    void forEachInCell(const CellBlock& block, Func&& f) const;
+
+    // Slab test of the segment from + t * delta (t in [0, 1]) against an object's box
+    bool segmentHitsObject(uint32_t index, const glm::vec3& from, const glm::vec3& invDelta, float& outT) const;
 };
 
-#endif // SPATIALGRID_H
\ No newline at end of file
+// ===== Template implementations =====
+
+template <typename Accept, typename VisitCell>
+void SpatialGrid::forEachCell(const glm::ivec3& min, const glm::ivec3& max, Accept&& accept, VisitCell&& visitCell) const {
+    // A huge query box has more coordinates than the grid has live cells
+    double volume = (double(max.x) - min.x + 1) * (double(max.y) - min.y + 1) * (double(max.z) - min.z + 1);
+    if (volume > static_cast<double>(cellLookup.size())) {
+        cellLookup.forEach([&](const glm::ivec3& coord, uint32_t cellIndex) {
+            if (coord.x >= min.x && coord.x <= max.x
+                && coord.y >= min.y && coord.y <= max.y
+                && coord.z >= min.z && coord.z <= max.z
+                && accept(coord))
+                visitCell(coord, blocks[cellIndex]);
+        });
+        return;
+    }
+
+    for (int x = min.x; x <= max.x; ++x)
+        for (int y = min.y; y <= max.y; ++y)
+            for (int z = min.z; z <= max.z; ++z) {
+                glm::ivec3 coord(x, y, z);
+                if (!accept(coord)) continue;
+
+                uint32_t cellIndex = cellLookup.find(coord);
+                if (cellIndex != cellLookup.NotFound)
+                    visitCell(coord, blocks[cellIndex]);
+            }
+}
+
+template <typename Func>
+void SpatialGrid::forEachInCell(const CellBlock& block, Func&& f) const {
+    for (const CellBlock* b = &block;; b = &blocks[b->next]) {
+        for (uint32_t i = 0; i < b->count; ++i)
+            f(b->objects[i]);
+        if (b->next == NoBlock) return;
+    }
+}
+
+template <typename Visit>
+void SpatialGrid::forEachInSphere(const glm::vec3& center, float radius, Visit&& visit) const {
+    if (objects.empty()) return;
+
+    glm::vec3 radiusVec(radius, radius, radius);
+    float radiusSquared = radius * radius;
+
+    // Cells the sphere doesn't touch are skipped before the hash lookup
+    auto touchesSphere = [&](const glm::ivec3& coord) {
+        glm::vec3 cellLow = glm::vec3(coord) * cellSize;
+        glm::vec3 nearest = glm::clamp(center, cellLow, cellLow + glm::vec3(cellSize));
+        glm::vec3 diff = nearest - center;
+        return glm::dot(diff, diff) <= radiusSquared;
+    };
+
+    // Objects are reported from the cell holding their center, so multi-cell
+    // objects come up once and a culled cell never hides one
+    forEachCell(worldToCell(center - radiusVec), worldToCell(center + radiusVec), touchesSphere,
+        [&](const glm::ivec3& coord, const CellBlock& first) {
+            for (const CellBlock* block = &first;; block = &blocks[block->next]) {
+                // Distances for the whole block first: no branch between the
+                // position loads, so their cache misses overlap instead of queueing
+                float distSquared[BlockEntries];
+                for (uint32_t i = 0; i < block->count; ++i) {
+                    const glm::vec3& position = boxes[block->objects[i]].position;
+                    float dx = position.x - center.x;
+                    float dy = position.y - center.y;
+                    float dz = position.z - center.z;
+                    distSquared[i] = dx * dx + dy * dy + dz * dz;
+                }
+
+                for (uint32_t i = 0; i < block->count; ++i) {
+                    if (distSquared[i] > radiusSquared) continue;
+
+                    uint32_t index = block->objects[i];
+                    if (worldToCell(boxes[index].position) != coord)
+                        continue;
+                    visit(index, distSquared[i]);
+                }
+                if (block->next == NoBlock) break;
+            }
+        });
+}
+
+template <typename Visitor>
+void SpatialGrid::visitSphere(const glm::vec3& center, float radius, Visitor&& visit) const {
+    forEachInSphere(center, radius, [&](uint32_t index, float) { visit(objects[index]); });
+}
+
+template <typename Visitor>
+void SpatialGrid::visitAABB(const glm::vec3& min, const glm::vec3& max, Visitor&& visit) const {
+    if (objects.empty()) return;
+
+    glm::ivec3 queryMin = worldToCell(min);
+    glm::ivec3 queryMax = worldToCell(max);
+
+    // Reported from the first cell the object shares with the query box
+    forEachCell(queryMin, queryMax, [](const glm::ivec3&) { return true; },
+        [&](const glm::ivec3& coord, const CellBlock& first) {
+            forEachInCell(first, [&](uint32_t index) {
+                if (glm::max(cellMin[index], queryMin) != coord)
+                    return;
+
+                const ObjectBox& box = boxes[index];
+                if (box.position.x + box.halfSize.x < min.x || box.position.x - box.halfSize.x > max.x
+                    || box.position.y + box.halfSize.y < min.y || box.position.y - box.halfSize.y > max.y
+                    || box.position.z + box.halfSize.z < min.z || box.position.z - box.halfSize.z > max.z)
+                    return;
+                visit(objects[index]);
+            });
+        });
+}
+
+template <typename Visitor>
+void SpatialGrid::visitSegment(const glm::vec3& from, const glm::vec3& to, Visitor&& visit) const {
+    if (objects.empty()) return;
+
+    uint32_t stamp = nextStamp();
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    glm::vec3 delta = to - from;
+    glm::vec3 invDelta;
+    glm::ivec3 cell = worldToCell(from);
+    glm::ivec3 endCell = worldToCell(to);
+
+    // Amanatides-Woo: per axis the step direction, the t where the segment
+    // crosses the next cell boundary and the t it takes to cross a whole cell
+    glm::ivec3 step(0);
+    glm::vec3 tNext(infinity);
+    glm::vec3 tDelta(infinity);
+    for (int axis = 0; axis < 3; ++axis) {
+        invDelta[axis] = delta[axis] != 0.0f ? 1.0f / delta[axis] : infinity;
+        if (delta[axis] > 0.0f) {
+            step[axis] = 1;
+            tNext[axis] = ((cell[axis] + 1) * cellSize - from[axis]) * invDelta[axis];
+            tDelta[axis] = cellSize * invDelta[axis];
+        }
+        else if (delta[axis] < 0.0f) {
+            step[axis] = -1;
+            tNext[axis] = (cell[axis] * cellSize - from[axis]) * invDelta[axis];
+            tDelta[axis] = -cellSize * invDelta[axis];
+        }
+    }
+
+    // One step per boundary crossed. Only axes that haven't reached the end
+    // cell may step, so rounding can't walk past it.
+    int stepsLeft = std::abs(endCell.x - cell.x) + std::abs(endCell.y - cell.y) + std::abs(endCell.z - cell.z);
+    for (;;) {
+        uint32_t cellIndex = cellLookup.find(cell);
+        if (cellIndex != cellLookup.NotFound) {
+            forEachInCell(blocks[cellIndex], [&](uint32_t index) {
+                if (visitStamps[index] == stamp) return;
+                visitStamps[index] = stamp;
+
+                float t;
+                if (segmentHitsObject(index, from, invDelta, t))
+                    visit(objects[index], t);
+            });
+        }
+
+        if (stepsLeft-- <= 0) break;
+
+        int axis = -1;
+        for (int a = 0; a < 3; ++a)
+            if (cell[a] != endCell[a] && (axis < 0 || tNext[a] < tNext[axis]))
+                axis = a;
+        cell[axis] += step[axis];
+        tNext[axis] += tDelta[axis];
+    }
+}
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,130 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../include/Core/FlatHashMap.h"
+
+class GameObject;
+
+// FlatHashMap hash for the object -> dense index maps of the backends
+struct SpatialObjectHash {
+    std::size_t operator()(const GameObject* obj) const {
+        return static_cast<std::size_t>(mixHash64(reinterpret_cast<uintptr_t>(obj)));
+    }
+};
+
+enum class SpatialIndexType {
+    UniformGrid,    // SpatialGrid: hashed uniform cells, best when objects are of similar size
+    LooseOctree,    // LooseOctree: objects sit at the depth matching their size
+    AABBTree        // DynamicAABBTree: balanced tree of fattened boxes, no world bounds or cell size
+};
+
+// "grid", "octree", "aabbtree" (scene JSON and HeadlessSim --spatial-index)
+const char* spatialIndexTypeToString(SpatialIndexType type);
+bool spatialIndexTypeFromString(const std::string& name, SpatialIndexType& out);
+
+/**
+ * @brief Interface shared by the spatial index backends Scene can use.
+ *
+ * Every backend indexes an object by its position and its unrotated box
+ * (position +- scale / 2), the same box SpatialGrid bins with:
+ * - Radius, nearest and k-nearest queries test the object's position.
+ * - AABB queries test the object's box against the query box.
+ *
+ * Objects are re-read from their GameObject on insert and update only, so
+ * queries run on the index's own copies of position and size.
+ *
+ * Queries are const but may use per-index scratch buffers, so one index must
+ * not be queried from several threads at once.
+ */
+class ISpatialIndex {
+public:
+    virtual ~ISpatialIndex() = default;
+
+    virtual SpatialIndexType getType() const = 0;
+
+    virtual void insertObject(GameObject* obj) = 0;
+    virtual void removeObject(GameObject* obj) = 0;
+    virtual void updateObject(GameObject* obj) = 0;
+    virtual void clear() = 0;
+
+    virtual std::vector<GameObject*> queryRadius(
+        const glm::vec3& center,
+        float radius,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const = 0;
+
+    virtual GameObject* queryNearest(
+        const glm::vec3& position,
+        float maxRadius,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const = 0;
+
+    // Up to k objects within maxRadius, closest first, out is cleared first
+    virtual void queryKNearest(
+        const glm::vec3& position,
+        int k,
+        float maxRadius,
+        std::vector<GameObject*>& out,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const = 0;
+
+    // Objects whose box overlaps [min, max], out is cleared first
+    virtual void queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const = 0;
+
+    virtual int getObjectCount() const = 0;
+    virtual void printStats() const = 0;
+};
+
+/**
+ * cellSize is the SpatialGrid cell edge. The octree and the AABB tree size
+ * themselves from the objects and ignore it.
+ */
+std::unique_ptr<ISpatialIndex> createSpatialIndex(SpatialIndexType type, float cellSize = 10.0f);
+
+// The k closest candidates seen so far as (distSquared, object index): a max-heap
+// capped at k entries, so the k-th best distance is always on top
+class NearestCandidates {
+public:
+    void reset(size_t k) {
+        capacity = k;
+        entries.clear();
+        entries.reserve(k);
+    }
+
+    bool full() const { return entries.size() == capacity; }
+
+    // Squared distance a candidate has to be within to be kept
+    float bound(float maxDistSquared) const { return full() ? entries.front().first : maxDistSquared; }
+    bool wants(float distSquared) const { return !full() || distSquared < entries.front().first; }
+
+    void add(float distSquared, uint32_t index) {
+        if (full()) {
+            std::pop_heap(entries.begin(), entries.end());
+            entries.back() = { distSquared, index };
+        }
+        else {
+            entries.push_back({ distSquared, index });
+        }
+        std::push_heap(entries.begin(), entries.end());
+    }
+
+    // Closest first, call once at the end of the query
+    const std::vector<std::pair<float, uint32_t>>& sortClosestFirst() {
+        std::sort_heap(entries.begin(), entries.end());
+        return entries;
+    }
+
+private:
+    size_t capacity = 0;
+    std::vector<std::pair<float, uint32_t>> entries;
+};
+
+#endif // SPATIAL_INDEX_H
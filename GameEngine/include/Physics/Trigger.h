@@ -67,6 +67,9 @@ private:
     // used only for event triggers 
     std::string behaviourTag;
 
+    // CollisionLayers index the ghost is added with (Trigger layer by default)
+    int collisionLayer;
+
     uint64_t id;
     static uint64_t nextID;
 
@@ -117,9 +120,12 @@ public:
     const std::vector<GameObject*>& getObjectsInside() const { return objectsInside; }
 
     const std::string& getBehaviourTag()         const { return behaviourTag; }
+    int getCollisionLayer() const { return collisionLayer; }
  
     // === Setters ===
     void setBehaviourTag(const std::string& tag) { behaviourTag = tag; }
+    // Takes effect when the ghost is (re)added, use TriggerRegistry::setCollisionLayer for live triggers
+    void setCollisionLayer(int layer) { collisionLayer = layer; }
 
     void setName(const std::string& newName) { name = newName; }
     void setEnabled(bool enable) { enabled = enable; }
@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <btBulletDynamicsCommon.h>
 
 class Trigger;
@@ -27,6 +28,7 @@ private:
 
     btDiscreteDynamicsWorld* dynamicsWorld;
     std::vector<std::unique_ptr<Trigger>> triggers;
+    uint64_t version = 0; // bumped whenever the trigger list changes
 
     TriggerRegistry();
 
@@ -80,6 +82,11 @@ public:
      */
     void clearAll();
 
+    /**
+     * @brief Move a trigger to another collision layer (re-adds its ghost)
+     */
+    void setCollisionLayer(Trigger* trigger, int layer);
+
     // === Update ===
 
     /**
@@ -115,6 +122,12 @@ public:
      */
     size_t getTriggerCount() const { return triggers.size(); }
 
+    /**
+     * @brief Changes whenever a trigger is added or removed
+     * Lets cached views (debug UI) skip rebuilding when nothing changed
+     */
+    uint64_t getVersion() const { return version; }
+
     /**
      * @brief Find all triggers within radius of a point
      */
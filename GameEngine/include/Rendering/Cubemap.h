@@ -1,8 +1,24 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <memory>
 #include <GL/glew.h>
 
+/**
+ * @brief Decoded pixels for one cubemap face.
+ *
+ * Filled by Cubemap::decodeFace(), which only touches the CPU and can run on
+ * a worker thread; Cubemap::uploadFaces() then creates the GL texture.
+ */
+struct CubemapImage {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::unique_ptr<unsigned char, void (*)(void*)> pixels{ nullptr, nullptr }; // freed with stbi_image_free
+
+    bool isValid() const { return pixels != nullptr; }
+};
+
 /**
  * @brief Cubemap texture for skyboxes and environment mapping
  *
@@ -31,6 +47,17 @@ public:
      */
     bool loadFromFiles(const std::vector<std::string>& faces);
 
+    /**
+     * @brief Decode one face image (no GL calls, safe on any thread)
+     */
+    static bool decodeFace(const std::string& path, CubemapImage& out);
+
+    /**
+     * @brief Create the cubemap texture from 6 decoded faces (main thread)
+     * @param faces Order: right, left, top, bottom, front, back
+     */
+    bool uploadFaces(const std::vector<CubemapImage>& faces);
+
     void bind(unsigned int slot = 0) const;
     void unbind() const;
     void cleanup();
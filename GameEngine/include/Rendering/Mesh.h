@@ -30,6 +30,15 @@ public:
     void setData(const std::vector<float>& interleavedVertices,
         const std::vector<unsigned int>& indices);
 
+    // Store vertex data on the CPU only, without creating any GL buffers.
+    // Used when there is no GL context (headless runner).
+    void setVertexData(const std::vector<float>& interleavedVertices,
+        const std::vector<unsigned int>& indices);
+
+    // Create the GL buffers for data stored with setVertexData().
+    // Lets the vertex data be built on a worker thread and uploaded on the main thread.
+    void upload();
+
     // Rendering
     void draw() const;
 
@@ -5,12 +5,14 @@
 class MeshFactory {
 public:
     // Primitive shapes
-    static Mesh createCube();
-    static Mesh createSphere(float radius = 1.0f, int sectors = 36, int stacks = 18);
-    static Mesh createCylinder(float radius = 1.0f, float height = 2.0f, int sectors = 36);
+    // uploadToGPU = false only builds the vertex data (any thread), call Mesh::upload() later
+    static Mesh createCube(bool uploadToGPU = true);
+    static Mesh createSphere(float radius = 1.0f, int sectors = 36, int stacks = 18, bool uploadToGPU = true);
+    static Mesh createCylinder(float radius = 1.0f, float height = 2.0f, int sectors = 36, bool uploadToGPU = true);
 
     // Model loading
-    static Mesh loadFromFile(const std::string& filepath);
+    // uploadToGPU = false keeps the vertex data on the CPU only (no GL context needed)
+    static Mesh loadFromFile(const std::string& filepath, bool uploadToGPU = true);
 
 private:
     MeshFactory() = delete;  // Static class, no instances
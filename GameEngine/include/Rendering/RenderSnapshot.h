@@ -0,0 +1,90 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+
+class GameObject;
+enum class TriggerType;
+enum class ForceGeneratorType;
+
+// Per-object state the renderer needs for one frame.
+// Poses are copied so drawing never reads physics state; the GameObject
+// pointer is only used for mesh/texture data, which the physics step never touches.
+struct RenderSnapshotObject
+{
+    const GameObject* object = nullptr;
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+    glm::vec3 collisionScale = glm::vec3(1.0f); // size of the physics debug wireframe
+    bool selected = false;
+    bool primarySelection = false;
+};
+
+struct RenderSnapshotPointLight
+{
+    glm::vec3 position;
+    glm::vec3 colour;
+    float intensity;
+    float radius;
+};
+
+// Debug overlay volumes, copied so the overlays never read trigger or generator state
+struct RenderSnapshotTrigger
+{
+    glm::vec3 position;
+    glm::vec3 size;
+    TriggerType type;
+};
+
+struct RenderSnapshotForceGenerator
+{
+    glm::vec3 position;
+    float radius;
+    ForceGeneratorType type;
+};
+
+// Everything Renderer::draw and the debug overlays read, published once per frame by Scene::buildRenderSnapshot
+struct RenderSnapshot
+{
+    std::vector<RenderSnapshotObject> objects;
+    std::vector<RenderSnapshotPointLight> pointLights; // enabled lights only
+    std::vector<RenderSnapshotTrigger> triggers; // enabled triggers only
+    std::vector<RenderSnapshotForceGenerator> forceGenerators; // enabled generators only
+
+    // Keeps capacity so steady-state frames don't allocate
+    void clear()
+    {
+        objects.clear();
+        pointLights.clear();
+        triggers.clear();
+        forceGenerators.clear();
+    }
+};
+
+// Two snapshots, both written and read on the main thread: each frame fills the
+// back one, publishes it and draws it while the physics worker steps. This is
+// not a cross-thread hand-off. Drawing during the step is safe because the
+// snapshot holds copies, so nothing drawn reads state the worker writes.
+class RenderSnapshotBuffer
+{
+private:
+    RenderSnapshot snapshots[2];
+    int frontIndex = 0;
+
+public:
+    RenderSnapshot& beginWrite()
+    {
+        RenderSnapshot& back = snapshots[1 - frontIndex];
+        back.clear();
+        return back;
+    }
+
+    void publish() { frontIndex = 1 - frontIndex; }
+
+    const RenderSnapshot& getFront() const { return snapshots[frontIndex]; }
+};
+
+#endif // RENDER_SNAPSHOT_H
@@ -21,8 +21,17 @@
 #include "../Physics/ForceGenerator.h"
 #include "../Physics/Trigger.h"
 #include "../Rendering/PointLight.h"
+#include "../Rendering/RenderSnapshot.h"
 
 
+// CPU-side primitive meshes built off the main thread during startup,
+// handed to Renderer::uploadPrimitiveMeshes() once the GL context exists.
+struct PrimitiveMeshData {
+    Mesh cube;
+    Mesh sphere;
+    Mesh cylinder;
+};
+
 class Renderer {
 private:
     
@@ -38,12 +47,12 @@ private:
     bool skyboxEnabled;
 
    
-    void drawGameObject(const GameObject& obj, int modelLoc, int colorLoc);// draw a single game object
-    void drawOutlineOnly(const GameObject& obj, int modelLoc, int colorLoc);
-    void drawDebugCollisionShape(const GameObject& obj, int modelLoc, int colorLoc);
+    void drawGameObject(const RenderSnapshotObject& item, int modelLoc, int colorLoc);// draw a single game object
+    void drawOutlineOnly(const RenderSnapshotObject& item, int modelLoc, int colorLoc);
+    void drawDebugCollisionShape(const RenderSnapshotObject& item, int modelLoc, int colorLoc);
     void renderShadowPass( 
         const Camera& camera,
-        const std::vector<std::unique_ptr<GameObject>>& objects);
+        const RenderSnapshot& snapshot);
 
 
 public:
@@ -51,19 +60,27 @@ public:
     ~Renderer();
 
     void initialize();
+
+    // Split form of initialize() used by parallel startup:
+    // buildPrimitiveMeshes() does no GL work and can run on a worker,
+    // initializePipeline() and uploadPrimitiveMeshes() need the GL context.
+    static void buildPrimitiveMeshes(PrimitiveMeshData& out);
+    void initializePipeline();
+    void uploadPrimitiveMeshes(PrimitiveMeshData& data);
+    // Draws a published snapshot (see Scene::buildRenderSnapshot).
+    // Reads no physics state, so it can run while the physics worker steps.
     void draw(
         int windowWidth,
         int windowHeight,
         const Camera& camera,
-        const std::vector<std::unique_ptr<GameObject>>& objects,
-        const GameObject* primarySelection,
-        const std::vector<GameObject*>& selectedObjects
+        const RenderSnapshot& snapshot
     );
 
-    void drawTriggerDebug(const std::vector<Trigger*>& triggers, const Camera& camera, int fbW, int fbH);
-    void drawForceGeneratorDebug(const std::vector<ForceGenerator*>& generators, const Camera& camera, int fbW, int fbH);
-    void drawPointLightDebug(const std::vector<PointLight*>& lights, const Camera& camera, int fbW, int fbH);
-    void uploadPointLights(const std::vector<PointLight*>& lights);
+    // Debug overlays, drawn from the same snapshot so they are safe during a pipelined step too
+    void drawTriggerDebug(const RenderSnapshot& snapshot, const Camera& camera, int fbW, int fbH);
+    void drawForceGeneratorDebug(const RenderSnapshot& snapshot, const Camera& camera, int fbW, int fbH);
+    void drawPointLightDebug(const RenderSnapshot& snapshot, const Camera& camera, int fbW, int fbH);
+    void uploadPointLights(const RenderSnapshot& snapshot);
     
     void cleanup();
 
@@ -72,6 +89,7 @@ public:
 
     // Skybox control
     bool loadSkybox(const std::vector<std::string>& faces);
+    bool loadSkybox(const std::vector<CubemapImage>& faces);
     void toggleSkybox() { skyboxEnabled = !skyboxEnabled; }
 
     Mesh* getCubeMesh() { return &cubeMesh; } 
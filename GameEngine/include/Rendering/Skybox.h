@@ -32,6 +32,11 @@ public:
      */
     bool loadCubemap(const std::vector<std::string>& faces);
 
+    /**
+     * @brief Create the skybox from faces decoded with Cubemap::decodeFace()
+     */
+    bool loadCubemap(const std::vector<CubemapImage>& faces);
+
     /**
      * @brief Render the skybox
      * @param view Camera view matrix
@@ -11,6 +11,7 @@
 #include "../include/Scene/PhysicsComponent.h"
 #include "../include/Scene/RenderComponent.h"
 #include "../include/Scene/ScriptComponent.h"
+#include "../include/Physics/ContactEvents.h"
 /**
  * @brief  A component-based game object.
  *
@@ -52,6 +53,9 @@ private:
 	// Support multiple scripts per object - store in a vector
     std::vector<std::unique_ptr<ScriptComponent>> scripts;
 
+    // Set by Scene::requestDestroy(), the object is removed at the end of Scene::update()
+    bool destroyQueued = false;
+
 public:
 
     // Getter for ID
@@ -114,9 +118,16 @@ public:
     /** Called by Scene::update() every physics tick in Game mode */
     void fixedUpdateScripts(float fixedDt);
 
+    /** Calls onCollisionEnter/Stay/Exit on all scripts - called by Scene::dispatchContactEvents() */
+    void collisionScripts(ContactEventType type, const Collision& collision);
+
     /** Calls onDestroy() on all scripts - called by Scene before destruction */
     void notifyDestroy();
 
+    /** True once Scene::requestDestroy() has queued this object */
+    bool isDestroyQueued() const { return destroyQueued; }
+    void setDestroyQueued(bool queued) { destroyQueued = queued; }
+
     template<typename T>
     bool removeScript()
     {
@@ -175,6 +186,15 @@ public:
     glm::quat getRotation() const { return transform.getRotation(); }
     glm::vec3 getScale() const { return transform.getScale(); }
 
+    // Pose the renderer should draw: interpolated between physics ticks when
+    // available, otherwise the transform
+    glm::vec3 getRenderPosition() const {
+        return render.hasInterpolatedPose() ? render.getInterpolatedPosition() : transform.getPosition();
+    }
+    glm::quat getRenderRotation() const {
+        return render.hasInterpolatedPose() ? render.getInterpolatedRotation() : transform.getRotation();
+    }
+
     void setPosition(const glm::vec3& pos);
     void setRotation(const glm::quat& rot);
     void setScale(const glm::vec3& scale);
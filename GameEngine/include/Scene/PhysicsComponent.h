@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <string>
+#include <cstdint>
 
 class TransformComponent;
 
@@ -24,6 +25,17 @@ private:
     btRigidBody* rigidBody;      // Not owned - Physics system manages this
     std::string materialName;
 
+    // Body pose at the previous and latest fixed tick, used for render interpolation
+    glm::vec3 previousPosition = glm::vec3(0.0f);
+    glm::vec3 currentPosition = glm::vec3(0.0f);
+    glm::quat previousRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::quat currentRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    bool poseHistoryValid = false;
+
+    // Bookkeeping for Scene's moved-body lists (see Scene::capturePhysicsPoses)
+    uint64_t lastPoseTick = 0;
+    bool transformSyncQueued = false;
+
 public:
     PhysicsComponent(btRigidBody* body, const std::string& material)
         : rigidBody(body), materialName(material) {
@@ -46,7 +58,34 @@ public:
 
     void setRigidBody(btRigidBody* newBody) {
         rigidBody = newBody;
+        resetPoseHistory();
     }
+
+    /**
+     * @brief Record the body's pose for this fixed tick.
+     * Call once per physics tick, after stepping. The previous tick's pose is kept
+     * so the renderer can interpolate between the two.
+     */
+    void capturePose();
+
+    /**
+     * @brief Blend between the previous and latest tick poses.
+     * @param alpha 0 = previous tick, 1 = latest tick (accumulator / fixedDt)
+     */
+    void getInterpolatedPose(float alpha, glm::vec3& outPosition, glm::quat& outRotation) const;
+
+    bool hasPoseHistory() const { return poseHistoryValid; }
+
+    // Forget the tick history (after a teleport) so the next frame doesn't smear
+    void resetPoseHistory() { poseHistoryValid = false; }
+
+    // Scene tick of the last capturePose() done by Scene
+    uint64_t getLastPoseTick() const { return lastPoseTick; }
+    void setLastPoseTick(uint64_t tick) { lastPoseTick = tick; }
+
+    // True while the owning object waits in Scene's transform sync list
+    bool isTransformSyncQueued() const { return transformSyncQueued; }
+    void setTransformSyncQueued(bool queued) { transformSyncQueued = queued; }
 };
 
 #endif // PHYSICSCOMPONENT_H
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define RENDERCOMPONENT_H
 #include "Component.h"
 #include "Rendering/Mesh.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <string>
 
 /**
@@ -32,6 +34,12 @@ private:
     std::string modelPath;  // empty = primitive shape, set = loaded mesh file
     Mesh* renderMesh; // Pointer to the mesh used for rendering
 
+    // Pose blended between the last two physics ticks (set by Scene::update in Game mode).
+    // When not set the renderer uses the TransformComponent directly.
+    glm::vec3 interpolatedPosition = glm::vec3(0.0f);
+    glm::quat interpolatedRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    bool interpolatedPoseValid = false;
+
 public:
     RenderComponent(ShapeType type, const std::string& texture = "")
         : shapeType(type), texturePath(texture), specularTexturePath(""), renderMesh(nullptr) {
@@ -50,5 +58,15 @@ public:
     void setModelPath(const std::string& path) { modelPath = path; }
     void setRenderMesh(Mesh* mesh) { renderMesh = mesh; }
     Mesh* getRenderMesh() const { return renderMesh; }
+
+    void setInterpolatedPose(const glm::vec3& position, const glm::quat& rotation) {
+        interpolatedPosition = position;
+        interpolatedRotation = rotation;
+        interpolatedPoseValid = true;
+    }
+    void clearInterpolatedPose() { interpolatedPoseValid = false; }
+    bool hasInterpolatedPose() const { return interpolatedPoseValid; }
+    const glm::vec3& getInterpolatedPosition() const { return interpolatedPosition; }
+    const glm::quat& getInterpolatedRotation() const { return interpolatedRotation; }
 };
 #endif // RENDERCOMPONENT_H
\ No newline at end of file
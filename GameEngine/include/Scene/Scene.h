@@ -9,19 +9,29 @@
 #include "../include/Scene/GameObject.h"
 #include "../include/Physics/Physics.h"
 #include "../include/Physics/SpatialGrid.h" 
-#include "../include/Rendering/Renderer.h"
+#include "../include/Physics/SpatialIndex.h"
 enum class EngineMode;
+class Renderer;
+struct RenderSnapshot;
 
 class Scene {
 
 private:
     Physics& physicsWorld;
-    Renderer& renderer;
+    Renderer* renderer; // null for headless scenes
     std::vector<std::unique_ptr<GameObject>> gameObjects;
-    // Spatial grid for fast proximity queries
-    std::unique_ptr<SpatialGrid> spatialGrid;
+    // Spatial index for fast proximity queries (grid, loose octree or AABB tree)
+    std::unique_ptr<ISpatialIndex> spatialIndex;
+    // Backend and grid cell size, saved with the scene and used when the index is rebuilt
+    SpatialIndexType spatialIndexType = SpatialIndexType::UniformGrid;
+    float spatialCellSize = 10.0f;
     // Flag to track if we've synced with the editor at least once (to avoid redundant syncs)
     bool editorSyncedOnce = false;
+
+    // Fixed physics timestep, passed to onFixedUpdate by fixedUpdate()
+    float fixedTimestep = 1.0f / 60.0f;
+    // True while objects carry interpolated render poses (Game/Test mode)
+    bool renderInterpolationActive = false;
     
     // Simple directional light state for now
     glm::vec3 savedLightDir = glm::vec3(0.3f, -1.0f, 0.5f);
@@ -31,6 +41,19 @@ private:
 
     std::vector<GameObject*> pendingDestroy;
 
+    // Objects whose body Bullet moved since the last transform sync (Game/Test mode)
+    std::vector<GameObject*> transformSyncList;
+    // Objects whose pose was captured on the previous tick, they get one more
+    // capture the tick they stop so the interpolation settles
+    std::vector<GameObject*> posedLastTick;
+    std::vector<GameObject*> posedThisTick;
+    uint64_t poseTick = 0;
+
+    // Collision events taken from Physics each update, reused so delivery doesn't allocate
+    std::vector<ContactEvent> contactEventBuffer;
+    // Delivers the queued collision enter/stay/exit events to both objects' scripts
+    void dispatchContactEvents();
+
     // Maps tag strings to script-attacher lambdas.
     // Populated by registerTagScript() in SetupScripts().
     // Queried by wireTagCallback() which is installed on every spawned object.
@@ -71,6 +94,8 @@ private:
 
 public:
     Scene(Physics& physics, Renderer& renderer);
+    // Headless scene: no renderer, objects get no render mesh (see HeadlessRunner)
+    explicit Scene(Physics& physics);
     ~Scene();
 
     // Factory methods for creating objects
@@ -99,8 +124,33 @@ public:
 
     void setObjectScale(GameObject* obj, const glm::vec3& newScale);
     void setObjectPhysicsScale(GameObject* obj, const glm::vec3& newPhysicsScale);
-    // Update all objects from physics simulation
-    void update(EngineMode mode);
+    // Update all objects from physics simulation.
+    // interpolationAlpha = accumulator / fixedDt, used to blend render poses between ticks
+    // Runs the three passes below in order (serial callers). fixedUpdate() is not part of it.
+    void update(EngineMode mode, float interpolationAlpha = 1.0f);
+
+    // Passes of update(), split so the engine's frame TaskGraph can run the last two concurrently.
+    // updateObjects: onUpdate scripts, physics -> transform sync and deferred destruction (touches everything).
+    // updateRenderInterpolation: reads physics pose history, writes render poses only.
+    // updateSpatialGrid: reads transforms (clears their spatial dirty flag), writes the spatial index only.
+    void updateObjects(EngineMode mode);
+    void updateRenderInterpolation(EngineMode mode, float interpolationAlpha);
+    void updateSpatialGrid();
+
+    // Collision events from the last step, then onFixedUpdate on every script.
+    // Call once per fixed tick, before that tick's physics step (Game/Test mode).
+    void fixedUpdate();
+
+    // Record the pose of every body that moved for render interpolation, call once per fixed tick
+    void capturePhysicsPoses();
+
+    // Copy render poses, selection, point lights and debug volumes into a snapshot for Renderer::draw
+    void buildRenderSnapshot(RenderSnapshot& out,
+        const GameObject* primarySelection,
+        const std::vector<GameObject*>& selectedObjects) const;
+
+    void setFixedTimestep(float dt) { fixedTimestep = dt; }
+    float getFixedTimestep() const { return fixedTimestep; }
 
     // Get all objects for rendering
     const std::vector<std::unique_ptr<GameObject>>& getObjects() const { return gameObjects; }
@@ -139,6 +189,18 @@ public:
         std::function<bool(GameObject*)> filter = nullptr
     ) const;
 
+    /**
+     * Find the k nearest objects within max radius, closest first (targeting, crowd avoidance).
+     * out is cleared first, reuse it across calls.
+     */
+    void findKNearestObjects(
+        const glm::vec3& position,
+        int k,
+        float maxRadius,
+        std::vector<GameObject*>& out,
+        std::function<bool(GameObject*)> filter = nullptr
+    ) const;
+
     /**
      * Find all objects that have a specific tag.
      * for  SetupScripts() to bulk-attach scripts:
@@ -163,7 +225,17 @@ public:
     // === Spatial Grid Control ===
 
     void setSpatialGridEnabled(bool enabled);
-    bool isSpatialGridEnabled() const { return spatialGrid != nullptr; }
+    bool isSpatialGridEnabled() const { return spatialIndex != nullptr; }
+    // Swaps the backend and re-inserts every object. cellSize is only used by the grid.
+    void setSpatialIndexType(SpatialIndexType type, float cellSize = 10.0f);
+    SpatialIndexType getSpatialIndexType() const { return spatialIndexType; }
+    float getSpatialCellSize() const { return spatialCellSize; }
+    // Null while the index is disabled
+    const ISpatialIndex* getSpatialIndex() const { return spatialIndex.get(); }
+    // Null while the index is disabled or is not the grid. Use its visit* queries to avoid allocating per query
+    const SpatialGrid* getSpatialGrid() const {
+        return spatialIndexType == SpatialIndexType::UniformGrid ? static_cast<const SpatialGrid*>(spatialIndex.get()) : nullptr;
+    }
     void printSpatialStats() const;
 
     
@@ -174,7 +246,9 @@ public:
     void clear();
 
     // Scene serialization
-    bool saveToFile(const std::string& path) const;
+    // includeMotion also stores dynamic bodies' pose, velocities and sleep state
+    // (used by input recordings, which can start mid-simulation in Game mode)
+    bool saveToFile(const std::string& path, bool includeMotion = false) const;
     bool loadFromFile(const std::string& path);
 
 
@@ -1,7 +1,19 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
 class GameObject;
 
+// Contact reported to onCollisionEnter/Stay/Exit. normal points from the other
+// object towards this one, impulse is the solver impulse of the step (0 on exit).
+struct Collision
+{
+    GameObject* other = nullptr;
+    glm::vec3 point{ 0.0f };
+    glm::vec3 normal{ 0.0f };
+    float impulse = 0.0f;
+};
+
 
 //  ScriptComponent  -  ENGINE SIDE (do not modify)
 //
@@ -13,6 +25,8 @@ class GameObject;
 //    onUpdate(dt)     - called every frame in Game mode
 //    onFixedUpdate()  - called every physics tick (1/60s) in Game mode
 //    onDestroy()      - called when the owning GameObject is destroyed
+//    onCollisionEnter/Stay/Exit(collision)
+//                     - touching bodies, delivered in bulk before onFixedUpdate
 //
 
 
@@ -34,6 +48,12 @@ public:
     // Called when the owning GameObject is about to be destroyed
     virtual void onDestroy() {}
 
+    // Called in Game mode for every physics step the owner's body touches another
+    // body: Enter on the first step, Stay while touching, Exit once they separate
+    virtual void onCollisionEnter(const Collision& collision) {}
+    virtual void onCollisionStay(const Collision& collision) {}
+    virtual void onCollisionExit(const Collision& collision) {}
+
     void setOwner(GameObject* obj) { owner = obj; }
     GameObject* getOwner() const { return owner; }
 
@@ -18,6 +18,10 @@ private:
     glm::quat rotation;
     glm::vec3 scale;
 
+    // Position or scale changed since Scene::updateSpatialGrid() last re-binned
+    // the object. Rotation doesn't matter, the grid bins the unrotated scale box.
+    bool spatialDirty = true;
+
 public:
     TransformComponent(const glm::vec3& pos = glm::vec3(0.0f),
         const glm::quat& rot = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
@@ -31,9 +35,23 @@ public:
     const glm::vec3& getScale() const { return scale; }
 
     // Setters
-    void setPosition(const glm::vec3& pos) { position = pos; }
+    void setPosition(const glm::vec3& pos) {
+        if (pos != position) {
+            position = pos;
+            spatialDirty = true;
+        }
+    }
     void setRotation(const glm::quat& rot) { rotation = rot; }
-    void setScale(const glm::vec3& scl) { scale = scl; }
+    void setScale(const glm::vec3& scl) {
+        if (scl != scale) {
+            scale = scl;
+            spatialDirty = true;
+        }
+    }
+
+    // Spatial grid bookkeeping, cleared by Scene::updateSpatialGrid()
+    bool isSpatialDirty() const { return spatialDirty; }
+    void clearSpatialDirty() { spatialDirty = false; }
 
     // Utility methods
     glm::mat4 getModelMatrix() const {
@@ -1,7 +1,25 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
+class BenchmarkRecorder;
+
 class TestUI
 {
 public:
-    void draw();
-};
\ No newline at end of file
+    void draw(const BenchmarkRecorder& benchmark);
+
+    // Returns true once after "Run" was pressed, with the chosen scenario file
+    bool consumeBenchmarkRequest(std::string& scenarioPath);
+
+private:
+    // Allocations-per-frame budget for the allocation test, 0 = off
+    int allocationBudget = 0;
+
+    // Benchmark scenarios found in assets/benchmarks (scanned once, Refresh rescans)
+    std::vector<std::string> scenarioFiles;
+    bool scenariosLoaded = false;
+    int selectedScenario = 0;
+    std::string pendingScenario;
+};
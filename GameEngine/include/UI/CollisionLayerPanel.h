@@ -0,0 +1,3 @@
+#pragma once
+#include "../Debug/DebugUIContext.h"
+void DrawCollisionLayerPanel(DebugUIContext& context);
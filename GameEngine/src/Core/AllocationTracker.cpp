@@ -0,0 +1,164 @@
+#include "../include/Core/AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> totalAllocations{ 0 };
+    std::atomic<uint64_t> totalBytes{ 0 };
+    std::atomic<uint64_t> totalFrees{ 0 };
+
+    // Plain thread-locals: no constructor, safe to touch from inside operator new
+    thread_local uint64_t threadAllocations = 0;
+    thread_local uint64_t threadBytes = 0;
+
+    // Frame state (main thread)
+    uint64_t frameStartAllocations = 0;
+    uint64_t frameStartBytes = 0;
+    uint64_t frameStartFrees = 0;
+    uint64_t lastFrameAllocations = 0;
+    uint64_t lastFrameBytes = 0;
+    uint64_t lastFrameFrees = 0;
+    uint64_t peakFrameAllocations = 0;
+
+    uint64_t frameBudget = 0;
+    uint64_t framesOverBudget = 0;
+    bool lastFrameOverBudget = false;
+    int framesToIgnore = 0;
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    inline void countAllocation(std::size_t size)
+    {
+        totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        totalBytes.fetch_add(size, std::memory_order_relaxed);
+        threadAllocations++;
+        threadBytes += size;
+    }
+
+    inline void* trackedAlloc(std::size_t size) noexcept
+    {
+        if (size == 0)
+            size = 1;
+        void* ptr = std::malloc(size);
+        if (ptr)
+            countAllocation(size);
+        return ptr;
+    }
+
+    inline void trackedFree(void* ptr) noexcept
+    {
+        if (!ptr)
+            return;
+        totalFrees.fetch_add(1, std::memory_order_relaxed);
+        std::free(ptr);
+    }
+#endif
+}
+
+#ifdef ENGINE_TRACK_ALLOCATIONS
+// Global replacements. Aligned (align_val_t) overloads are left to the runtime.
+void* operator new(std::size_t size)
+{
+    void* ptr = trackedAlloc(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* ptr = trackedAlloc(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+#endif
+
+bool AllocationTracker::isCompiledIn()
+{
+#ifdef ENGINE_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocationTracker::endFrame()
+{
+    uint64_t allocations = totalAllocations.load(std::memory_order_relaxed);
+    uint64_t bytes = totalBytes.load(std::memory_order_relaxed);
+    uint64_t frees = totalFrees.load(std::memory_order_relaxed);
+
+    lastFrameAllocations = allocations - frameStartAllocations;
+    lastFrameBytes = bytes - frameStartBytes;
+    lastFrameFrees = frees - frameStartFrees;
+
+    frameStartAllocations = allocations;
+    frameStartBytes = bytes;
+    frameStartFrees = frees;
+
+    if (framesToIgnore > 0)
+    {
+        framesToIgnore--;
+        lastFrameOverBudget = false;
+        return;
+    }
+
+    if (lastFrameAllocations > peakFrameAllocations)
+        peakFrameAllocations = lastFrameAllocations;
+
+    lastFrameOverBudget = frameBudget > 0 && lastFrameAllocations > frameBudget;
+    if (lastFrameOverBudget)
+    {
+        if (framesOverBudget == 0)
+        {
+            std::cerr << "[AllocationTracker] Frame exceeded allocation budget: "
+                << lastFrameAllocations << " allocations (budget " << frameBudget << ")" << std::endl;
+        }
+        framesOverBudget++;
+    }
+}
+
+uint64_t AllocationTracker::getFrameAllocations() { return lastFrameAllocations; }
+uint64_t AllocationTracker::getFrameBytes() { return lastFrameBytes; }
+uint64_t AllocationTracker::getFrameFrees() { return lastFrameFrees; }
+uint64_t AllocationTracker::getPeakFrameAllocations() { return peakFrameAllocations; }
+
+void AllocationTracker::getThreadCounters(uint64_t& allocations, uint64_t& bytes)
+{
+    allocations = threadAllocations;
+    bytes = threadBytes;
+}
+
+void AllocationTracker::setFrameBudget(uint64_t allocationsPerFrame)
+{
+    if (frameBudget != allocationsPerFrame)
+    {
+        frameBudget = allocationsPerFrame;
+        resetBudgetStats();
+    }
+}
+
+uint64_t AllocationTracker::getFrameBudget() { return frameBudget; }
+uint64_t AllocationTracker::getFramesOverBudget() { return framesOverBudget; }
+bool AllocationTracker::wasLastFrameOverBudget() { return lastFrameOverBudget; }
+
+void AllocationTracker::resetBudgetStats(int ignoreFrames)
+{
+    peakFrameAllocations = 0;
+    framesOverBudget = 0;
+    lastFrameOverBudget = false;
+    framesToIgnore = ignoreFrames;
+}
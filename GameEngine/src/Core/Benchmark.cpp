@@ -0,0 +1,507 @@
+#include "../include/Core/Benchmark.h"
+#include "../include/Core/AllocationTracker.h"
+#include "../include/Scene/Scene.h"
+#include "../include/Physics/TriggerRegistry.h"
+#include "../include/Physics/ForceGeneratorRegistry.h"
+#include "../External/json/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+using json = nlohmann::json;
+
+#ifndef ENGINE_GIT_COMMIT
+#define ENGINE_GIT_COMMIT "unknown"
+#endif
+
+namespace
+{
+    glm::vec3 readVec3(const json& j, const char* key, const glm::vec3& fallback)
+    {
+        if (!j.contains(key) || !j[key].is_array() || j[key].size() != 3)
+            return fallback;
+        return glm::vec3(j[key][0].get<float>(), j[key][1].get<float>(), j[key][2].get<float>());
+    }
+
+    bool parseShape(const std::string& name, ShapeType& out)
+    {
+        if (name == "cube")    { out = ShapeType::CUBE; return true; }
+        if (name == "sphere")  { out = ShapeType::SPHERE; return true; }
+        if (name == "capsule") { out = ShapeType::CAPSULE; return true; }
+        return false;
+    }
+
+    bool parseTriggerType(const std::string& name, TriggerType& out)
+    {
+        if (name == "teleport")   { out = TriggerType::TELEPORT; return true; }
+        if (name == "speed_zone") { out = TriggerType::SPEED_ZONE; return true; }
+        if (name == "event")      { out = TriggerType::EVENT; return true; }
+        return false;
+    }
+
+    // Explosions are one-shot and would make runs depend on timing, so not allowed here
+    bool parseGeneratorType(const std::string& name, ForceGeneratorType& out)
+    {
+        if (name == "wind")         { out = ForceGeneratorType::WIND; return true; }
+        if (name == "gravity_well") { out = ForceGeneratorType::GRAVITY_WELL; return true; }
+        if (name == "vortex")       { out = ForceGeneratorType::VORTEX; return true; }
+        return false;
+    }
+
+    // Nearest-rank percentile on an already sorted list
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty()) return 0.0;
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    double peakResidentMB()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+        return 0.0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0.0;
+#ifdef __APPLE__
+        return usage.ru_maxrss / (1024.0 * 1024.0); // bytes
+#else
+        return usage.ru_maxrss / 1024.0;            // kilobytes
+#endif
+#endif
+    }
+
+    std::string utcTimestamp()
+    {
+        std::time_t now = std::time(nullptr);
+        std::tm utc{};
+#ifdef _WIN32
+        gmtime_s(&utc, &now);
+#else
+        gmtime_r(&now, &utc);
+#endif
+        std::ostringstream out;
+        out << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+        return out.str();
+    }
+}
+
+// ===== Scenario =====
+
+namespace
+{
+    // Fills scenario from a parsed scenario file, mistyped fields throw json::type_error
+    bool readScenario(const json& j, const std::string& path, BenchmarkScenario& scenario)
+    {
+        scenario.name = j.value("name", std::filesystem::path(path).stem().string());
+
+        // Scene paths are relative to the scenario file so they work from any working directory
+        std::string scene = j.value("scene", std::string());
+        if (!scene.empty())
+            scenario.scenePath = (std::filesystem::path(path).parent_path() / scene).lexically_normal().string();
+
+        scenario.groundPlane = j.value("groundPlane", true);
+        scenario.warmupFrames = std::max(0, j.value("warmupFrames", scenario.warmupFrames));
+        scenario.frames = std::max(1, j.value("frames", scenario.frames));
+        scenario.fixedDt = j.value("fixedDt", scenario.fixedDt);
+        if (scenario.fixedDt <= 0.0)
+            scenario.fixedDt = 1.0 / 60.0;
+
+        if (j.contains("spawns"))
+        {
+            for (const auto& s : j["spawns"])
+            {
+                BenchmarkScenario::SpawnGroup group;
+                if (!parseShape(s.value("shape", std::string("cube")), group.shape))
+                {
+                    std::cerr << "[Benchmark] Unknown shape in " << path << ": " << s.value("shape", std::string()) << std::endl;
+                    return false;
+                }
+                group.count = std::max(0, s.value("count", 0));
+                group.size = readVec3(s, "size", group.size);
+                group.mass = s.value("mass", group.mass);
+                group.material = s.value("material", group.material);
+                group.origin = readVec3(s, "origin", group.origin);
+                group.spacing = s.value("spacing", group.spacing);
+                group.columns = std::max(1, s.value("columns", group.columns));
+                group.rows = std::max(1, s.value("rows", group.rows));
+                scenario.spawns.push_back(group);
+            }
+        }
+
+        if (j.contains("triggers"))
+        {
+            for (const auto& t : j["triggers"])
+            {
+                BenchmarkScenario::TriggerGroup group;
+                if (!parseTriggerType(t.value("type", std::string("speed_zone")), group.type))
+                {
+                    std::cerr << "[Benchmark] Unknown trigger type in " << path << ": " << t.value("type", std::string()) << std::endl;
+                    return false;
+                }
+                group.count = std::max(0, t.value("count", 0));
+                group.size = readVec3(t, "size", group.size);
+                group.origin = readVec3(t, "origin", group.origin);
+                group.spacing = t.value("spacing", group.spacing);
+                group.force = readVec3(t, "force", group.force);
+                group.destination = readVec3(t, "destination", group.destination);
+                scenario.triggers.push_back(group);
+            }
+        }
+
+        if (j.contains("forceGenerators"))
+        {
+            for (const auto& g : j["forceGenerators"])
+            {
+                BenchmarkScenario::GeneratorGroup group;
+                if (!parseGeneratorType(g.value("type", std::string("vortex")), group.type))
+                {
+                    std::cerr << "[Benchmark] Unsupported generator type in " << path << ": " << g.value("type", std::string()) << std::endl;
+                    return false;
+                }
+                group.count = std::max(0, g.value("count", 0));
+                group.origin = readVec3(g, "origin", group.origin);
+                group.spacing = g.value("spacing", group.spacing);
+                group.radius = g.value("radius", group.radius);
+                group.strength = g.value("strength", group.strength);
+                group.direction = readVec3(g, "direction", group.direction);
+                scenario.generators.push_back(group);
+            }
+        }
+
+        return true;
+    }
+}
+
+bool BenchmarkScenario::loadFromFile(const std::string& path, BenchmarkScenario& out)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "[Benchmark] Failed to open scenario: " << path << std::endl;
+        return false;
+    }
+
+    // Any json::exception (bad syntax or a field of the wrong type) rejects the scenario
+    BenchmarkScenario scenario;
+    try
+    {
+        json j;
+        file >> j;
+        if (!readScenario(j, path, scenario))
+            return false;
+    }
+    catch (const json::exception& e)
+    {
+        std::cerr << "[Benchmark] Invalid scenario JSON " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    out = std::move(scenario);
+    return true;
+}
+
+bool BenchmarkScenario::populate(Scene& scene) const
+{
+    if (!scenePath.empty())
+    {
+        if (!scene.loadFromFile(scenePath))
+        {
+            std::cerr << "[Benchmark] Failed to load scene: " << scenePath << std::endl;
+            return false;
+        }
+    }
+    else
+    {
+        scene.clear();
+    }
+
+    if (groundPlane)
+        scene.spawnObject(ShapeType::CUBE, glm::vec3(0, -0.25f, 0), glm::vec3(100.0f, 0.5f, 100.0f), 0.0f, "Default");
+
+    for (const SpawnGroup& group : spawns)
+    {
+        int perLayer = group.columns * group.rows;
+        for (int i = 0; i < group.count; i++)
+        {
+            glm::vec3 cell(
+                static_cast<float>(i % group.columns),
+                static_cast<float>(i / perLayer),
+                static_cast<float>((i / group.columns) % group.rows));
+            scene.spawnObject(group.shape, group.origin + cell * group.spacing, group.size, group.mass, group.material);
+        }
+    }
+
+    auto& triggerRegistry = TriggerRegistry::getInstance();
+    int triggerIndex = 0;
+    for (const TriggerGroup& group : triggers)
+    {
+        for (int i = 0; i < group.count; i++)
+        {
+            glm::vec3 position = group.origin + glm::vec3(i * group.spacing, 0.0f, 0.0f);
+            Trigger* trigger = triggerRegistry.createTrigger(
+                "BenchTrigger_" + std::to_string(triggerIndex++), group.type, position, group.size);
+            if (!trigger)
+                continue;
+
+            if (group.type == TriggerType::SPEED_ZONE)
+            {
+                float magnitude = glm::length(group.force);
+                if (magnitude > 0.0f)
+                    trigger->setForce(group.force / magnitude, magnitude);
+            }
+            else if (group.type == TriggerType::TELEPORT)
+            {
+                trigger->setTeleportDestination(group.destination);
+            }
+        }
+    }
+
+    auto& generatorRegistry = ForceGeneratorRegistry::getInstance();
+    int generatorIndex = 0;
+    for (const GeneratorGroup& group : generators)
+    {
+        for (int i = 0; i < group.count; i++)
+        {
+            glm::vec3 position = group.origin + glm::vec3(i * group.spacing, 0.0f, 0.0f);
+            std::string name = "BenchGenerator_" + std::to_string(generatorIndex++);
+            switch (group.type)
+            {
+            case ForceGeneratorType::WIND:
+                generatorRegistry.createWind(name, position, group.radius, group.direction, group.strength);
+                break;
+            case ForceGeneratorType::GRAVITY_WELL:
+                generatorRegistry.createGravityWell(name, position, group.radius, group.strength);
+                break;
+            case ForceGeneratorType::VORTEX:
+                generatorRegistry.createVortex(name, position, group.radius, group.direction, group.strength, group.strength * 0.5f);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    // Loaded scenes are frozen for the editor, wake everything like entering Game mode does
+    for (auto& obj : scene.getObjects())
+    {
+        if (obj->hasPhysics() && obj->getRigidBody())
+            obj->getRigidBody()->activate(true);
+    }
+
+    std::cout << "[Benchmark] Scenario '" << name << "' ready: " << scene.getObjects().size() << " objects" << std::endl;
+    return true;
+}
+
+// ===== Recorder =====
+
+void BenchmarkRecorder::begin(const BenchmarkScenario& scenario, const std::string& mode)
+{
+    running = true;
+    scenarioName = scenario.name;
+    this->mode = mode;
+    warmupFrames = scenario.warmupFrames;
+    recordFrames = scenario.frames;
+    framesDone = 0;
+
+    frameMs.clear();
+    physicsMs.clear();
+    frameMs.reserve(recordFrames);
+    physicsMs.reserve(recordFrames);
+    totalAllocations = 0;
+    totalAllocBytes = 0;
+    peakAllocations = 0;
+}
+
+bool BenchmarkRecorder::addFrame(double frameTimeMs, double physicsTimeMs)
+{
+    if (!running)
+        return false;
+
+    if (framesDone++ < warmupFrames)
+        return false;
+
+    frameMs.push_back(frameTimeMs);
+    physicsMs.push_back(physicsTimeMs);
+
+    uint64_t allocations = AllocationTracker::getFrameAllocations();
+    totalAllocations += allocations;
+    totalAllocBytes += AllocationTracker::getFrameBytes();
+    peakAllocations = std::max(peakAllocations, allocations);
+
+    return static_cast<int>(frameMs.size()) >= recordFrames;
+}
+
+BenchmarkResult BenchmarkRecorder::finish(int rigidBodyCount)
+{
+    running = false;
+
+    BenchmarkResult result;
+    result.scenario = scenarioName;
+    result.mode = mode;
+    result.commit = ENGINE_GIT_COMMIT;
+    result.timestamp = utcTimestamp();
+    result.frames = static_cast<int>(frameMs.size());
+    result.rigidBodies = rigidBodyCount;
+    result.peakResidentMB = peakResidentMB();
+
+    if (!frameMs.empty())
+    {
+        double frameSum = 0.0, physicsSum = 0.0;
+        for (double ms : frameMs) frameSum += ms;
+        for (double ms : physicsMs) physicsSum += ms;
+
+        std::vector<double> sortedFrames = frameMs;
+        std::vector<double> sortedPhysics = physicsMs;
+        std::sort(sortedFrames.begin(), sortedFrames.end());
+        std::sort(sortedPhysics.begin(), sortedPhysics.end());
+
+        result.frameMinMs = sortedFrames.front();
+        result.frameAvgMs = frameSum / frameMs.size();
+        result.frameP50Ms = percentile(sortedFrames, 0.50);
+        result.frameP99Ms = percentile(sortedFrames, 0.99);
+        result.frameMaxMs = sortedFrames.back();
+
+        result.physicsAvgMs = physicsSum / physicsMs.size();
+        result.physicsP99Ms = percentile(sortedPhysics, 0.99);
+        result.physicsMaxMs = sortedPhysics.back();
+
+        result.allocsPerFrameAvg = static_cast<double>(totalAllocations) / frameMs.size();
+        result.allocsPerFramePeak = peakAllocations;
+        result.allocKBPerFrameAvg = totalAllocBytes / 1024.0 / frameMs.size();
+    }
+
+    lastResult = result;
+    hasResult = true;
+    return result;
+}
+
+// ===== Result output =====
+
+bool BenchmarkResult::writeToFile(const std::string& path) const
+{
+    std::filesystem::path filePath(path);
+    if (filePath.has_parent_path())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(filePath.parent_path(), ec);
+    }
+
+    if (filePath.extension() == ".csv")
+    {
+        static const char* csvHeader = "scenario,mode,commit,timestamp,frames,rigid_bodies,"
+            "frame_min_ms,frame_avg_ms,frame_p50_ms,frame_p99_ms,frame_max_ms,"
+            "physics_avg_ms,physics_p99_ms,physics_max_ms,"
+            "allocs_per_frame_avg,allocs_per_frame_peak,alloc_kb_per_frame_avg,peak_rss_mb,physics_threads";
+
+        // Only append under the same columns. A file written by an older build
+        // is moved aside (results.csv -> results.old1.csv) and a new one started.
+        bool writeHeader = !std::filesystem::exists(filePath);
+        if (!writeHeader)
+        {
+            std::string existingHeader;
+            {
+                std::ifstream existing(path);
+                std::getline(existing, existingHeader);
+            }
+            if (!existingHeader.empty() && existingHeader.back() == '\r')
+                existingHeader.pop_back();
+
+            if (existingHeader != csvHeader)
+            {
+                std::filesystem::path movedPath;
+                for (int n = 1; movedPath.empty() || std::filesystem::exists(movedPath); n++)
+                    movedPath = filePath.parent_path() / (filePath.stem().string() + ".old" + std::to_string(n) + ".csv");
+
+                std::error_code ec;
+                std::filesystem::rename(filePath, movedPath, ec);
+                if (ec)
+                {
+                    std::cerr << "[Benchmark] " << path << " has different columns and could not be moved aside: " << ec.message() << std::endl;
+                    return false;
+                }
+                std::cout << "[Benchmark] " << path << " has different columns, moved it to " << movedPath.string() << std::endl;
+                writeHeader = true;
+            }
+        }
+
+        std::ofstream file(path, std::ios::app);
+        if (!file.is_open())
+        {
+            std::cerr << "[Benchmark] Failed to write " << path << std::endl;
+            return false;
+        }
+
+        if (writeHeader)
+            file << csvHeader << "\n";
+
+        file << std::fixed << std::setprecision(4)
+            << scenario << "," << mode << "," << commit << "," << timestamp << ","
+            << frames << "," << rigidBodies << ","
+            << frameMinMs << "," << frameAvgMs << "," << frameP50Ms << "," << frameP99Ms << "," << frameMaxMs << ","
+            << physicsAvgMs << "," << physicsP99Ms << "," << physicsMaxMs << ","
+            << allocsPerFrameAvg << "," << allocsPerFramePeak << "," << allocKBPerFrameAvg << ","
+            << peakResidentMB << "," << physicsThreads << "\n";
+        return file.good();
+    }
+
+    json j;
+    j["scenario"] = scenario;
+    j["mode"] = mode;
+    j["commit"] = commit;
+    j["timestamp"] = timestamp;
+    j["frames"] = frames;
+    j["rigidBodies"] = rigidBodies;
+    j["physicsThreads"] = physicsThreads;
+    j["frameMs"] = { {"min", frameMinMs}, {"avg", frameAvgMs}, {"p50", frameP50Ms}, {"p99", frameP99Ms}, {"max", frameMaxMs} };
+    j["physicsMs"] = { {"avg", physicsAvgMs}, {"p99", physicsP99Ms}, {"max", physicsMaxMs} };
+    j["memory"] = {
+        {"allocsPerFrameAvg", allocsPerFrameAvg},
+        {"allocsPerFramePeak", allocsPerFramePeak},
+        {"allocKBPerFrameAvg", allocKBPerFrameAvg},
+        {"peakResidentMB", peakResidentMB}
+    };
+
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "[Benchmark] Failed to write " << path << std::endl;
+        return false;
+    }
+    file << j.dump(4) << std::endl;
+    return file.good();
+}
+
+void BenchmarkResult::print() const
+{
+    std::cout << "\n=== Benchmark: " << scenario << " (" << mode << ", " << commit << ") ===" << std::endl;
+    std::cout << "Frames: " << frames << ", rigid bodies: " << rigidBodies
+        << ", physics threads: " << physicsThreads << std::endl;
+    std::cout << "Frame ms    min " << frameMinMs << "  avg " << frameAvgMs
+        << "  p50 " << frameP50Ms << "  p99 " << frameP99Ms << "  max " << frameMaxMs << std::endl;
+    std::cout << "Physics ms  avg " << physicsAvgMs << "  p99 " << physicsP99Ms << "  max " << physicsMaxMs << std::endl;
+    std::cout << "Memory      peak RSS " << peakResidentMB << " MB";
+    if (AllocationTracker::isCompiledIn())
+        std::cout << ", allocs/frame avg " << allocsPerFrameAvg << " peak " << allocsPerFramePeak;
+    std::cout << std::endl;
+}
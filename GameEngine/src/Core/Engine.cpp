@@ -7,6 +7,7 @@
 #include <vector>
 #include "../include/Rendering/Renderer.h"
 #include "../include/Input/Input.h"
+#include "../include/Input/InputReplay.h"
 #include "../include/Rendering/Camera.h"
 #include "../include/Input/CameraController.h"
 #include "../include/Core/GameTime.h"
@@ -31,7 +32,116 @@
 #include "../include/Gameplay/GameScene.h"
 #include "../include/Rendering/PointLightRegistry.h"
 #include "../include/Testing/TestUI.h"
+#include "../include/Core/Profiler.h"
+#include "../include/Core/Log.h"
+#include "../include/Core/AllocationTracker.h"
+#include "../include/Core/Benchmark.h"
+#include "../include/Physics/PhysicsStepThread.h"
+#include "../include/Rendering/RenderSnapshot.h"
+#include "../include/Core/ThreadPool.h"
+#include "../include/Core/StartupTimeline.h"
+#include "../include/Core/TaskGraph.h"
 #include <filesystem>
+#include <chrono>
+
+// Registry versions the debug UI views were last built from (~0 = never built)
+struct RegistryViewVersions
+{
+    uint64_t materials = ~0ull;
+    uint64_t constraints = ~0ull;
+    uint64_t triggers = ~0ull;
+};
+
+// Fills the registry-backed parts of the debug UI views (physics, constraints, triggers).
+// Runs as a frame graph task, so it must only read the registries and write uiContext views.
+// Lists and per-type counts are rebuilt only when a registry version changes; the
+// enabled/broken counts are re-counted from the cached lists (no allocation).
+static void fillRegistryViews(DebugUIContext& uiContext, Physics& physics, RegistryViewVersions& versions)
+{
+    uiContext.physics.rigidBodyCount = physics.getRigidBodyCount();
+    uiContext.physics.collisionShapeCount = static_cast<int>(physics.getCollisionShapeCount());
+    uiContext.physics.broadphasePairs = physics.getBroadphasePairCount();
+
+    // Populate available materials from the registry
+    auto& materialRegistry = MaterialRegistry::getInstance();
+    if (versions.materials != materialRegistry.getVersion())
+    {
+        uiContext.physics.availableMaterials = materialRegistry.getAllMaterialNames();
+        versions.materials = materialRegistry.getVersion();
+    }
+
+    auto& registry = ConstraintRegistry::getInstance();
+    if (versions.constraints != registry.getVersion())
+    {
+        // Update constraint view state
+        uiContext.constraints.totalConstraints = registry.getConstraintCount();
+        uiContext.constraints.allConstraints = registry.getAllConstraints();
+
+        // Count by type
+        uiContext.constraints.fixedCount = 0;
+        uiContext.constraints.hingeCount = 0;
+        uiContext.constraints.sliderCount = 0;
+        uiContext.constraints.springCount = 0;
+        uiContext.constraints.dof6Count = 0;
+        for (Constraint* c : uiContext.constraints.allConstraints) {
+            switch (c->getType()) {
+            case ConstraintType::FIXED:        uiContext.constraints.fixedCount++; break;
+            case ConstraintType::HINGE:        uiContext.constraints.hingeCount++; break;
+            case ConstraintType::SLIDER:       uiContext.constraints.sliderCount++; break;
+            case ConstraintType::SPRING:       uiContext.constraints.springCount++; break;
+            case ConstraintType::GENERIC_6DOF: uiContext.constraints.dof6Count++; break;
+            default: break;
+            }
+        }
+        versions.constraints = registry.getVersion();
+    }
+
+    // Count active/broken
+    uiContext.constraints.activeConstraints = 0;
+    uiContext.constraints.brokenConstraints = 0;
+    for (Constraint* c : uiContext.constraints.allConstraints) {
+        if (c->isBroken()) {
+            uiContext.constraints.brokenConstraints++;
+        }
+        else {
+            uiContext.constraints.activeConstraints++;
+        }
+    }
+
+    auto& triggerRegistry = TriggerRegistry::getInstance();
+    if (versions.triggers != triggerRegistry.getVersion())
+    {
+        // Update trigger view state
+        uiContext.triggers.totalTriggers = triggerRegistry.getTriggerCount();
+        uiContext.triggers.allTriggers = triggerRegistry.getAllTriggers();
+
+        // Count by type
+        uiContext.triggers.teleportCount = 0;
+        uiContext.triggers.speedZoneCount = 0;
+        uiContext.triggers.customCount = 0;
+        for (Trigger* t : uiContext.triggers.allTriggers) {
+            switch (t->getType()) {
+            case TriggerType::TELEPORT:   uiContext.triggers.teleportCount++; break;
+            case TriggerType::SPEED_ZONE: uiContext.triggers.speedZoneCount++; break;
+            case TriggerType::EVENT:      uiContext.triggers.customCount++; break;
+            default: break;
+            }
+        }
+        versions.triggers = triggerRegistry.getVersion();
+    }
+
+    // Count enabled/disabled
+    uiContext.triggers.enabledTriggers = 0;
+    uiContext.triggers.disabledTriggers = 0;
+    for (Trigger* t : uiContext.triggers.allTriggers) {
+        if (t->isEnabled()) {
+            uiContext.triggers.enabledTriggers++;
+        }
+        else {
+            uiContext.triggers.disabledTriggers++;
+        }
+    }
+}
 
 void simulate(double dt)
 {
@@ -70,55 +180,112 @@ int Start(void)
 
     PointLight* selectedPointLight = nullptr;
 
-    if (!glfwInit())
+    // Startup timeline, printed once the first frame is presented
+    StartupTimeline& startupTimeline = StartupTimeline::getInstance();
+    startupTimeline.begin();
+    startupTimeline.setBudgetMs(1500.0);
+
+    // Per-object / per-tick messages go through the async log writer
+    Log::initialize();
+
+    // Workers are started first so file decoding/parsing overlaps window,
+    // context and shader setup on the main thread (GL calls stay on main)
+    ThreadPool& threadPool = ThreadPool::getInstance();
     {
-        std::cout << "Failed to init GLFW" << std::endl;
-        return -1;
+        STARTUP_SCOPE("ThreadPool init");
+        threadPool.initialize();
     }
 
-    std::cout << "GLFW initialized" << std::endl;
+    // Load skybox
+    std::vector<std::string> skyboxFaces = {
+        "textures/skybox/right.jpg",
+        "textures/skybox/left.jpg",
+        "textures/skybox/top.jpg",
+        "textures/skybox/bottom.jpg",
+        "textures/skybox/front.jpg",
+        "textures/skybox/back.jpg"
+    };
+    std::vector<CubemapImage> skyboxImages(skyboxFaces.size());
+    PrimitiveMeshData primitiveMeshes;
 
-    // Request OpenGL 3.3 Core Profile
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // Declared after the data it writes so an early return waits for the
+    // tasks before that data is destroyed
+    TaskGroup startupTasks(threadPool);
 
-    window = glfwCreateWindow(960, 720, "Game Engine", NULL, NULL);
-    if (!window)
+    for (size_t i = 0; i < skyboxFaces.size(); i++)
     {
-        std::cout << "Failed to create window" << std::endl;
-        glfwTerminate();
-        return -1;
+        startupTasks.run([&skyboxFaces, &skyboxImages, i]() {
+            STARTUP_SCOPE("Decode skybox face");
+            Cubemap::decodeFace(skyboxFaces[i], skyboxImages[i]);
+        });
     }
+    startupTasks.run([&primitiveMeshes]() {
+        STARTUP_SCOPE("Build primitive meshes");
+        Renderer::buildPrimitiveMeshes(primitiveMeshes);
+    });
+    startupTasks.run([]() {
+        STARTUP_SCOPE("Parse constraint templates");
+        ConstraintTemplateRegistry::getInstance().load();
+    });
 
-    std::cout << "Window created" << std::endl;
-    glfwMakeContextCurrent(window);
-    glfwSwapInterval(0);
-
-    std::cout << "Initializing GLEW..." << std::endl;
-    glewExperimental = GL_TRUE;
-    GLenum err = glewInit();
-    if (err != GLEW_OK)
     {
-        std::cout << "GLEW Error: " << glewGetErrorString(err) << std::endl;
-        glfwTerminate();
-        return -1;
-    }
+        STARTUP_SCOPE("Window + GL context");
+        if (!glfwInit())
+        {
+            std::cout << "Failed to init GLFW" << std::endl;
+            return -1;
+        }
 
-    std::cout << "GLEW initialized successfully" << std::endl;
-    std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+        std::cout << "GLFW initialized" << std::endl;
 
-    // ImGui initialization (Engine-owned)
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
+        // Request OpenGL 3.3 Core Profile
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    ImGuiIO& io = ImGui::GetIO();
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
-    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+        window = glfwCreateWindow(960, 720, "Game Engine", NULL, NULL);
+        if (!window)
+        {
+            std::cout << "Failed to create window" << std::endl;
+            glfwTerminate();
+            return -1;
+        }
 
-    ImGui_ImplGlfw_InitForOpenGL(window, false);
-    ImGui_ImplOpenGL3_Init("#version 330");
+        std::cout << "Window created" << std::endl;
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(0);
+    }
+
+    {
+        STARTUP_SCOPE("GLEW init");
+        std::cout << "Initializing GLEW..." << std::endl;
+        glewExperimental = GL_TRUE;
+        GLenum err = glewInit();
+        if (err != GLEW_OK)
+        {
+            std::cout << "GLEW Error: " << glewGetErrorString(err) << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+
+        std::cout << "GLEW initialized successfully" << std::endl;
+        std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+    }
+
+    {
+        STARTUP_SCOPE("ImGui init");
+        // ImGui initialization (Engine-owned)
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+        io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+        io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+
+        ImGui_ImplGlfw_InitForOpenGL(window, false);
+        ImGui_ImplOpenGL3_Init("#version 330");
+    }
 
     // Initialize Input System
     Input::Initialize(window);
@@ -131,41 +298,49 @@ int Start(void)
     // Set background color
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
 
-    // Create and initialize renderer
+    // Create and initialize renderer (shaders + shadow map, meshes come from the workers)
     Renderer renderer;
-    renderer.initialize();
-
-    // Load skybox
-    std::vector<std::string> skyboxFaces = {
-        "textures/skybox/right.jpg",
-        "textures/skybox/left.jpg",
-        "textures/skybox/top.jpg",
-        "textures/skybox/bottom.jpg",
-        "textures/skybox/front.jpg",
-        "textures/skybox/back.jpg"
-    };
+    {
+        STARTUP_SCOPE("Shaders + shadow map");
+        renderer.initializePipeline();
+    }
 
-    if (renderer.loadSkybox(skyboxFaces)) {
-        std::cout << "Skybox loaded successfully!" << std::endl;
+    {
+        STARTUP_SCOPE("Wait for startup tasks");
+        startupTasks.wait();
     }
-    else {
-        std::cout << "Failed to load skybox" << std::endl;
+
+    {
+        STARTUP_SCOPE("GPU uploads");
+        renderer.uploadPrimitiveMeshes(primitiveMeshes);
+
+        if (renderer.loadSkybox(skyboxImages)) {
+            std::cout << "Skybox loaded successfully!" << std::endl;
+        }
+        else {
+            std::cout << "Failed to load skybox" << std::endl;
+        }
     }
+    skyboxImages.clear();
 
 	// Create and initialize physics system
     Physics physics;
-    physics.initialize();
-    ConstraintRegistry::getInstance().initialize(physics.getWorld());
-    TriggerRegistry::getInstance().initialize(physics.getWorld()); 
-    ForceGeneratorRegistry::getInstance().initialize(physics.getWorld());
-
-	// register ghost pair callback for trigger detection (bullet uses ghost objects to detect overlaps without physical response)
-    physics.getWorld()->getBroadphase()->getOverlappingPairCache()
-        ->setInternalGhostPairCallback(new btGhostPairCallback()); 
+    {
+        STARTUP_SCOPE("Physics init");
+        // Island solving on the thread pool when built with ENGINE_BULLET_MT
+        physics.setMultithreaded(Physics::isMultithreadingAvailable());
+        physics.initialize();
+        ConstraintRegistry::getInstance().initialize(physics.getWorld());
+        TriggerRegistry::getInstance().initialize(physics.getWorld()); 
+        ForceGeneratorRegistry::getInstance().initialize(physics.getWorld());
+
+        // register ghost pair callback for trigger detection (bullet uses ghost objects to detect overlaps without physical response)
+        physics.getWorld()->getBroadphase()->getOverlappingPairCache()
+            ->setInternalGhostPairCallback(new btGhostPairCallback()); 
+    }
 
     std::cout << "Physics world has " << physics.getRigidBodyCount()<< " rigid bodies" << std::endl;
-    // Initialize constraint templates
-    ConstraintTemplateRegistry::getInstance().load();
+    // Initialize constraint templates (file was parsed on a worker above)
     ConstraintTemplateRegistry::getInstance().initializeDefaults();
     std::cout << "Loaded " << ConstraintTemplateRegistry::getInstance().getTemplateCount()
         << " constraint templates" << std::endl;
@@ -188,8 +363,11 @@ int Start(void)
 
     CameraController cameraController(camera, 5.0f, 0.1f);
 
-    SetupScripts(scene, camera, physics);
-    SetupGameScene(scene, camera, physics);
+    {
+        STARTUP_SCOPE("Scene setup");
+        SetupScripts(scene, camera, physics);
+        SetupGameScene(scene, camera, physics);
+    }
    
     cameraController.setMode(CameraController::Mode::ORBIT);  // Start in orbit mode
     cameraController.setOrbitalCenter(glm::vec3(0.0f));
@@ -204,6 +382,13 @@ int Start(void)
     // Create TestUI
     TestUI testUI;
 
+    // Benchmark scenario run from the Test panel (see assets/benchmarks)
+    BenchmarkRecorder benchmarkRecorder;
+
+    // Input recording (F6) / replay (F7), the scene is snapshotted next to the log
+    const std::string inputRecordingPath = "recordings/session.inputrec";
+    std::chrono::steady_clock::time_point replayStartTime;
+
     // Create gizmo
     EditorGizmo gizmo;
 
@@ -215,7 +400,11 @@ int Start(void)
     glfwGetFramebufferSize(window, &fbW, &fbH);
 
     // --- Fixed timestep setup ---
-    const double fixedDt = 1.0 / 60.0; // Fixed timestep 60fps
+    // Rendering interpolates between physics ticks, so the tick rate can be
+    // lowered (e.g. 30) for large scenes without visible stutter
+    const double physicsTickRate = 60.0;
+    const double fixedDt = 1.0 / physicsTickRate;
+    scene.setFixedTimestep(static_cast<float>(fixedDt));
     double accumulator = 0.0; // Collects the elapsed time to decide when to run the next physics update
     int physicsSteps = 0;
     double physicsTimer = 0.0;
@@ -223,9 +412,309 @@ int Start(void)
     // Counters for testing
     double physicsTime = 0.0;
 
+    // --- Pipelined physics (P to toggle, Game/Test mode) ---
+    // Bullet steps the frame's last tick on a worker while this frame renders
+    // from the published snapshot. The worker is joined at the top of the next
+    // frame, before anything touches the scene or the physics world.
+    PhysicsStepThread physicsStepThread(physics);
+    bool pipelinedPhysics = false;
+    bool pipelinedTickPending = false; // kick one tick once the render snapshot is published
+    RenderSnapshotBuffer renderSnapshots;
+    const std::vector<GameObject*> noSelection;
+
+    // Main-thread half of a fixed tick, after its step. Serial and pipelined
+    // ticks both run it once per tick, in this order: forces applied here act
+    // on the next step, and every tick gets its own pose for interpolation.
+    auto finishFixedTick = [&]()
+    {
+        physics.postStep(static_cast<float>(fixedDt)); // constraints, triggers
+        TriggerRegistry::getInstance().update(static_cast<float>(fixedDt)); // Update triggers with fixed timestep
+        ForceGeneratorRegistry::getInstance().update(static_cast<float>(fixedDt));
+        scene.capturePhysicsPoses(); // keep previous/current pose for interpolation
+        physicsSteps++; // count how many physics updates ran this second
+    };
+
+    // --- Frame task graph ---
+    // Systems after Scene::updateObjects declare what they read/write and run
+    // concurrently on the pool when their sets don't overlap.
+    // (the pool itself was started at the top of Start())
+    TaskGraph frameGraph;
+    float interpolationAlpha = 1.0f;
+
+    // Debug UI Context
+    // This packages up read-only engine data and approved debug commands
+    // so DebugUI can display stats and issue requests without owning systems.
+    // It lives for the whole loop: commands are wired once here and the
+    // registry views are refreshed only when a registry's version changes.
+    DebugUIContext uiContext;
+    RegistryViewVersions uiViewVersions;
+
+    // generic spawn function
+    uiContext.scene.spawnObject =
+        [&scene](ShapeType type, const glm::vec3& position,
+            const glm::vec3& size, float mass,
+            const std::string& materialName,
+            const std::string& texturePath,
+            const std::string& specularPath)  // ADD THIS
+        {
+            return scene.spawnObject(type, position, size, mass, materialName, texturePath, specularPath);
+        };
+
+    // Spawn for objects without physics
+    uiContext.scene.spawnRenderObject =
+        [&scene](ShapeType type, const glm::vec3& pos, const glm::vec3& size,
+            const std::string& tex, const std::string& specularPath)  // ADD THIS
+        {
+            return scene.spawnRenderObject(type, pos, size, tex, specularPath);
+        };
+
+    // Register custom material command
+    uiContext.scene.registerMaterial =
+        [](const std::string& name, float friction, float restitution)
+        {
+            PhysicsMaterial customMat(name, friction, restitution);
+            MaterialRegistry::getInstance().registerMaterial(customMat);
+        };
+	// Set object scale command (handles both render and physics resizing)
+    uiContext.scene.setObjectScale =
+        [&scene](GameObject* obj, const glm::vec3& scale) {
+        scene.setObjectScale(obj, scale);
+        };
+
+    // Destroy object (deferred, editor-safe)
+    uiContext.scene.destroyObject =
+        [&scene, &selectedObjects](GameObject* obj)
+        {
+            if (!obj) return;
+
+            // Remove from selection list if present
+            selectedObjects.erase(
+                std::remove(selectedObjects.begin(), selectedObjects.end(), obj),
+                selectedObjects.end()
+            );
+
+            scene.requestDestroy(obj);
+        };
+
+
+    // Get available textures command
+    uiContext.scene.getAvailableTextures =
+        []() -> std::vector<std::string>
+        {
+            return FileUtils::getTextureFiles("textures");
+        };
+
+	// Lighting commands
+    uiContext.lighting.getLight = [&renderer]() -> DirectionalLight& {
+        return renderer.getLight();
+        };
+
+    // Get available models command
+    uiContext.scene.getAvailableModels =
+        []() -> std::vector<std::string> {
+        return FileUtils::getModelFiles("models");
+        };
+
+    // Model loading command
+    uiContext.scene.loadAndSpawnModel =
+        [&scene](const std::string& filepath, const glm::vec3& pos, const glm::vec3& meshScale,
+            bool enablePhysics,
+            float mass,
+            const glm::vec3& physicsBoxScale,
+            const std::string& materialName) -> GameObject* {
+        return scene.loadAndSpawnModel(filepath, pos, meshScale, enablePhysics, mass, physicsBoxScale, materialName);
+        };
+
+    uiContext.scene.setObjectPhysicsScale = [&scene](GameObject* obj, const glm::vec3& scale) {
+        scene.setObjectPhysicsScale(obj, scale);
+        };
+    uiContext.scene.setObjectCollisionLayer = [&physics](GameObject* obj, int layer) {
+        if (obj && obj->hasPhysics())
+            physics.setCollisionLayer(obj->getRigidBody(), layer);
+        };
+    // ===== Constraint System Commands =====
+    auto& registry = ConstraintRegistry::getInstance();
+
+    // === Creation Commands ===
+
+    uiContext.constraintCommands.createFixed =
+        [&registry](GameObject* objA, GameObject* objB) -> Constraint* {
+        auto constraint = ConstraintPreset::createFixed(objA, objB);
+        return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    uiContext.constraintCommands.createHinge =
+        [&registry](GameObject* objA, GameObject* objB,
+            const glm::vec3& worldPivot, const glm::vec3& worldAxis) -> Constraint* {
+                auto constraint = ConstraintPreset::createHinge(objA, objB, worldPivot, worldAxis);
+                return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    uiContext.constraintCommands.createHingeAdvanced =
+        [&registry](GameObject* objA, GameObject* objB, const HingeParams& params) -> Constraint* {
+        auto constraint = ConstraintPreset::createHinge(objA, objB, params);
+        return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    uiContext.constraintCommands.createSlider =
+        [&registry](GameObject* objA, GameObject* objB, const SliderParams& params) -> Constraint* {
+        auto constraint = ConstraintPreset::createSlider(objA, objB, params);
+        return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    uiContext.constraintCommands.createSpring =
+        [&registry](GameObject* objA, GameObject* objB, float stiffness, float damping) -> Constraint* {
+        auto constraint = ConstraintPreset::createSpring(objA, objB, stiffness, damping);
+        return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    uiContext.constraintCommands.createSpringAdvanced =
+        [&registry](GameObject* objA, GameObject* objB, const SpringParams& params) -> Constraint* {
+        auto constraint = ConstraintPreset::createSpring(objA, objB, params);
+        return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    uiContext.constraintCommands.createGeneric6Dof =
+        [&registry](GameObject* objA, GameObject* objB, const Generic6DofParams& params) -> Constraint* {
+        auto constraint = ConstraintPreset::createGeneric6Dof(objA, objB, params);
+        return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
+        };
+
+    // === Management Commands ===
+
+    uiContext.constraintCommands.removeConstraint =
+        [&registry](Constraint* constraint) {
+        registry.removeConstraint(constraint);
+        };
+
+    uiContext.constraintCommands.removeConstraintByName =
+        [&registry](const std::string& name) -> bool {
+        return registry.removeConstraint(name);
+        };
+
+    uiContext.constraintCommands.removeConstraintsForObject =
+        [&registry](GameObject* obj) {
+        registry.removeConstraintsForObject(obj);
+        };
+
+    uiContext.constraintCommands.clearAllConstraints =
+        [&registry]() {
+        registry.clearAll();
+        };
+
+    // === Query Commands ===
+
+    uiContext.constraintCommands.findConstraintByName =
+        [&registry](const std::string& name) -> Constraint* {
+        return registry.findConstraintByName(name);
+        };
+
+    uiContext.constraintCommands.findConstraintsForObject =
+        [&registry](GameObject* obj) -> std::vector<Constraint*> {
+        return registry.findConstraintsByObject(obj);
+        };
+
+    uiContext.constraintCommands.findConstraintsByType =
+        [&registry](ConstraintType type) -> std::vector<Constraint*> {
+        return registry.findConstraintsByType(type);
+        };
+    // ===== Trigger System Commands ===== (ADD THIS ENTIRE SECTION)
+    auto& triggerRegistry = TriggerRegistry::getInstance();
+
+    // === Creation Commands ===
+    uiContext.triggerCommands.createTrigger =
+        [&triggerRegistry](const std::string& name, TriggerType type,
+            const glm::vec3& position, const glm::vec3& size) -> Trigger* {
+                return triggerRegistry.createTrigger(name, type, position, size);
+        };
+
+    // === Management Commands ===
+    uiContext.triggerCommands.removeTrigger =
+        [&triggerRegistry](Trigger* trigger) {
+        triggerRegistry.removeTrigger(trigger);
+        };
+
+    uiContext.triggerCommands.removeTriggerByName =
+        [&triggerRegistry](const std::string& name) -> bool {
+        return triggerRegistry.removeTrigger(name);
+        };
+
+    uiContext.triggerCommands.clearAllTriggers =
+        [&triggerRegistry]() {
+        triggerRegistry.clearAll();
+        };
+
+    // === Query Commands ===
+    uiContext.triggerCommands.findTriggerByName =
+        [&triggerRegistry](const std::string& name) -> Trigger* {
+        return triggerRegistry.findTriggerByName(name);
+        };
+
+    uiContext.triggerCommands.findTriggersByType =
+        [&triggerRegistry](TriggerType type) -> std::vector<Trigger*> {
+        return triggerRegistry.findTriggersByType(type);
+        };
+
+    uiContext.triggerCommands.findTriggersContainingObject =
+        [&triggerRegistry](GameObject* obj) -> std::vector<Trigger*> {
+        return triggerRegistry.findTriggersContainingObject(obj);
+        };
+
+    // === Type-Specific Commands ===
+    uiContext.triggerCommands.setTeleportDestination =
+        [](Trigger* trigger, const glm::vec3& dest) {
+        if (trigger) trigger->setTeleportDestination(dest);
+        };
+
+    uiContext.triggerCommands.setForce =
+        [](Trigger* trigger, const glm::vec3& direction, float magnitude) {
+        if (trigger) trigger->setForce(direction, magnitude);
+        };
+    uiContext.triggerCommands.updateTriggerPosition =
+        [](Trigger* trigger, const glm::vec3& position) {
+        if (trigger) trigger->setPosition(position);
+        };
+
+    uiContext.triggerCommands.updateTriggerSize =
+        [](Trigger* trigger, const glm::vec3& size) {
+        if (trigger) trigger->setSize(size);
+        };
+
+    uiContext.triggerCommands.setTriggerEnabled =
+        [](Trigger* trigger, bool enabled) {
+        if (trigger) trigger->setEnabled(enabled);
+        };
+    uiContext.applyTriggerScripts = [&scene]() {
+        scene.applyTriggerScriptsToExistingTriggers();
+        };
+    uiContext.setPhysicsThreadCount = [&physics](int count) {
+        physics.setSolverThreadCount(count);
+        };
+
+
+    // Render interpolation, spatial grid and the registry views don't share
+    // any state, so they run side by side. Triggers/forces stay in the tick
+    // loop: trigger callbacks spawn objects and create explosions.
+    frameGraph.addTask("Scene::updateRenderInterpolation",
+        FrameResource::SceneObjects | FrameResource::PhysicsPoses,
+        FrameResource::RenderPoses | FrameResource::PhysicsPoses,
+        [&scene, &engineMode, &interpolationAlpha]() {
+            scene.updateRenderInterpolation(engineMode, interpolationAlpha);
+        });
+    // Writes Transforms too: it clears each transform's spatial dirty flag
+    frameGraph.addTask("Scene::updateSpatialGrid",
+        FrameResource::SceneObjects | FrameResource::Transforms,
+        FrameResource::SpatialGrid | FrameResource::Transforms,
+        [&scene]() { scene.updateSpatialGrid(); });
+    frameGraph.addTask("DebugUI::fillViews",
+        FrameResource::PhysicsWorld | FrameResource::Materials | FrameResource::Constraints | FrameResource::Triggers,
+        FrameResource::DebugViews,
+        [&uiContext, &physics, &uiViewVersions]() { fillRegistryViews(uiContext, physics, uiViewVersions); });
+
     std::cout << "Renderer initialized, entering main loop" << std::endl;
     std::cout << "Controls:" << std::endl;
     std::cout << "F1 - Toggle camera mode (Orbit/Free)" << std::endl;
+    std::cout << "F6 - Start/stop input recording, F7 - Replay/stop" << std::endl;
     std::cout << "WASD - Move (Free mode)" << std::endl;
     std::cout << "Space/Ctrl - Up/Down (Free mode)" << std::endl;
     std::cout << "Mouse - (Not yet implemented)" << std::endl;
@@ -235,6 +724,7 @@ int Start(void)
     // ===================================
     while (!glfwWindowShouldClose(window))
     {
+        Profiler::getInstance().beginFrame();
 
         // UI Toggle flag
         static bool showUI = true;
@@ -242,6 +732,11 @@ int Start(void)
         //Update time (calculates deltaTime automatically) 
         Time::Update();
         float deltaTime = Time::GetDeltaTime();
+
+        // Main-thread time spent on physics this frame, recorded by benchmark runs
+        using PhysicsClock = std::chrono::steady_clock;
+        double physicsFrameMs = 0.0;
+        auto physicsFrameStart = PhysicsClock::now();
         
         // Reset per-frame input states
         Input::BeginFrame();
@@ -249,6 +744,120 @@ int Start(void)
         //poll for input events 
         glfwPollEvents();
 
+        // Finish the pipelined tick that stepped during last frame's render,
+        // then do its main-thread half
+        if (physicsStepThread.wait() > 0)
+            finishFixedTick();
+        physicsFrameMs += std::chrono::duration<double, std::milli>(PhysicsClock::now() - physicsFrameStart).count();
+
+        // --- Input recording / replay ---
+        // F6 starts/stops recording, F7 replays the last recording from its
+        // scene snapshot. Both hotkeys read live input, before a replayed
+        // frame replaces it.
+        bool toggleRecording = !ImGui::GetIO().WantCaptureKeyboard && Input::GetKeyPressed(GLFW_KEY_F6);
+        bool toggleReplay = !ImGui::GetIO().WantCaptureKeyboard && Input::GetKeyPressed(GLFW_KEY_F7);
+
+        if (toggleRecording && !InputReplay::IsReplaying())
+        {
+            if (InputReplay::IsRecording())
+            {
+                InputReplay::StopRecording();
+            }
+            else
+            {
+                InputReplay::SessionHeader header;
+                header.fixedDt = fixedDt;
+                header.pipelinedPhysics = pipelinedPhysics;
+                header.mode = engineMode;
+                header.cameraPosition = camera.getPosition();
+                header.cameraYaw = camera.getYaw();
+                header.cameraPitch = camera.getPitch();
+                header.scenePath = inputRecordingPath + ".scene.json";
+
+                scene.setLightState(renderer.getLight().getDirection(),
+                    renderer.getLight().getColor(),
+                    renderer.getLight().getIntensity());
+
+                // Ticks are counted from an empty accumulator so replay lines up from frame one.
+                // Body motion is saved too, otherwise a Game-mode recording replays from rest
+                if (scene.saveToFile(header.scenePath, true) && InputReplay::StartRecording(inputRecordingPath, header))
+                    accumulator = 0.0;
+            }
+        }
+
+        if (toggleReplay && !InputReplay::IsRecording())
+        {
+            if (InputReplay::IsReplaying())
+            {
+                InputReplay::StopReplay();
+                Input::ResetState();
+            }
+            else
+            {
+                InputReplay::SessionHeader header;
+                if (InputReplay::StartReplay(inputRecordingPath, header))
+                {
+                    selectedObjects.clear(); // Objects are recreated by the load below
+                    selectedTrigger = nullptr;
+                    selectedForceGenerator = nullptr;
+                    selectedPointLight = nullptr;
+                    PointLightRegistry::getInstance().clearAll();
+
+                    if (header.fixedDt != fixedDt)
+                        std::cerr << "[InputReplay] Recorded with a different physics tick rate, results won't match" << std::endl;
+
+                    if (scene.loadFromFile(header.scenePath))
+                    {
+                        glm::vec3 dir, col;
+                        float intensity;
+                        scene.getLightState(dir, col, intensity);
+                        renderer.getLight().setDirection(dir);
+                        renderer.getLight().setColor(col);
+                        renderer.getLight().setIntensity(intensity);
+                        SetupScripts(scene, camera, physics);
+                        scene.applyTagScriptsToExistingObjects();
+                        scene.applyTriggerScriptsToExistingTriggers();
+
+                        camera.setPosition(header.cameraPosition);
+                        camera.setYaw(header.cameraYaw);
+                        camera.setPitch(header.cameraPitch);
+
+                        engineMode = header.mode;
+                        pipelinedPhysics = header.pipelinedPhysics;
+                        glfwSetInputMode(window, GLFW_CURSOR,
+                            engineMode == EngineMode::Game ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+                        Input::SetCameraController(engineMode == EngineMode::Editor ? &cameraController : nullptr);
+
+                        accumulator = 0.0;
+                        replayStartTime = std::chrono::steady_clock::now();
+                    }
+                    else
+                    {
+                        InputReplay::StopReplay();
+                    }
+                }
+            }
+        }
+
+        // Drive this frame from the recording: same frame time, same input, same tick count
+        InputReplay::Frame replayFrame;
+        bool wasReplaying = InputReplay::IsReplaying();
+        bool replayingFrame = wasReplaying && InputReplay::NextFrame(replayFrame);
+        if (replayingFrame)
+        {
+            Time::OverrideDeltaTime(replayFrame.deltaTime);
+            deltaTime = replayFrame.deltaTime;
+            Input::ApplyState(replayFrame.input);
+        }
+        else if (wasReplaying)
+        {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - replayStartTime).count();
+            uint32_t frames = InputReplay::GetFrameIndex();
+            std::cout << "[InputReplay] Finished: " << frames << " frames in " << seconds << " s ("
+                << (frames > 0 ? seconds * 1000.0 / frames : 0.0) << " ms/frame)" << std::endl;
+            Input::ResetState();
+        }
+
         // Toggle between Editor and Game modes.
         // Editor mode:
         //  - Mouse cursor is visible
@@ -350,6 +959,30 @@ int Start(void)
                     obj->getRigidBody()->activate(true);
                 }
             }
+
+            // Spawning and the first second of settling aren't steady state
+            AllocationTracker::resetBudgetStats(60);
+        }
+
+        // Start a benchmark picked in the Test panel.
+        // Windowed runs use the engine's own tick rate, the scenario's fixedDt only applies headless.
+        std::string benchmarkPath;
+        if (engineMode == EngineMode::Test && testUI.consumeBenchmarkRequest(benchmarkPath))
+        {
+            BenchmarkScenario scenario;
+            if (BenchmarkScenario::loadFromFile(benchmarkPath, scenario))
+            {
+                selectedObjects.clear();
+                selectedTrigger = nullptr;
+                selectedForceGenerator = nullptr;
+                selectedPointLight = nullptr;
+
+                if (scenario.populate(scene))
+                {
+                    accumulator = 0.0;
+                    benchmarkRecorder.begin(scenario, "windowed");
+                }
+            }
         }
 
         if (engineMode == EngineMode::Test)
@@ -367,7 +1000,7 @@ int Start(void)
                         activeCount++;
                 }
 
-                std::cout << "Active bodies: " << activeCount << std::endl;
+                LOG_DEBUG(LogCategory::Physics, "Active bodies: " << activeCount);
 
                 debugTimer = 0.0f;
             }
@@ -378,6 +1011,12 @@ int Start(void)
             std::cout << "Debug Physics Wireframes: " << (renderer.isDebugPhysicsEnabled() ? "ON" : "OFF") << std::endl;
         }
 
+        if (!ImGui::GetIO().WantCaptureKeyboard && Input::GetKeyPressed(GLFW_KEY_P))  // 'P' for Pipelined
+        {
+            pipelinedPhysics = !pipelinedPhysics;
+            std::cout << "Pipelined Physics: " << (pipelinedPhysics ? "ON" : "OFF") << std::endl;
+        }
+
         if (!ImGui::GetIO().WantCaptureKeyboard &&  Input::GetKeyPressed(GLFW_KEY_F5))
         {
             // Save current scene to file (overwrites existing)
@@ -412,16 +1051,51 @@ int Start(void)
         // --- Fixed timestep updates ---
         // ====================
         // Run physics updates in fixed 1/60s steps until caught up with real time
+        physicsFrameStart = PhysicsClock::now();
+
+        // The replayed session only holds up while the mode matches the recording
+        // (a UI panel holding keyboard focus can swallow a mode hotkey)
+        if (replayingFrame && engineMode != replayFrame.mode)
+        {
+            std::cerr << "[InputReplay] Desync at frame " << InputReplay::GetFrameIndex()
+                << ": engine mode differs from the recording, stopping replay" << std::endl;
+            InputReplay::StopReplay();
+            Input::ResetState();
+            replayingFrame = false;
+        }
+
+        int fixedTicks = 0;
         if (engineMode == EngineMode::Game || engineMode == EngineMode::Test)
         {
+            PROFILE_SCOPE("FixedUpdate");
             while (accumulator >= fixedDt)
             {
-                physics.update(fixedDt); // advance simulation by one fixed step
-				TriggerRegistry::getInstance().update(fixedDt); // Update triggers with fixed timestep
-                ForceGeneratorRegistry::getInstance().update(fixedDt);
-
+                fixedTicks++;
                 accumulator -= fixedDt; // remove one step’s worth of time from the bucket
-                physicsSteps++; // count how many physics updates ran this second
+            }
+
+            // A replay runs exactly the recorded ticks
+            if (replayingFrame)
+                fixedTicks = replayFrame.fixedTicks;
+
+            // Pipelined: every tick but the last runs here, the last one steps on
+            // the worker during render. Never more than one tick per kick, so each
+            // tick still gets its own fixed update, triggers, forces and pose.
+            int serialTicks = pipelinedPhysics ? fixedTicks - 1 : fixedTicks;
+
+            // Layer matrix edits from the editor, applied while no step is running
+            if (fixedTicks > 0)
+                physics.applyCollisionLayerChanges();
+            for (int tick = 0; tick < serialTicks; tick++)
+            {
+                scene.fixedUpdate(); // onFixedUpdate scripts, once per tick before its step
+                physics.stepWorld(1, static_cast<float>(fixedDt)); // advance simulation by one fixed step
+                finishFixedTick();
+            }
+            if (pipelinedPhysics && fixedTicks > 0)
+            {
+                scene.fixedUpdate();
+                pipelinedTickPending = true;
             }
         }
         else if (engineMode == EngineMode::Editor || engineMode == EngineMode::Test)
@@ -429,7 +1103,17 @@ int Start(void)
             // In editor and test mode, discard accumulator so physics doesn't "catch up"
             accumulator = 0.0;
         }
-        scene.update(engineMode);
+        physicsFrameMs += std::chrono::duration<double, std::milli>(PhysicsClock::now() - physicsFrameStart).count();
+
+        if (InputReplay::IsRecording())
+            InputReplay::RecordFrame(deltaTime, fixedTicks, engineMode);
+
+        // Fraction of the next tick already elapsed, the renderer blends by this much
+        interpolationAlpha = static_cast<float>(accumulator / fixedDt);
+        scene.updateObjects(engineMode);
+
+        // Interpolation, spatial grid and registry views (graph built before the loop)
+        frameGraph.execute(threadPool);
 
         if (engineMode == EngineMode::Editor &&
             !selectedObjects.empty() &&
@@ -470,7 +1154,7 @@ int Start(void)
 
         if (physicsTime >= 1.0)
         {
-            std::cout << "Physics steps per second: " << physicsSteps << std::endl;
+            LOG_DEBUG(LogCategory::Physics, "Physics steps per second: " << physicsSteps);
             physicsTime = 0.0;
             physicsSteps = 0;
         }
@@ -854,11 +1538,6 @@ int Start(void)
 
         }
 
-        // Build Debug UI Context
-        // This packages up read-only engine data and approved debug commands
-        // so DebugUI can display stats and issue requests without owning systems.
-        DebugUIContext uiContext;
-
         // Pass editor selection into the UI so Inspector can display it.
         // DebugUI does not decide selection — it only reacts to it.
         uiContext.selectedObject = primarySelection;
@@ -866,311 +1545,55 @@ int Start(void)
         // Timing / performance data
         uiContext.time.deltaTime = Time::GetDeltaTime();
         uiContext.time.fps = Time::GetFPS();
-
-        // Physics debug data
-        uiContext.physics.rigidBodyCount = physics.getRigidBodyCount();
+        uiContext.time.frameTimeP50 = Time::GetFrameTimeP50();
+        uiContext.time.frameTimeP95 = Time::GetFrameTimeP95();
+        uiContext.time.frameTimeP99 = Time::GetFrameTimeP99();
+        uiContext.time.jitterHistogram = Time::GetJitterHistogram();
+        uiContext.time.jitterBinCount = Time::JitterBinCount;
+        uiContext.time.jitterBinWidthMs = Time::JitterBinWidthMs;
+        uiContext.time.spinMarginMs = Time::GetSpinMargin() * 1000.0f;
+        uiContext.time.lastSpinMs = Time::GetLastSpinTime() * 1000.0f;
+
+        // Physics debug data (body count and materials are filled by the frame graph)
         uiContext.physics.physicsEnabled = true;
-
-        // Populate available materials from the registry
-        uiContext.physics.availableMaterials = MaterialRegistry::getInstance().getAllMaterialNames();
+        uiContext.physics.tickRate = static_cast<float>(physicsTickRate);
+        uiContext.physics.interpolationAlpha = interpolationAlpha;
+        uiContext.physics.pipelined = pipelinedPhysics;
+        uiContext.physics.multithreaded = physics.isMultithreaded();
+        uiContext.physics.solverThreads = physics.getSolverThreadCount();
+        uiContext.physics.maxSolverThreads = physics.getMaxSolverThreadCount();
+
+        // Heap allocation data (last completed frame)
+        uiContext.memory.trackingCompiledIn = AllocationTracker::isCompiledIn();
+        uiContext.memory.allocationsPerFrame = static_cast<int>(AllocationTracker::getFrameAllocations());
+        uiContext.memory.freesPerFrame = static_cast<int>(AllocationTracker::getFrameFrees());
+        uiContext.memory.kilobytesPerFrame = AllocationTracker::getFrameBytes() / 1024.0f;
+        uiContext.memory.peakAllocationsPerFrame = static_cast<int>(AllocationTracker::getPeakFrameAllocations());
+        uiContext.memory.allocationBudget = static_cast<int>(AllocationTracker::getFrameBudget());
+        uiContext.memory.framesOverBudget = static_cast<int>(AllocationTracker::getFramesOverBudget());
         
-        // generic spawn function
-        uiContext.scene.spawnObject =
-            [&scene](ShapeType type, const glm::vec3& position,
-                const glm::vec3& size, float mass,
-                const std::string& materialName,
-                const std::string& texturePath,
-                const std::string& specularPath)  // ADD THIS
-            {
-                return scene.spawnObject(type, position, size, mass, materialName, texturePath, specularPath);
-            };
-
-        // Spawn for objects without physics
-        uiContext.scene.spawnRenderObject =
-            [&scene](ShapeType type, const glm::vec3& pos, const glm::vec3& size,
-                const std::string& tex, const std::string& specularPath)  // ADD THIS
-            {
-                return scene.spawnRenderObject(type, pos, size, tex, specularPath);
-            };
-
-        // Register custom material command
-        uiContext.scene.registerMaterial =
-            [](const std::string& name, float friction, float restitution)
-            {
-                PhysicsMaterial customMat(name, friction, restitution);
-                MaterialRegistry::getInstance().registerMaterial(customMat);
-            };
-		// Set object scale command (handles both render and physics resizing)
-        uiContext.scene.setObjectScale =
-            [&scene](GameObject* obj, const glm::vec3& scale) {
-            scene.setObjectScale(obj, scale);
-            };
-
-        // Destroy object (deferred, editor-safe)
-        uiContext.scene.destroyObject =
-            [&scene, &selectedObjects](GameObject* obj)
-            {
-                if (!obj) return;
-
-                // Remove from selection list if present
-                selectedObjects.erase(
-                    std::remove(selectedObjects.begin(), selectedObjects.end(), obj),
-                    selectedObjects.end()
-                );
-
-                scene.requestDestroy(obj);
-            };
-
+        {
+            PROFILE_SCOPE("UI::draw");
 
-        // Get available textures command
-        uiContext.scene.getAvailableTextures =
-            []() -> std::vector<std::string>
+            // Draw Debug UI (logic only) and TestUI
+            if (engineMode == EngineMode::Editor)
             {
-                return FileUtils::getTextureFiles("textures");
-            };
-
-		// Lighting commands
-        uiContext.lighting.getLight = [&renderer]() -> DirectionalLight& {
-            return renderer.getLight();
-            };
-
-        // Get available models command
-        uiContext.scene.getAvailableModels =
-            []() -> std::vector<std::string> {
-            return FileUtils::getModelFiles("models");
-            };
-
-        // Model loading command
-        uiContext.scene.loadAndSpawnModel =
-            [&scene](const std::string& filepath, const glm::vec3& pos, const glm::vec3& meshScale,
-                bool enablePhysics,
-                float mass,
-                const glm::vec3& physicsBoxScale,
-                const std::string& materialName) -> GameObject* {
-            return scene.loadAndSpawnModel(filepath, pos, meshScale, enablePhysics, mass, physicsBoxScale, materialName);
-            };
-
-        uiContext.scene.setObjectPhysicsScale = [&scene](GameObject* obj, const glm::vec3& scale) {
-            scene.setObjectPhysicsScale(obj, scale);
-            };
-        // ===== Constraint System Commands =====
-        auto& registry = ConstraintRegistry::getInstance();
-
-        // Update constraint view state
-        uiContext.constraints.totalConstraints = registry.getConstraintCount();
-        uiContext.constraints.allConstraints = registry.getAllConstraints();
-
-        // Count active/broken
-        uiContext.constraints.activeConstraints = 0;
-        uiContext.constraints.brokenConstraints = 0;
-        for (Constraint* c : uiContext.constraints.allConstraints) {
-            if (c->isBroken()) {
-                uiContext.constraints.brokenConstraints++;
-            }
-            else {
-                uiContext.constraints.activeConstraints++;
-            }
-        }
-
-        // Count by type
-        uiContext.constraints.fixedCount = registry.findConstraintsByType(ConstraintType::FIXED).size();
-        uiContext.constraints.hingeCount = registry.findConstraintsByType(ConstraintType::HINGE).size();
-        uiContext.constraints.sliderCount = registry.findConstraintsByType(ConstraintType::SLIDER).size();
-        uiContext.constraints.springCount = registry.findConstraintsByType(ConstraintType::SPRING).size();
-        uiContext.constraints.dof6Count = registry.findConstraintsByType(ConstraintType::GENERIC_6DOF).size();
-
-        // === Creation Commands ===
-
-        uiContext.constraintCommands.createFixed =
-            [&registry](GameObject* objA, GameObject* objB) -> Constraint* {
-            auto constraint = ConstraintPreset::createFixed(objA, objB);
-            return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        uiContext.constraintCommands.createHinge =
-            [&registry](GameObject* objA, GameObject* objB,
-                const glm::vec3& worldPivot, const glm::vec3& worldAxis) -> Constraint* {
-                    auto constraint = ConstraintPreset::createHinge(objA, objB, worldPivot, worldAxis);
-                    return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        uiContext.constraintCommands.createHingeAdvanced =
-            [&registry](GameObject* objA, GameObject* objB, const HingeParams& params) -> Constraint* {
-            auto constraint = ConstraintPreset::createHinge(objA, objB, params);
-            return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        uiContext.constraintCommands.createSlider =
-            [&registry](GameObject* objA, GameObject* objB, const SliderParams& params) -> Constraint* {
-            auto constraint = ConstraintPreset::createSlider(objA, objB, params);
-            return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        uiContext.constraintCommands.createSpring =
-            [&registry](GameObject* objA, GameObject* objB, float stiffness, float damping) -> Constraint* {
-            auto constraint = ConstraintPreset::createSpring(objA, objB, stiffness, damping);
-            return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        uiContext.constraintCommands.createSpringAdvanced =
-            [&registry](GameObject* objA, GameObject* objB, const SpringParams& params) -> Constraint* {
-            auto constraint = ConstraintPreset::createSpring(objA, objB, params);
-            return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        uiContext.constraintCommands.createGeneric6Dof =
-            [&registry](GameObject* objA, GameObject* objB, const Generic6DofParams& params) -> Constraint* {
-            auto constraint = ConstraintPreset::createGeneric6Dof(objA, objB, params);
-            return constraint ? registry.addConstraint(std::move(constraint)) : nullptr;
-            };
-
-        // === Management Commands ===
-
-        uiContext.constraintCommands.removeConstraint =
-            [&registry](Constraint* constraint) {
-            registry.removeConstraint(constraint);
-            };
-
-        uiContext.constraintCommands.removeConstraintByName =
-            [&registry](const std::string& name) -> bool {
-            return registry.removeConstraint(name);
-            };
-
-        uiContext.constraintCommands.removeConstraintsForObject =
-            [&registry](GameObject* obj) {
-            registry.removeConstraintsForObject(obj);
-            };
-
-        uiContext.constraintCommands.clearAllConstraints =
-            [&registry]() {
-            registry.clearAll();
-            };
-
-        // === Query Commands ===
-
-        uiContext.constraintCommands.findConstraintByName =
-            [&registry](const std::string& name) -> Constraint* {
-            return registry.findConstraintByName(name);
-            };
-
-        uiContext.constraintCommands.findConstraintsForObject =
-            [&registry](GameObject* obj) -> std::vector<Constraint*> {
-            return registry.findConstraintsByObject(obj);
-            };
-
-        uiContext.constraintCommands.findConstraintsByType =
-            [&registry](ConstraintType type) -> std::vector<Constraint*> {
-            return registry.findConstraintsByType(type);
-            };
-        // ===== Trigger System Commands ===== (ADD THIS ENTIRE SECTION)
-        auto& triggerRegistry = TriggerRegistry::getInstance();
-
-        // Update trigger view state
-        uiContext.triggers.totalTriggers = triggerRegistry.getTriggerCount();
-        uiContext.triggers.allTriggers = triggerRegistry.getAllTriggers();
-
-        // Count enabled/disabled
-        uiContext.triggers.enabledTriggers = 0;
-        uiContext.triggers.disabledTriggers = 0;
-        for (Trigger* t : uiContext.triggers.allTriggers) {
-            if (t->isEnabled()) {
-                uiContext.triggers.enabledTriggers++;
+                debugUI.draw(uiContext);
             }
-            else {
-                uiContext.triggers.disabledTriggers++;
+            else if (engineMode == EngineMode::Test)
+            {
+                testUI.draw(benchmarkRecorder);
             }
-        }
 
-        // Count by type
-        uiContext.triggers.teleportCount = triggerRegistry.findTriggersByType(TriggerType::TELEPORT).size();
-        uiContext.triggers.speedZoneCount = triggerRegistry.findTriggersByType(TriggerType::SPEED_ZONE).size();
-        uiContext.triggers.customCount = triggerRegistry.findTriggersByType(TriggerType::EVENT).size();
-
-        // === Creation Commands ===
-        uiContext.triggerCommands.createTrigger =
-            [&triggerRegistry](const std::string& name, TriggerType type,
-                const glm::vec3& position, const glm::vec3& size) -> Trigger* {
-                    return triggerRegistry.createTrigger(name, type, position, size);
-            };
-
-        // === Management Commands ===
-        uiContext.triggerCommands.removeTrigger =
-            [&triggerRegistry](Trigger* trigger) {
-            triggerRegistry.removeTrigger(trigger);
-            };
-
-        uiContext.triggerCommands.removeTriggerByName =
-            [&triggerRegistry](const std::string& name) -> bool {
-            return triggerRegistry.removeTrigger(name);
-            };
-
-        uiContext.triggerCommands.clearAllTriggers =
-            [&triggerRegistry]() {
-            triggerRegistry.clearAll();
-            };
-
-        // === Query Commands ===
-        uiContext.triggerCommands.findTriggerByName =
-            [&triggerRegistry](const std::string& name) -> Trigger* {
-            return triggerRegistry.findTriggerByName(name);
-            };
-
-        uiContext.triggerCommands.findTriggersByType =
-            [&triggerRegistry](TriggerType type) -> std::vector<Trigger*> {
-            return triggerRegistry.findTriggersByType(type);
-            };
-
-        uiContext.triggerCommands.findTriggersContainingObject =
-            [&triggerRegistry](GameObject* obj) -> std::vector<Trigger*> {
-            return triggerRegistry.findTriggersContainingObject(obj);
-            };
-
-        // === Type-Specific Commands ===
-        uiContext.triggerCommands.setTeleportDestination =
-            [](Trigger* trigger, const glm::vec3& dest) {
-            if (trigger) trigger->setTeleportDestination(dest);
-            };
-
-        uiContext.triggerCommands.setForce =
-            [](Trigger* trigger, const glm::vec3& direction, float magnitude) {
-            if (trigger) trigger->setForce(direction, magnitude);
-            };
-        uiContext.triggerCommands.updateTriggerPosition =
-            [](Trigger* trigger, const glm::vec3& position) {
-            if (trigger) trigger->setPosition(position);
-            };
-
-        uiContext.triggerCommands.updateTriggerSize =
-            [](Trigger* trigger, const glm::vec3& size) {
-            if (trigger) trigger->setSize(size);
-            };
-
-        uiContext.triggerCommands.setTriggerEnabled =
-            [](Trigger* trigger, bool enabled) {
-            if (trigger) trigger->setEnabled(enabled);
-            };
-        uiContext.applyTriggerScripts = [&scene]() {
-            scene.applyTriggerScriptsToExistingTriggers();
-            };
-
-        // Draw Debug UI (logic only) and TestUI
-        if (engineMode == EngineMode::Editor)
-        {
-            debugUI.draw(uiContext);
-        }
-        else if (engineMode == EngineMode::Test)
-        {
-            testUI.draw();
+            // Draw SceneSavePanel
+            DrawSceneSaveLoadPanel(scene, engineMode, renderer.getLight(), [&](){
+                selectedObjects.clear();
+                selectedTrigger = nullptr;
+                selectedForceGenerator = nullptr;
+                selectedPointLight = nullptr;
+             });
         }
 
-        // Draw SceneSavePanel
-        DrawSceneSaveLoadPanel(scene, engineMode, renderer.getLight(), [&](){
-            selectedObjects.clear();
-            selectedTrigger = nullptr;
-            selectedForceGenerator = nullptr;
-            selectedPointLight = nullptr;
-         });
-
         // Mode change fade timer
         if (modeDisplayTimer > 0.0f)
         {
@@ -1206,24 +1629,72 @@ int Start(void)
         }
 
         // End ImGui frame
-        ImGui::Render();
+        {
+            PROFILE_SCOPE("ImGui::Render");
+            ImGui::Render();
+        }
+
+        // --- Publish render snapshot ---
+        // Selection highlight is editor-only
+        bool showSelection = engineMode == EngineMode::Editor;
+        RenderSnapshot& snapshot = renderSnapshots.beginWrite();
+        scene.buildRenderSnapshot(snapshot,
+            showSelection ? primarySelection : nullptr,
+            showSelection ? selectedObjects : noSelection);
+        renderSnapshots.publish();
+
+        // Last point the main thread touches physics this frame:
+        // let the worker step while we render
+        if (pipelinedTickPending)
+        {
+            physicsStepThread.kick(1, static_cast<float>(fixedDt));
+            pipelinedTickPending = false;
+        }
 
         // --- Render ---
-        if (engineMode == EngineMode::Editor)
+        // Everything below reads the snapshot only, the world may be mid-step
+        const RenderSnapshot& frontSnapshot = renderSnapshots.getFront();
+        renderer.draw(fbW, fbH, camera, frontSnapshot);
         {
-            renderer.draw(fbW, fbH, camera, scene.getObjects(), primarySelection, selectedObjects);
+            PROFILE_SCOPE("Renderer::debugDraws");
+            renderer.drawTriggerDebug(frontSnapshot, camera, fbW, fbH);
+            renderer.drawForceGeneratorDebug(frontSnapshot, camera, fbW, fbH);
+            renderer.drawPointLightDebug(frontSnapshot, camera, fbW, fbH);
+            renderer.uploadPointLights(frontSnapshot);
         }
-        else
+
         {
-            renderer.draw(fbW, fbH, camera, scene.getObjects(), nullptr, {});
+            PROFILE_SCOPE("ImGui::RenderDrawData");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         }
-        renderer.drawTriggerDebug(TriggerRegistry::getInstance().getAllTriggers(), camera, fbW, fbH);
-        renderer.drawForceGeneratorDebug(ForceGeneratorRegistry::getInstance().getAllGenerators(), camera, fbW, fbH);
-        renderer.drawPointLightDebug(PointLightRegistry::getInstance().getAllLights(), camera, fbW, fbH);
-        renderer.uploadPointLights(PointLightRegistry::getInstance().getAllLights());
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(window);
+        }
+        if (!startupTimeline.hasFirstFrame())
+            startupTimeline.markFirstFrame();
+
+        // Frame time excludes the FPS limiter sleep below
+        Profiler::getInstance().endFrame();
+        AllocationTracker::endFrame();
 
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        glfwSwapBuffers(window);
+        // Benchmark sample for this frame, results are written when the run completes
+        if (benchmarkRecorder.isRunning())
+        {
+            if (engineMode != EngineMode::Test)
+            {
+                std::cout << "[Benchmark] Cancelled (left Test mode)" << std::endl;
+                benchmarkRecorder.cancel();
+            }
+            else if (benchmarkRecorder.addFrame(deltaTime * 1000.0, physicsFrameMs))
+            {
+                BenchmarkResult result = benchmarkRecorder.finish(physics.getRigidBodyCount());
+                result.physicsThreads = physics.getSolverThreadCount();
+                result.print();
+                result.writeToFile("benchmark_results/" + result.scenario + "_windowed.json");
+                result.writeToFile("benchmark_results/results.csv");
+            }
+        }
 
 		//limit FPS if enabled
         Time::WaitForNextFrame();
@@ -1231,6 +1702,14 @@ int Start(void)
 
     std::cout << "Exiting..." << std::endl;
 
+    // Close the log so its frame/tick counts are written
+    InputReplay::StopRecording();
+    InputReplay::StopReplay();
+
+    // Don't tear physics down under a running step
+    physicsStepThread.wait();
+    threadPool.shutdown();
+
     // ImGui shutdown
     ConstraintTemplateRegistry::getInstance().save();
     ImGui_ImplOpenGL3_Shutdown();
@@ -1240,5 +1719,6 @@ int Start(void)
     renderer.cleanup();
     physics.cleanup();
     glfwTerminate();
+    Log::shutdown();
     return 0;
 }
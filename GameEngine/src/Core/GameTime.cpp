@@ -1,8 +1,15 @@
 #include <chrono>
 #include <thread>
 #include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
 #include "../include/Core/GameTime.h"
 
+#ifdef __linux__
+#include <time.h>
+#endif
+
 // GameTime comment test for including in project
 
 
@@ -17,6 +24,28 @@ float Time::fpsUpdateTimer = 0.0f;
 bool Time::fpsLimitEnabled = false;
 float Time::targetFrameTime = 0.0f;
 
+Time::TimePoint Time::nextFrameDeadline;
+bool Time::deadlineValid = false;
+float Time::spinMargin = 0.0005f;
+float Time::lastOversleep = 0.0f;
+float Time::lastSpinTime = 0.0f;
+
+float Time::frameTimeHistory[Time::FrameHistorySize] = {};
+int Time::jitterBinHistory[Time::FrameHistorySize] = {};
+int Time::frameHistoryIndex = 0;
+int Time::frameHistoryCount = 0;
+int Time::jitterHistogram[Time::JitterBinCount] = {};
+float Time::frameTimeP50 = 0.0f;
+float Time::frameTimeP95 = 0.0f;
+float Time::frameTimeP99 = 0.0f;
+
+namespace {
+    //Spin tail bounds: long enough to absorb scheduler wake-up latency,
+    //short enough that many instances per host don't each hold a core
+    const float MinSpinMargin = 0.0001f; //0.1ms
+    const float MaxSpinMargin = 0.002f;  //2ms
+}
+
 void Time::Initialize() {
     startTime = Clock::now();
     lastFrameTime = startTime;
@@ -25,6 +54,7 @@ void Time::Initialize() {
     frameCount = 0;
     fps = 0.0f;
     fpsUpdateTimer = 0.0f;
+    deadlineValid = false;
 }
 
 void Time::Update() {
@@ -37,6 +67,9 @@ void Time::Update() {
     //convert duration to seconds(float)
     deltaTime = frameDuration.count();
 
+    //record the real frame time (before the cap) for the pacing stats
+    RecordFrameTime(deltaTime * 1000.0f);
+
     // Cap delta time to prevent spiral of death (max 0.25s = 4 FPS minimum)
     //prevents physics from doing to much catch up
     if (deltaTime > 0.25f) {
@@ -62,6 +95,9 @@ void Time::Update() {
         //reset counters for the next second
         frameCount = 0;
         fpsUpdateTimer = 0.0f;
+
+        //percentiles need a sort, so only refresh them with the fps counter
+        UpdateFramePercentiles();
     }
 
     //store time last frame started for next delta calc
@@ -84,27 +120,108 @@ void Time::SetTargetFPS(float targetFPS) {
 
 void Time::WaitForNextFrame() {
     //check if  fps limit is on to decide if next frame should wait or not
-    if (!fpsLimitEnabled)
+    if (!fpsLimitEnabled) {
+        deadlineValid = false;
+        lastSpinTime = 0.0f;
         return;
-    while (true) {
-        //calculate how long this frame took
-        TimePoint now = Clock::now();
-        std::chrono::duration<float> frameDuration = now - lastFrameTime;
-        float actualFrameTime = frameDuration.count();
-
-        // If frame finished early
-        //calculate how long until next frame 
-        float remainingTime = targetFrameTime - actualFrameTime;
-
-        if (remainingTime <= 0.0f) {
-            break; // Target time reached
+    }
+
+    Clock::duration targetDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(targetFrameTime));
+    TimePoint now = Clock::now();
+
+    //Deadlines are absolute (previous deadline + target), so small overruns
+    //are paid back next frame instead of drifting the frame rate
+    if (!deadlineValid) {
+        nextFrameDeadline = lastFrameTime + targetDuration;
+        deadlineValid = true;
+    }
+
+    //More than a whole frame late (hitch, breakpoint, load): restart the
+    //schedule from now rather than running frames back to back to catch up
+    if (now - nextFrameDeadline > targetDuration) {
+        nextFrameDeadline = now;
+    }
+
+    lastSpinTime = 0.0f;
+    if (now < nextFrameDeadline) {
+        //Sleep until just before the deadline...
+        TimePoint wakeTime = nextFrameDeadline - std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float>(spinMargin));
+        if (now < wakeTime) {
+            SleepUntil(wakeTime);
+
+            //adapt the spin margin to how late the OS actually woke us
+            lastOversleep = std::max(0.0f, std::chrono::duration<float>(Clock::now() - wakeTime).count());
+            if (lastOversleep > spinMargin)
+                spinMargin = std::min(lastOversleep * 1.5f, MaxSpinMargin); //woke too late, widen quickly
+            else
+                spinMargin = std::max(MinSpinMargin, spinMargin * 0.98f + lastOversleep * 1.5f * 0.02f); //narrow slowly
         }
 
-        // If significant time remains, sleep
-        if (remainingTime > 0.001f) {// More than 1ms left
-            float sleepTime = remainingTime * 0.001f;// Leave 1ms for spin-lock
-            std::this_thread::sleep_for(std::chrono::duration<float>(sleepTime));
+        //...then a short spin for the last fraction of a millisecond.
+        //yield() lets other processes on the core run while we wait
+        TimePoint spinStart = Clock::now();
+        while (Clock::now() < nextFrameDeadline) {
+            std::this_thread::yield();
         }
-        //otherwise spin lock for precise timing
+        lastSpinTime = std::chrono::duration<float>(Clock::now() - spinStart).count();
+    }
+
+    nextFrameDeadline += targetDuration;
+}
+
+void Time::SleepUntil(TimePoint wakeTime) {
+#ifdef __linux__
+    //steady_clock is CLOCK_MONOTONIC on Linux (libstdc++ and libc++), so the time point converts directly.
+    //TIMER_ABSTIME means an interrupted or late call can't add up extra delay
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeTime.time_since_epoch()).count();
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(sinceEpoch % 1000000000LL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    //Windows and macOS have no clock_nanosleep, the spin margin absorbs the extra wake latency
+    std::this_thread::sleep_until(wakeTime);
+#endif
+}
+
+void Time::RecordFrameTime(float frameTimeMs) {
+    //jitter is measured against the limiter target, or the typical frame when unlimited
+    float referenceMs = fpsLimitEnabled ? targetFrameTime * 1000.0f : frameTimeP50;
+    int bin = static_cast<int>(std::floor((frameTimeMs - referenceMs) / JitterBinWidthMs + 0.5f)) + JitterBinCount / 2;
+    bin = std::clamp(bin, 0, JitterBinCount - 1);
+
+    //ring buffer: drop the oldest sample from the histogram before overwriting it
+    if (frameHistoryCount == FrameHistorySize) {
+        jitterHistogram[jitterBinHistory[frameHistoryIndex]]--;
+    }
+    else {
+        frameHistoryCount++;
     }
-}
\ No newline at end of file
+
+    frameTimeHistory[frameHistoryIndex] = frameTimeMs;
+    jitterBinHistory[frameHistoryIndex] = bin;
+    jitterHistogram[bin]++;
+    frameHistoryIndex = (frameHistoryIndex + 1) % FrameHistorySize;
+}
+
+void Time::UpdateFramePercentiles() {
+    if (frameHistoryCount == 0)
+        return;
+
+    //sort a copy so the ring buffer order is kept
+    static float sorted[FrameHistorySize];
+    std::copy(frameTimeHistory, frameTimeHistory + frameHistoryCount, sorted);
+
+    auto percentile = [](int count, float p) {
+        int index = std::min(count - 1, static_cast<int>(p * (count - 1) + 0.5f));
+        std::nth_element(sorted, sorted + index, sorted + count);
+        return sorted[index];
+    };
+
+    frameTimeP50 = percentile(frameHistoryCount, 0.50f);
+    frameTimeP95 = percentile(frameHistoryCount, 0.95f);
+    frameTimeP99 = percentile(frameHistoryCount, 0.99f);
+}
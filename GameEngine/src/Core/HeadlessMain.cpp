@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include "../include/Core/HeadlessRunner.h"
+#include "../include/Core/SpatialGridBenchmark.h"
+#include "../include/Core/Log.h"
+
+// Entry point for the HeadlessSim target.
+// Usage: HeadlessSim [scene.json] [--ticks N] [--warmup N] [--dt seconds] [--cubes N] [--alloc-budget N]
+//                    [--scenario benchmark.json] [--out results.csv|results.json]
+//                    [--log-level debug|info|warn|error|off]
+//                    [--physics-threads N] [--thread-sweep [maxThreads]]
+//                    [--spatial-bench [objects]]
+//                    [--spatial-index grid|octree|aabbtree] [--spatial-queries N] [--spatial-sweep [queries]]
+// With no scene path the Test mode cube stack is simulated.
+// A scenario (assets/benchmarks) replaces the scene path and tick settings.
+// --physics-threads / --thread-sweep need the ENGINE_BULLET_MT build, e.g.
+//   HeadlessSim --scenario assets/benchmarks/cube_stack_750.json --thread-sweep --out benchmark_results/thread_scaling.csv
+// --spatial-bench runs the SpatialGrid micro-benchmark instead of a simulation (no physics).
+// --spatial-sweep runs the scenario with each spatial index backend and compares them, e.g.
+//   HeadlessSim --scenario assets/benchmarks/maze_scene.json --spatial-sweep
+int main(int argc, char** argv)
+{
+    HeadlessConfig config;
+    bool threadSweep = false;
+    int sweepMaxThreads = 0;
+    bool spatialBench = false;
+    bool spatialSweep = false;
+    SpatialBenchConfig spatialConfig;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--ticks" && hasValue)
+            config.ticks = std::atoi(argv[++i]);
+        else if (arg == "--warmup" && hasValue)
+            config.warmupTicks = std::atoi(argv[++i]);
+        else if (arg == "--dt" && hasValue)
+            config.fixedDt = std::atof(argv[++i]);
+        else if (arg == "--cubes" && hasValue)
+            config.stackCubeCount = std::atoi(argv[++i]);
+        else if (arg == "--alloc-budget" && hasValue)
+            config.allocationBudget = std::atoi(argv[++i]);
+        else if (arg == "--scenario" && hasValue)
+            config.scenarioPath = argv[++i];
+        else if (arg == "--out" && hasValue)
+            config.outputPath = argv[++i];
+        else if (arg == "--physics-threads" && hasValue)
+            config.physicsThreads = std::atoi(argv[++i]);
+        else if (arg == "--thread-sweep")
+        {
+            threadSweep = true;
+            if (hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                sweepMaxThreads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--spatial-bench")
+        {
+            spatialBench = true;
+            if (hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                spatialConfig.objectCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--spatial-index" && hasValue)
+            config.spatialIndex = argv[++i];
+        else if (arg == "--spatial-queries" && hasValue)
+            config.spatialQueriesPerTick = std::atoi(argv[++i]);
+        else if (arg == "--spatial-sweep")
+        {
+            spatialSweep = true;
+            if (hasValue && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                config.spatialQueriesPerTick = std::atoi(argv[++i]);
+        }
+        else if (arg == "--log-level" && hasValue)
+        {
+            LogLevel level;
+            if (!Log::parseLevel(argv[++i], level))
+            {
+                std::cerr << "Unknown log level: " << argv[i] << std::endl;
+                return 1;
+            }
+            Log::setAllLevels(level);
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            std::cout << "Usage: HeadlessSim [scene.json] [--ticks N] [--warmup N] [--dt seconds] [--cubes N] [--alloc-budget N]\n"
+                "                   [--scenario benchmark.json] [--out results.csv|results.json]\n"
+                "                   [--log-level debug|info|warn|error|off]\n"
+                "                   [--physics-threads N] [--thread-sweep [maxThreads]]\n"
+                "                   [--spatial-bench [objects]]\n"
+                "                   [--spatial-index grid|octree|aabbtree] [--spatial-queries N] [--spatial-sweep [queries]]" << std::endl;
+            return 0;
+        }
+        else if (!arg.empty() && arg[0] != '-')
+            config.scenePath = arg;
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    if (spatialBench)
+        return RunSpatialGridBenchmark(spatialConfig) == 0 ? 0 : 1;
+
+    // Without queries the sweep would only time the per-tick update
+    if (spatialSweep && config.spatialQueriesPerTick <= 0)
+        config.spatialQueriesPerTick = 256;
+
+    if (config.ticks <= 0 || config.fixedDt <= 0.0)
+    {
+        std::cerr << "ticks and dt must be positive" << std::endl;
+        return 1;
+    }
+
+    Log::initialize();
+    int result = 0;
+    if (threadSweep)
+        result = RunHeadlessThreadSweep(config, sweepMaxThreads);
+    else if (spatialSweep)
+        result = RunHeadlessSpatialSweep(config);
+    else
+        result = RunHeadless(config);
+    Log::shutdown();
+
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+#include "../include/Core/HeadlessRunner.h"
+#include "../include/Core/Engine.h"
+#include "../include/Core/Profiler.h"
+#include "../include/Core/AllocationTracker.h"
+#include "../include/Core/Benchmark.h"
+#include "../include/Core/ThreadPool.h"
+#include "../include/Physics/Physics.h"
+#include "../include/Physics/ConstraintRegistry.h"
+#include "../include/Physics/TriggerRegistry.h"
+#include "../include/Physics/ForceGeneratorRegistry.h"
+#include "../include/Physics/SpatialIndex.h"
+#include "../include/Scene/Scene.h"
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+int RunHeadless(const HeadlessConfig& config, HeadlessStats* outStats)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Physics + registries, same order as Start()
+    Physics physics;
+    if (config.physicsThreads > 0)
+    {
+        physics.setMultithreaded(true);
+        physics.setSolverThreadCount(config.physicsThreads);
+    }
+    physics.initialize();
+    ConstraintRegistry::getInstance().initialize(physics.getWorld());
+    TriggerRegistry::getInstance().initialize(physics.getWorld());
+    ForceGeneratorRegistry::getInstance().initialize(physics.getWorld());
+
+    physics.getWorld()->getBroadphase()->getOverlappingPairCache()
+        ->setInternalGhostPairCallback(new btGhostPairCallback());
+
+    BenchmarkScenario scenario;
+    if (!config.scenarioPath.empty())
+    {
+        if (!BenchmarkScenario::loadFromFile(config.scenarioPath, scenario))
+            return -1;
+    }
+    else
+    {
+        // Plain run: the scene as-is, or the Test mode cube stack on a ground plane
+        scenario.name = config.scenePath.empty() ? "cube_stack" : std::filesystem::path(config.scenePath).stem().string();
+        scenario.scenePath = config.scenePath;
+        scenario.groundPlane = config.scenePath.empty();
+        if (config.scenePath.empty())
+        {
+            BenchmarkScenario::SpawnGroup cubes;
+            cubes.count = config.stackCubeCount;
+            scenario.spawns.push_back(cubes);
+        }
+        scenario.warmupFrames = config.warmupTicks;
+        scenario.frames = config.ticks;
+        scenario.fixedDt = config.fixedDt;
+    }
+
+    // Headless scene: no renderer, no meshes uploaded
+    Scene scene(physics);
+    scene.setFixedTimestep(static_cast<float>(scenario.fixedDt));
+
+    if (!scenario.populate(scene))
+        return -1;
+
+    // After populate, loading the scene applies the backend it was saved with
+    if (!config.spatialIndex.empty())
+    {
+        SpatialIndexType indexType;
+        if (!spatialIndexTypeFromString(config.spatialIndex, indexType))
+        {
+            std::cerr << "Unknown spatial index: " << config.spatialIndex << " (grid, octree or aabbtree)" << std::endl;
+            return -1;
+        }
+        scene.setSpatialIndexType(indexType, scene.getSpatialCellSize());
+    }
+
+    const float dt = static_cast<float>(scenario.fixedDt);
+    double physicsMs = 0.0;
+    double spatialMs = 0.0;
+    size_t queryCursor = 0;
+    size_t queryHits = 0;
+    std::vector<GameObject*> nearest;
+    // Same passes as Scene::update(), split so the spatial index work can be timed.
+    auto tick = [&]()
+    {
+        Profiler::getInstance().beginFrame();
+        scene.fixedUpdate();
+        auto physicsStart = Clock::now();
+        physics.update(dt);
+        TriggerRegistry::getInstance().update(dt);
+        ForceGeneratorRegistry::getInstance().update(dt);
+        physicsMs = std::chrono::duration<double, std::milli>(Clock::now() - physicsStart).count();
+        scene.capturePhysicsPoses();
+        scene.updateObjects(EngineMode::Game);
+        scene.updateRenderInterpolation(EngineMode::Game, 1.0f);
+
+        auto spatialStart = Clock::now();
+        scene.updateSpatialGrid();
+        // Queries centred on objects, walking the object list so every tick asks about different ones
+        const auto& objects = scene.getObjects();
+        for (int q = 0; q < config.spatialQueriesPerTick && !objects.empty(); q++)
+        {
+            glm::vec3 center = objects[queryCursor++ % objects.size()]->getTransform().getPosition();
+            queryHits += scene.findObjectsInRadius(center, 5.0f).size();
+            scene.findKNearestObjects(center, 8, 20.0f, nearest);
+            queryHits += nearest.size();
+        }
+        spatialMs = std::chrono::duration<double, std::milli>(Clock::now() - spatialStart).count();
+    };
+    // One profiler frame per tick so the zone buffers are drained. Runs after the
+    // tick's timer is stopped, the drain is not part of the simulation cost.
+    auto endTick = []()
+    {
+        Profiler::getInstance().endFrame();
+        AllocationTracker::endFrame();
+    };
+
+    for (int i = 0; i < scenario.warmupFrames; i++)
+    {
+        tick();
+        endTick();
+    }
+
+    // Budget applies to timed ticks only
+    AllocationTracker::setFrameBudget(static_cast<uint64_t>(std::max(config.allocationBudget, 0)));
+    AllocationTracker::resetBudgetStats();
+
+    // Warmup already ran above, the recorder only sees timed ticks
+    BenchmarkScenario timed = scenario;
+    timed.warmupFrames = 0;
+    BenchmarkRecorder recorder;
+    recorder.begin(timed, "headless");
+
+    double spatialTotalMs = 0.0;
+    queryHits = 0;
+    double simulatedSeconds = 0.0; // timed ticks only, without the drains
+    auto runStart = Clock::now();
+    for (int i = 0; i < scenario.frames; i++)
+    {
+        auto tickStart = Clock::now();
+        tick();
+        double tickMs = std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count();
+        endTick();
+        simulatedSeconds += tickMs / 1000.0;
+        recorder.addFrame(tickMs, physicsMs);
+        spatialTotalMs += spatialMs;
+    }
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    BenchmarkResult result = recorder.finish(physics.getRigidBodyCount());
+    result.physicsThreads = physics.getSolverThreadCount();
+
+    HeadlessStats stats;
+    stats.ticks = result.frames;
+    stats.totalSeconds = totalSeconds;
+    stats.ticksPerSecond = simulatedSeconds > 0.0 ? result.frames / simulatedSeconds : 0.0;
+    stats.rigidBodyCount = result.rigidBodies;
+    stats.physicsThreads = result.physicsThreads;
+    stats.avgTickMs = result.frameAvgMs;
+    stats.minTickMs = result.frameMinMs;
+    stats.maxTickMs = result.frameMaxMs;
+    stats.p50TickMs = result.frameP50Ms;
+    stats.p99TickMs = result.frameP99Ms;
+    stats.avgAllocationsPerTick = result.allocsPerFrameAvg;
+    stats.peakAllocationsPerTick = result.allocsPerFramePeak;
+    stats.ticksOverBudget = AllocationTracker::getFramesOverBudget();
+    stats.avgSpatialMs = result.frames > 0 ? spatialTotalMs / result.frames : 0.0;
+
+    for (auto& obj : scene.getObjects())
+    {
+        if (obj->hasPhysics() && obj->getRigidBody() && obj->getRigidBody()->isActive())
+            stats.activeBodyCount++;
+    }
+
+    std::cout << "\n=== Headless Run ===" << std::endl;
+    std::cout << "Scenario: " << scenario.name;
+    if (!scenario.scenePath.empty())
+        std::cout << " (" << scenario.scenePath << ")";
+    std::cout << std::endl;
+    std::cout << "Rigid bodies: " << stats.rigidBodyCount << " (" << stats.activeBodyCount << " active)" << std::endl;
+    std::cout << "Ticks: " << stats.ticks << " @ " << scenario.fixedDt * 1000.0 << " ms"
+        << " (warmup " << scenario.warmupFrames << ")" << std::endl;
+    std::cout << "Wall time: " << stats.totalSeconds << " s, " << stats.ticksPerSecond << " ticks/s" << std::endl;
+    result.print();
+    std::cout << "Spatial index: " << spatialIndexTypeToString(scene.getSpatialIndexType())
+        << ", update + " << config.spatialQueriesPerTick << " query pairs avg " << stats.avgSpatialMs << " ms/tick";
+    if (config.spatialQueriesPerTick > 0)
+        std::cout << " (" << queryHits << " hits)";
+    std::cout << std::endl;
+    if (config.allocationBudget > 0)
+        std::cout << "Alloc budget " << config.allocationBudget << " (" << stats.ticksOverBudget << " ticks over)" << std::endl;
+
+    if (!config.outputPath.empty())
+    {
+        if (result.writeToFile(config.outputPath))
+            std::cout << "Results written to " << config.outputPath << std::endl;
+    }
+
+    if (outStats)
+        *outStats = stats;
+
+    if (config.allocationBudget > 0 && stats.ticksOverBudget > 0)
+        return 1;
+
+    return 0;
+}
+
+int RunHeadlessThreadSweep(const HeadlessConfig& config, int maxThreads)
+{
+    if (!Physics::isMultithreadingAvailable())
+    {
+        std::cerr << "Thread sweep needs the multithreaded world, rebuild with -DENGINE_BULLET_MT=ON" << std::endl;
+        return -1;
+    }
+
+    ThreadPool& pool = ThreadPool::getInstance();
+    pool.initialize();
+    int available = static_cast<int>(pool.getWorkerCount()) + 1;
+    if (maxThreads <= 0 || maxThreads > available)
+        maxThreads = available;
+
+    struct SweepRow { int threads; double avgTickMs; double p99TickMs; };
+    std::vector<SweepRow> rows;
+
+    for (int threads = 1; threads <= maxThreads; threads++)
+    {
+        HeadlessConfig run = config;
+        run.physicsThreads = threads;
+
+        HeadlessStats stats;
+        int result = RunHeadless(run, &stats);
+        if (result < 0)
+            return result;
+        rows.push_back({ threads, stats.avgTickMs, stats.p99TickMs });
+    }
+
+    std::cout << "\n=== Physics thread scaling ===" << std::endl;
+    char line[128];
+    for (const SweepRow& row : rows)
+    {
+        double speedup = row.avgTickMs > 0.0 ? rows.front().avgTickMs / row.avgTickMs : 0.0;
+        std::snprintf(line, sizeof(line), "%2d threads  avg %8.3f ms  p99 %8.3f ms  speed-up %5.2fx",
+            row.threads, row.avgTickMs, row.p99TickMs, speedup);
+        std::cout << line << std::endl;
+    }
+    return 0;
+}
+
+int RunHeadlessSpatialSweep(const HeadlessConfig& config)
+{
+    const SpatialIndexType types[] = { SpatialIndexType::UniformGrid, SpatialIndexType::LooseOctree, SpatialIndexType::AABBTree };
+
+    struct SweepRow { SpatialIndexType type; double avgTickMs; double avgSpatialMs; };
+    std::vector<SweepRow> rows;
+
+    for (SpatialIndexType type : types)
+    {
+        HeadlessConfig run = config;
+        run.spatialIndex = spatialIndexTypeToString(type);
+
+        HeadlessStats stats;
+        int result = RunHeadless(run, &stats);
+        if (result < 0)
+            return result;
+        rows.push_back({ type, stats.avgTickMs, stats.avgSpatialMs });
+    }
+
+    std::cout << "\n=== Spatial index backends (" << config.spatialQueriesPerTick << " query pairs/tick) ===" << std::endl;
+    char line[128];
+    for (const SweepRow& row : rows)
+    {
+        double speedup = row.avgSpatialMs > 0.0 ? rows.front().avgSpatialMs / row.avgSpatialMs : 0.0;
+        std::snprintf(line, sizeof(line), "%-9s  tick %8.3f ms  spatial %8.3f ms  speed-up %5.2fx",
+            spatialIndexTypeToString(row.type), row.avgTickMs, row.avgSpatialMs, speedup);
+        std::cout << line << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include "../include/Core/Log.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+    static_assert((Log::RingCapacity & (Log::RingCapacity - 1)) == 0, "Log::RingCapacity must be a power of two");
+
+    // One ring entry. sequence == position means free for the producer
+    // claiming that position, position + 1 means ready for the writer.
+    struct LogSlot
+    {
+        std::atomic<uint64_t> sequence{ 0 };
+        LogCategory category = LogCategory::Core;
+        LogLevel level = LogLevel::Info;
+        uint16_t length = 0;
+        char text[Log::MaxMessageLength];
+    };
+
+    LogSlot slots[Log::RingCapacity];
+    std::atomic<uint64_t> enqueuePos{ 0 };
+    uint64_t dequeuePos = 0; // writer thread only
+    std::atomic<uint64_t> droppedCount{ 0 };
+
+    std::atomic<uint8_t> levels[static_cast<int>(LogCategory::Count)] = {
+        { static_cast<uint8_t>(LogLevel::Info) },
+        { static_cast<uint8_t>(LogLevel::Info) },
+        { static_cast<uint8_t>(LogLevel::Info) },
+        { static_cast<uint8_t>(LogLevel::Info) },
+        { static_cast<uint8_t>(LogLevel::Info) }
+    };
+
+    std::thread writerThread;
+    std::atomic<bool> running{ false };
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::mutex syncMutex; // serialises synchronous writes when the writer isn't running
+
+    // Writer-thread batching buffers
+    std::string outBuffer;
+    std::string errBuffer;
+
+    // Stops the writer if the process exits without Log::shutdown() (e.g. an
+    // early return from startup), a joinable std::thread would terminate.
+    // Declared after everything the writer touches so it is destroyed first.
+    struct WriterGuard
+    {
+        ~WriterGuard() { Log::shutdown(); }
+    } writerGuard;
+
+    // Idle writer wakes this often, warnings/errors wake it immediately
+    const std::chrono::milliseconds WriterPollInterval(5);
+
+    bool isErrorLevel(LogLevel level)
+    {
+        return level >= LogLevel::Warning;
+    }
+
+    void writeDirect(LogLevel level, const char* text, size_t length)
+    {
+        std::ostream& out = isErrorLevel(level) ? std::cerr : std::cout;
+        out.write(text, static_cast<std::streamsize>(length));
+        out.put('\n');
+    }
+
+    bool tryEnqueue(LogCategory category, LogLevel level, const char* text, size_t length, uint64_t& pos)
+    {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+        LogSlot* slot = nullptr;
+        for (;;)
+        {
+            slot = &slots[pos & (Log::RingCapacity - 1)];
+            uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full, the writer hasn't freed this slot yet
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (length > Log::MaxMessageLength)
+            length = Log::MaxMessageLength;
+        slot->category = category;
+        slot->level = level;
+        slot->length = static_cast<uint16_t>(length);
+        std::memcpy(slot->text, text, length);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Writes everything currently in the ring, grouping runs of the same stream
+    // into one write. Returns the number of messages written.
+    size_t drainRing()
+    {
+        size_t written = 0;
+
+        for (;;)
+        {
+            LogSlot& slot = slots[dequeuePos & (Log::RingCapacity - 1)];
+            uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+            if (seq != dequeuePos + 1)
+                break;
+
+            if (isErrorLevel(slot.level))
+            {
+                // Keep ordering with stdout, flush what came before the error
+                if (!outBuffer.empty()) { std::cout << outBuffer; std::cout.flush(); outBuffer.clear(); }
+                errBuffer.append(slot.text, slot.length);
+                errBuffer.push_back('\n');
+            }
+            else
+            {
+                if (!errBuffer.empty()) { std::cerr << errBuffer; errBuffer.clear(); }
+                outBuffer.append(slot.text, slot.length);
+                outBuffer.push_back('\n');
+            }
+
+            slot.sequence.store(dequeuePos + Log::RingCapacity, std::memory_order_release);
+            dequeuePos++;
+            written++;
+        }
+
+        if (!outBuffer.empty()) { std::cout << outBuffer; std::cout.flush(); outBuffer.clear(); }
+        if (!errBuffer.empty()) { std::cerr << errBuffer; errBuffer.clear(); }
+        return written;
+    }
+
+    void writerLoop()
+    {
+        while (running.load(std::memory_order_acquire))
+        {
+            if (drainRing() == 0)
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wakeCondition.wait_for(lock, WriterPollInterval);
+            }
+        }
+
+        // Whatever was queued before shutdown()
+        drainRing();
+
+        uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+        if (dropped > 0)
+            std::cerr << "[Log] " << dropped << " messages dropped (ring full)" << std::endl;
+    }
+}
+
+void Log::initialize()
+{
+    if (running.load())
+        return;
+
+    for (size_t i = 0; i < RingCapacity; i++)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos = 0;
+
+    running.store(true, std::memory_order_release);
+    writerThread = std::thread(writerLoop);
+}
+
+void Log::shutdown()
+{
+    if (!running.load())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running.store(false, std::memory_order_release);
+    }
+    wakeCondition.notify_one();
+    writerThread.join();
+}
+
+void Log::setLevel(LogCategory category, LogLevel level)
+{
+    if (category >= LogCategory::Count)
+        return;
+    levels[static_cast<int>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Log::setAllLevels(LogLevel level)
+{
+    for (int i = 0; i < static_cast<int>(LogCategory::Count); i++)
+        setLevel(static_cast<LogCategory>(i), level);
+}
+
+LogLevel Log::getLevel(LogCategory category)
+{
+    if (category >= LogCategory::Count)
+        return LogLevel::Off;
+    return static_cast<LogLevel>(levels[static_cast<int>(category)].load(std::memory_order_relaxed));
+}
+
+bool Log::isEnabled(LogCategory category, LogLevel level)
+{
+    return level != LogLevel::Off && level >= getLevel(category);
+}
+
+void Log::write(LogCategory category, LogLevel level, const std::string& message)
+{
+    if (!running.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        writeDirect(level, message.data(), message.size());
+        return;
+    }
+
+    uint64_t pos = 0;
+    if (!tryEnqueue(category, level, message.data(), message.size(), pos))
+    {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Bursts wake the writer every quarter ring instead of waiting out the poll interval
+    if (isErrorLevel(level) || (pos & (RingCapacity / 4 - 1)) == 0)
+        wakeCondition.notify_one();
+}
+
+uint64_t Log::getDroppedCount()
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+const char* Log::getCategoryName(LogCategory category)
+{
+    switch (category)
+    {
+    case LogCategory::Core:    return "Core";
+    case LogCategory::Physics: return "Physics";
+    case LogCategory::Trigger: return "Trigger";
+    case LogCategory::Scene:   return "Scene";
+    case LogCategory::Render:  return "Render";
+    default:                   return "Unknown";
+    }
+}
+
+const char* Log::getLevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Debug:   return "Debug";
+    case LogLevel::Info:    return "Info";
+    case LogLevel::Warning: return "Warning";
+    case LogLevel::Error:   return "Error";
+    case LogLevel::Off:     return "Off";
+    default:                return "Unknown";
+    }
+}
+
+bool Log::parseLevel(const std::string& text, LogLevel& out)
+{
+    if (text == "debug")                         out = LogLevel::Debug;
+    else if (text == "info")                     out = LogLevel::Info;
+    else if (text == "warn" || text == "warning") out = LogLevel::Warning;
+    else if (text == "error")                    out = LogLevel::Error;
+    else if (text == "off")                      out = LogLevel::Off;
+    else return false;
+    return true;
+}
@@ -0,0 +1,211 @@
+#include "../include/Core/Profiler.h"
+#include "../include/Core/AllocationTracker.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    // Nesting depth of open zones on this thread
+    thread_local uint32_t zoneDepth = 0;
+
+    uint64_t steadyNowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+Profiler& Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : epochNs(steadyNowNs())
+{
+    frameEvents.reserve(1024);
+    lastFrameEvents.reserve(1024);
+}
+
+uint64_t Profiler::nowNs() const
+{
+    return steadyNowNs() - epochNs;
+}
+
+uint32_t Profiler::getThreadCount() const
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    return static_cast<uint32_t>(buffers.size());
+}
+
+Profiler::ThreadBuffer* Profiler::getThreadBuffer()
+{
+    // Registered once per thread, the lock is only taken on a thread's first zone
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = buffers.back().get();
+        buffer->threadIndex = static_cast<uint32_t>(buffers.size() - 1);
+    }
+    return buffer;
+}
+
+void Profiler::recordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth,
+    uint32_t allocCount, uint64_t allocBytes)
+{
+    ThreadBuffer* buffer = getThreadBuffer();
+
+    uint32_t head = buffer->head.load(std::memory_order_relaxed);
+    uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+    if (head - tail >= ThreadBuffer::Capacity)
+    {
+        // Consumer hasn't caught up, drop rather than block
+        droppedZones.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ProfileZoneEvent& ev = buffer->events[head & (ThreadBuffer::Capacity - 1)];
+    ev.name = name;
+    ev.startNs = startNs;
+    ev.endNs = endNs;
+    ev.depth = depth;
+    ev.threadIndex = buffer->threadIndex;
+    ev.allocCount = allocCount;
+    ev.allocBytes = allocBytes;
+
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::drainBuffers(std::vector<ProfileZoneEvent>& out)
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto& buffer : buffers)
+    {
+        uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+        uint32_t head = buffer->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+            out.push_back(buffer->events[tail & (ThreadBuffer::Capacity - 1)]);
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void Profiler::beginFrame()
+{
+    frameStartNs = nowNs();
+}
+
+void Profiler::endFrame()
+{
+    uint64_t frameEndNs = nowNs();
+
+    frameEvents.clear();
+    if (isEnabled())
+    {
+        // Whole-frame zone on the main thread so the trace shows frame boundaries
+        ProfileZoneEvent frame;
+        frame.name = "Frame";
+        frame.startNs = frameStartNs;
+        frame.endNs = frameEndNs;
+        frame.depth = 0;
+        frame.threadIndex = getThreadBuffer()->threadIndex;
+        frameEvents.push_back(frame);
+    }
+    drainBuffers(frameEvents);
+
+    // Zones recorded inside the frame sit one level below the frame zone
+    for (size_t i = 1; i < frameEvents.size(); i++)
+    {
+        if (frameEvents[i].threadIndex == frameEvents[0].threadIndex)
+            frameEvents[i].depth++;
+    }
+
+    std::swap(frameEvents, lastFrameEvents);
+    lastFrameStartNs = frameStartNs;
+    lastFrameEndNs = frameEndNs;
+
+    if (captureFramesLeft > 0)
+    {
+        captureEvents.insert(captureEvents.end(), lastFrameEvents.begin(), lastFrameEvents.end());
+        if (--captureFramesLeft == 0)
+        {
+            if (writeChromeTrace(capturePath))
+            {
+                lastCapturePath = capturePath;
+                std::cout << "[Profiler] Wrote " << captureEvents.size() << " zones to " << capturePath << std::endl;
+            }
+            else
+            {
+                std::cerr << "[Profiler] Failed to write trace: " << capturePath << std::endl;
+            }
+            captureEvents.clear();
+            captureEvents.shrink_to_fit();
+        }
+    }
+}
+
+void Profiler::startCapture(int frameCount, const std::string& path)
+{
+    if (frameCount <= 0) return;
+    captureFramesLeft = frameCount;
+    capturePath = path;
+    captureEvents.clear();
+    std::cout << "[Profiler] Capturing " << frameCount << " frames" << std::endl;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+
+    // Complete ("X") events, timestamps in microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    const bool trackAllocations = AllocationTracker::isCompiledIn();
+    bool first = true;
+    for (const auto& ev : captureEvents)
+    {
+        if (!first) file << ",\n";
+        first = false;
+        file << "{\"name\":\"" << ev.name << "\",\"cat\":\"engine\",\"ph\":\"X\""
+            << ",\"ts\":" << (ev.startNs / 1000.0)
+            << ",\"dur\":" << ((ev.endNs - ev.startNs) / 1000.0)
+            << ",\"pid\":1,\"tid\":" << ev.threadIndex;
+        if (trackAllocations)
+            file << ",\"args\":{\"allocs\":" << ev.allocCount << ",\"bytes\":" << ev.allocBytes << "}";
+        file << "}";
+    }
+    file << "\n]}\n";
+    return file.good();
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : name(Profiler::getInstance().isEnabled() ? name : nullptr), startNs(0), depth(0)
+{
+    if (this->name)
+    {
+        depth = zoneDepth++;
+        AllocationTracker::getThreadCounters(startAllocs, startAllocBytes);
+        startNs = Profiler::getInstance().nowNs();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (name)
+    {
+        --zoneDepth;
+        Profiler& profiler = Profiler::getInstance();
+        uint64_t endNs = profiler.nowNs();
+
+        uint64_t allocs = 0, allocBytes = 0;
+        AllocationTracker::getThreadCounters(allocs, allocBytes);
+        profiler.recordZone(name, startNs, endNs, depth,
+            static_cast<uint32_t>(allocs - startAllocs), allocBytes - startAllocBytes);
+    }
+}
@@ -0,0 +1,301 @@
+#include "../include/Core/SpatialGridBenchmark.h"
+#include "../include/Physics/SpatialGrid.h"
+#include "../include/Scene/GameObject.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    struct CellKeyHash {
+        std::size_t operator()(const glm::ivec3& cell) const {
+            std::size_t h = 2166136261u;
+            h = (h ^ static_cast<std::size_t>(cell.x)) * 16777619u;
+            h = (h ^ static_cast<std::size_t>(cell.y)) * 16777619u;
+            h = (h ^ static_cast<std::size_t>(cell.z)) * 16777619u;
+            return h;
+        }
+    };
+
+    // The grid as it was before the flat-hash rewrite, kept as the baseline
+    class NodeGrid {
+    public:
+        explicit NodeGrid(float cellSize) : cellSize(cellSize) {}
+
+        void insertObject(GameObject* obj) {
+            if (objectToCells.find(obj) != objectToCells.end()) return;
+            for (const auto& cell : getObjectCells(obj->getPosition(), obj->getScale())) {
+                cells[cell].insert(obj);
+                objectToCells[obj].insert(cell);
+            }
+        }
+
+        void updateObject(GameObject* obj) {
+            auto it = objectToCells.find(obj);
+            if (it == objectToCells.end()) {
+                insertObject(obj);
+                return;
+            }
+
+            std::vector<glm::ivec3> newCells = getObjectCells(obj->getPosition(), obj->getScale());
+            std::unordered_set<glm::ivec3, CellKeyHash> newCellSet(newCells.begin(), newCells.end());
+            if (it->second == newCellSet) return;
+
+            for (const auto& cell : it->second) {
+                if (newCellSet.find(cell) == newCellSet.end()) {
+                    auto cellIt = cells.find(cell);
+                    if (cellIt != cells.end()) {
+                        cellIt->second.erase(obj);
+                        if (cellIt->second.empty()) cells.erase(cellIt);
+                    }
+                }
+            }
+            for (const auto& cell : newCellSet) {
+                if (it->second.find(cell) == it->second.end())
+                    cells[cell].insert(obj);
+            }
+            it->second = newCellSet;
+        }
+
+        std::vector<GameObject*> queryRadius(const glm::vec3& center, float radius) const {
+            glm::vec3 radiusVec(radius, radius, radius);
+            std::unordered_set<GameObject*> candidates;
+            for (const auto& cell : getCellsInAABB(center - radiusVec, center + radiusVec)) {
+                auto it = cells.find(cell);
+                if (it != cells.end())
+                    candidates.insert(it->second.begin(), it->second.end());
+            }
+
+            std::vector<GameObject*> results;
+            float radiusSquared = radius * radius;
+            for (GameObject* obj : candidates) {
+                glm::vec3 diff = obj->getPosition() - center;
+                if (glm::dot(diff, diff) <= radiusSquared)
+                    results.push_back(obj);
+            }
+            return results;
+        }
+
+        GameObject* queryNearest(const glm::vec3& position, float maxRadius) const {
+            GameObject* nearest = nullptr;
+            float minDistSquared = std::numeric_limits<float>::max();
+            for (GameObject* obj : queryRadius(position, maxRadius)) {
+                glm::vec3 diff = obj->getPosition() - position;
+                float distSquared = glm::dot(diff, diff);
+                if (distSquared < minDistSquared) {
+                    minDistSquared = distSquared;
+                    nearest = obj;
+                }
+            }
+            return nearest;
+        }
+
+    private:
+        glm::ivec3 worldToCell(const glm::vec3& p) const {
+            return glm::ivec3(
+                static_cast<int>(std::floor(p.x / cellSize)),
+                static_cast<int>(std::floor(p.y / cellSize)),
+                static_cast<int>(std::floor(p.z / cellSize)));
+        }
+
+        std::vector<glm::ivec3> getObjectCells(const glm::vec3& position, const glm::vec3& size) const {
+            glm::vec3 halfSize = size * 0.5f;
+            return getCellsInAABB(position - halfSize, position + halfSize);
+        }
+
+        std::vector<glm::ivec3> getCellsInAABB(const glm::vec3& min, const glm::vec3& max) const {
+            glm::ivec3 minCell = worldToCell(min);
+            glm::ivec3 maxCell = worldToCell(max);
+            std::vector<glm::ivec3> cellList;
+            for (int x = minCell.x; x <= maxCell.x; ++x)
+                for (int y = minCell.y; y <= maxCell.y; ++y)
+                    for (int z = minCell.z; z <= maxCell.z; ++z)
+                        cellList.push_back(glm::ivec3(x, y, z));
+            return cellList;
+        }
+
+        float cellSize;
+        std::unordered_map<glm::ivec3, std::unordered_set<GameObject*>, CellKeyHash> cells;
+        std::unordered_map<GameObject*, std::unordered_set<glm::ivec3, CellKeyHash>> objectToCells;
+    };
+
+    // The node grid has no k-nearest query: gather the radius, keep the k closest
+    void kNearest(const NodeGrid& grid, const glm::vec3& point, int k, float radius, std::vector<GameObject*>& out)
+    {
+        out = grid.queryRadius(point, radius);
+        auto closer = [&point](GameObject* a, GameObject* b) {
+            glm::vec3 da = a->getPosition() - point;
+            glm::vec3 db = b->getPosition() - point;
+            return glm::dot(da, da) < glm::dot(db, db);
+        };
+        size_t keep = std::min(out.size(), static_cast<size_t>(k));
+        std::partial_sort(out.begin(), out.begin() + keep, out.end(), closer);
+        out.resize(keep);
+    }
+
+    void kNearest(const SpatialGrid& grid, const glm::vec3& point, int k, float radius, std::vector<GameObject*>& out)
+    {
+        grid.queryKNearest(point, k, radius, out);
+    }
+
+    struct GridTimings {
+        double insertMs = 0.0;
+        double updateMs = 0.0;      // all frames
+        double radiusMs = 0.0;      // all queries
+        double nearestMs = 0.0;
+        double kNearestMs = 0.0;
+        size_t radiusHits = 0;      // keeps the queries from being optimised out
+    };
+
+    // Same sequence for both grids: insert all, then frames of
+    // (move objects, update every object), then the query batches
+    template <typename Grid>
+    GridTimings runGrid(Grid& grid,
+        std::vector<std::unique_ptr<GameObject>>& objects,
+        const std::vector<glm::vec3>& startPositions,
+        const std::vector<glm::vec3>& velocities,
+        const std::vector<glm::vec3>& queryPoints,
+        const SpatialBenchConfig& config)
+    {
+        GridTimings timings;
+
+        for (size_t i = 0; i < objects.size(); i++)
+            objects[i]->setPosition(startPositions[i]);
+
+        auto start = Clock::now();
+        for (auto& obj : objects)
+            grid.insertObject(obj.get());
+        timings.insertMs = elapsedMs(start);
+
+        for (int frame = 0; frame < config.frames; frame++) {
+            for (size_t i = 0; i < objects.size(); i++)
+                objects[i]->setPosition(objects[i]->getPosition() + velocities[i]);
+
+            start = Clock::now();
+            for (auto& obj : objects)
+                grid.updateObject(obj.get());
+            timings.updateMs += elapsedMs(start);
+        }
+
+        start = Clock::now();
+        for (const glm::vec3& point : queryPoints)
+            timings.radiusHits += grid.queryRadius(point, config.queryRadius).size();
+        timings.radiusMs = elapsedMs(start);
+
+        start = Clock::now();
+        for (const glm::vec3& point : queryPoints)
+            timings.radiusHits += grid.queryNearest(point, config.queryRadius) ? 1 : 0;
+        timings.nearestMs = elapsedMs(start);
+
+        std::vector<GameObject*> nearestK;
+        start = Clock::now();
+        for (const glm::vec3& point : queryPoints) {
+            kNearest(grid, point, config.k, config.kRadius, nearestK);
+            timings.radiusHits += nearestK.size();
+        }
+        timings.kNearestMs = elapsedMs(start);
+
+        return timings;
+    }
+
+    void keepFastest(GridTimings& best, const GridTimings& run, bool first)
+    {
+        if (first) {
+            best = run;
+            return;
+        }
+        best.insertMs = std::min(best.insertMs, run.insertMs);
+        best.updateMs = std::min(best.updateMs, run.updateMs);
+        best.radiusMs = std::min(best.radiusMs, run.radiusMs);
+        best.nearestMs = std::min(best.nearestMs, run.nearestMs);
+        best.kNearestMs = std::min(best.kNearestMs, run.kNearestMs);
+        best.radiusHits += run.radiusHits;
+    }
+
+    void printRow(const char* name, double nodeMs, double flatMs, int count)
+    {
+        double perFlat = count > 0 ? flatMs * 1000.0 / count : 0.0;
+        std::printf("  %-10s %12.3f %12.3f %10.3f %9.2fx\n", name, nodeMs, flatMs, perFlat, flatMs > 0.0 ? nodeMs / flatMs : 0.0);
+    }
+}
+
+int RunSpatialGridBenchmark(const SpatialBenchConfig& config)
+{
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<float> spreadXZ(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> spreadY(0.0f, 40.0f);
+    std::uniform_real_distribution<float> speed(-0.5f, 0.5f);
+
+    // Mostly unit objects with a few large ones spanning several cells
+    std::vector<std::unique_ptr<GameObject>> objects;
+    std::vector<glm::vec3> startPositions;
+    std::vector<glm::vec3> velocities;
+    objects.reserve(config.objectCount);
+    for (int i = 0; i < config.objectCount; i++) {
+        glm::vec3 position(spreadXZ(rng), spreadY(rng), spreadXZ(rng));
+        glm::vec3 scale = (i % 100 == 0) ? glm::vec3(25.0f) : glm::vec3(1.0f);
+        objects.push_back(std::make_unique<GameObject>(ShapeType::CUBE, position, scale));
+        startPositions.push_back(position);
+        velocities.push_back(glm::vec3(speed(rng), speed(rng) * 0.2f, speed(rng)));
+    }
+
+    std::vector<glm::vec3> queryPoints;
+    queryPoints.reserve(config.queries);
+    for (int i = 0; i < config.queries; i++)
+        queryPoints.push_back(glm::vec3(spreadXZ(rng), spreadY(rng), spreadXZ(rng)));
+
+    std::cout << "SpatialGrid benchmark: " << config.objectCount << " objects, "
+        << config.frames << " update frames, " << config.queries << " queries (radius "
+        << config.queryRadius << ", cell " << config.cellSize << ", k-nearest " << config.k
+        << " within " << config.kRadius << "), best of " << std::max(config.repeats, 1) << " runs" << std::endl;
+
+    // Fresh grids every run, the last pair is kept for the result check
+    std::unique_ptr<NodeGrid> nodeGrid;
+    std::unique_ptr<SpatialGrid> flatGrid;
+    GridTimings node, flat;
+    for (int run = 0; run < std::max(config.repeats, 1); run++) {
+        nodeGrid = std::make_unique<NodeGrid>(config.cellSize);
+        keepFastest(node, runGrid(*nodeGrid, objects, startPositions, velocities, queryPoints, config), run == 0);
+
+        flatGrid = std::make_unique<SpatialGrid>(config.cellSize);
+        keepFastest(flat, runGrid(*flatGrid, objects, startPositions, velocities, queryPoints, config), run == 0);
+    }
+
+    std::printf("  %-10s %12s %12s %10s %10s\n", "", "node ms", "flat ms", "flat us/op", "speed-up");
+    printRow("insert", node.insertMs, flat.insertMs, config.objectCount);
+    printRow("update", node.updateMs, flat.updateMs, config.objectCount * config.frames);
+    printRow("radius", node.radiusMs, flat.radiusMs, config.queries);
+    printRow("nearest", node.nearestMs, flat.nearestMs, config.queries);
+    printRow("k-nearest", node.kNearestMs, flat.kNearestMs, config.queries);
+
+    // Both grids saw the same objects in the same final positions
+    size_t mismatches = 0;
+    for (const glm::vec3& point : queryPoints) {
+        std::vector<GameObject*> expected = nodeGrid->queryRadius(point, config.queryRadius);
+        std::vector<GameObject*> actual = flatGrid->queryRadius(point, config.queryRadius);
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        if (expected != actual) mismatches++;
+    }
+
+    if (mismatches > 0) {
+        std::cerr << "SpatialGrid benchmark: " << mismatches << " queries differ from the node grid" << std::endl;
+        return 1;
+    }
+    return 0;
+}
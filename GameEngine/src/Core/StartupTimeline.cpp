@@ -0,0 +1,89 @@
+#include "../include/Core/StartupTimeline.h"
+#include "../include/Core/ThreadPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+StartupTimeline& StartupTimeline::getInstance()
+{
+    static StartupTimeline instance;
+    return instance;
+}
+
+void StartupTimeline::begin()
+{
+    std::lock_guard<std::mutex> lock(stepsMutex);
+    startTime = Clock::now();
+    steps.clear();
+    firstFrameDone = false;
+    timeToFirstFrameMs = 0.0;
+}
+
+void StartupTimeline::record(const char* name, Clock::time_point start, Clock::time_point end)
+{
+    Step step;
+    step.name = name;
+    step.startMs = std::chrono::duration<double, std::milli>(start - startTime).count();
+    step.endMs = std::chrono::duration<double, std::milli>(end - startTime).count();
+    step.worker = ThreadPool::getCurrentWorkerIndex();
+
+    std::lock_guard<std::mutex> lock(stepsMutex);
+    if (!firstFrameDone)
+        steps.push_back(step);
+}
+
+void StartupTimeline::markFirstFrame()
+{
+    {
+        std::lock_guard<std::mutex> lock(stepsMutex);
+        if (firstFrameDone)
+            return;
+        firstFrameDone = true;
+        timeToFirstFrameMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    }
+
+    print();
+}
+
+void StartupTimeline::print() const
+{
+    std::vector<Step> sorted;
+    {
+        std::lock_guard<std::mutex> lock(stepsMutex);
+        sorted = steps;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const Step& a, const Step& b) { return a.startMs < b.startMs; });
+
+    // Sum of step durations on workers = CPU work taken off the main thread
+    double workerMs = 0.0;
+    for (const Step& step : sorted)
+    {
+        if (step.worker >= 0)
+            workerMs += step.endMs - step.startMs;
+    }
+
+    std::cout << "\n=== Startup Timeline ===" << std::endl;
+    char line[160];
+    for (const Step& step : sorted)
+    {
+        char thread[16];
+        if (step.worker < 0)
+            std::snprintf(thread, sizeof(thread), "main");
+        else
+            std::snprintf(thread, sizeof(thread), "worker %d", step.worker);
+
+        std::snprintf(line, sizeof(line), "  %8.1f - %8.1f ms  %8.1f ms  %-9s %s",
+            step.startMs, step.endMs, step.endMs - step.startMs, thread, step.name);
+        std::cout << line << std::endl;
+    }
+
+    std::snprintf(line, sizeof(line), "Time to first frame: %.1f ms (%.1f ms of loading ran on workers)",
+        timeToFirstFrameMs, workerMs);
+    std::cout << line << std::endl;
+
+    if (budgetMs > 0.0 && timeToFirstFrameMs > budgetMs)
+        std::cout << "Startup over budget: " << timeToFirstFrameMs << " ms > " << budgetMs << " ms" << std::endl;
+
+    std::cout << "========================\n" << std::endl;
+}
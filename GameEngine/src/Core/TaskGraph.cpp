@@ -0,0 +1,121 @@
+#include "../include/Core/TaskGraph.h"
+#include "../include/Core/ThreadPool.h"
+#include "../include/Core/Profiler.h"
+#include <thread>
+
+TaskGraph::TaskId TaskGraph::addTask(const char* name, FrameResourceMask reads, FrameResourceMask writes, std::function<void()> fn)
+{
+    auto task = std::make_unique<Task>();
+    task->name = name;
+    task->reads = reads;
+    task->writes = writes;
+    task->fn = std::move(fn);
+    task->mainThreadOnly = (writes & FrameResource::GLContext) != 0;
+
+    TaskId id = static_cast<TaskId>(tasks.size());
+
+    // Depend on every earlier task this one conflicts with
+    for (TaskId earlier = 0; earlier < id; earlier++)
+    {
+        Task& other = *tasks[earlier];
+        bool conflict = (other.writes & (reads | writes)) != 0 ||
+                        (other.reads & writes) != 0;
+        if (conflict)
+        {
+            other.dependents.push_back(id);
+            task->dependencyCount++;
+        }
+    }
+
+    tasks.push_back(std::move(task));
+    readyMainThreadTasks.reserve(tasks.size()); // execute() never grows it
+    return id;
+}
+
+int TaskGraph::getDependencyCount(TaskId id) const
+{
+    if (id < 0 || id >= static_cast<TaskId>(tasks.size()))
+        return 0;
+    return tasks[id]->dependencyCount;
+}
+
+void TaskGraph::clear()
+{
+    tasks.clear();
+    readyMainThreadTasks.clear();
+    readyMainThreadCount.store(0);
+    tasksRemaining.store(0);
+}
+
+void TaskGraph::schedule(TaskId id)
+{
+    if (tasks[id]->mainThreadOnly)
+    {
+        while (mainQueueLock.test_and_set(std::memory_order_acquire)) {}
+        readyMainThreadTasks.push_back(id);
+        mainQueueLock.clear(std::memory_order_release);
+        readyMainThreadCount.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    // Small capture so std::function stores it inline (no allocation per task)
+    pool->submit([this, id]() { runTask(id); });
+}
+
+void TaskGraph::runTask(TaskId id)
+{
+    Task& task = *tasks[id];
+    {
+        ProfileScope zone(task.name);
+        task.fn();
+    }
+
+    // Release dependents, the last dependency to finish schedules the task
+    for (TaskId dependent : task.dependents)
+    {
+        if (tasks[dependent]->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            schedule(dependent);
+    }
+
+    tasksRemaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void TaskGraph::execute(ThreadPool& pool)
+{
+    if (tasks.empty())
+        return;
+
+    PROFILE_SCOPE("TaskGraph::execute");
+    this->pool = &pool;
+
+    tasksRemaining.store(static_cast<int>(tasks.size()), std::memory_order_relaxed);
+    for (auto& task : tasks)
+        task->remainingDependencies.store(task->dependencyCount, std::memory_order_relaxed);
+
+    for (TaskId id = 0; id < static_cast<TaskId>(tasks.size()); id++)
+    {
+        if (tasks[id]->dependencyCount == 0)
+            schedule(id);
+    }
+
+    // Help out until everything is done: main-thread tasks first, then pool work
+    while (tasksRemaining.load(std::memory_order_acquire) > 0)
+    {
+        if (readyMainThreadCount.load(std::memory_order_acquire) > 0)
+        {
+            while (mainQueueLock.test_and_set(std::memory_order_acquire)) {}
+            TaskId id = readyMainThreadTasks.back();
+            readyMainThreadTasks.pop_back();
+            mainQueueLock.clear(std::memory_order_release);
+            readyMainThreadCount.fetch_sub(1, std::memory_order_acq_rel);
+
+            runTask(id);
+            continue;
+        }
+
+        if (!pool.tryRunPendingTask())
+            std::this_thread::yield();
+    }
+
+    this->pool = nullptr;
+}
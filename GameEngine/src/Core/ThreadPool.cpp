@@ -0,0 +1,204 @@
+#include "../include/Core/ThreadPool.h"
+#include <iostream>
+
+namespace
+{
+    thread_local int currentWorkerIndex = -1;
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+}
+
+int ThreadPool::getCurrentWorkerIndex()
+{
+    return currentWorkerIndex;
+}
+
+void ThreadPool::initialize(unsigned int threadCount)
+{
+    if (!queues.empty())
+        return; // already running
+
+    if (threadCount == 0)
+    {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    stopping = false;
+
+    // Always at least one queue so submit() works with zero workers
+    unsigned int queueCount = threadCount > 0 ? threadCount : 1;
+    for (unsigned int i = 0; i < queueCount; i++)
+        queues.push_back(std::make_unique<WorkQueue>());
+
+    for (unsigned int i = 0; i < threadCount; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+
+    std::cout << "ThreadPool started with " << threadCount << " worker threads" << std::endl;
+}
+
+void ThreadPool::shutdown()
+{
+    if (queues.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+
+    // Run anything left over so no submitter waits forever
+    while (tryRunPendingTask()) {}
+
+    queues.clear();
+}
+
+void ThreadPool::submit(Task task)
+{
+    if (queues.empty())
+    {
+        // Not initialized: run inline
+        task();
+        return;
+    }
+
+    // Workers keep their own work local, everyone else spreads round-robin
+    unsigned int index = currentWorkerIndex >= 0
+        ? static_cast<unsigned int>(currentWorkerIndex)
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    pendingTasks.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep lock orders this with a worker that is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+bool ThreadPool::popLocal(unsigned int index, Task& out)
+{
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+
+    out = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned int thiefIndex, Task& out)
+{
+    size_t count = queues.size();
+    for (size_t offset = 1; offset <= count; offset++)
+    {
+        WorkQueue& queue = *queues[(thiefIndex + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        // Oldest task from the victim, the owner keeps working on its newest
+        out = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunPendingTask()
+{
+    if (queues.empty() || pendingTasks.load(std::memory_order_acquire) == 0)
+        return false;
+
+    Task task;
+    bool found = currentWorkerIndex >= 0
+        ? (popLocal(currentWorkerIndex, task) || steal(currentWorkerIndex, task))
+        : steal(0, task);
+
+    if (!found)
+        return false;
+
+    pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned int index)
+{
+    currentWorkerIndex = static_cast<int>(index);
+
+    while (true)
+    {
+        Task task;
+        if (popLocal(index, task) || steal(index, task))
+        {
+            pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this] {
+            return stopping || pendingTasks.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && pendingTasks.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+// ============================================================
+// TaskGroup
+// ============================================================
+
+void TaskGroup::run(ThreadPool::Task task)
+{
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool.submit([this, task = std::move(task)]() {
+        task();
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    });
+}
+
+void TaskGroup::run(Job& job)
+{
+    job.group = this;
+    pending.fetch_add(1, std::memory_order_relaxed);
+
+    // One pointer of capture, small enough for std::function's inline storage
+    Job* jobPtr = &job;
+    pool.submit([jobPtr]() {
+        jobPtr->function(jobPtr->context);
+        jobPtr->group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    });
+}
+
+void TaskGroup::wait()
+{
+    while (!isDone())
+    {
+        if (!pool.tryRunPendingTask())
+            std::this_thread::yield();
+    }
+}
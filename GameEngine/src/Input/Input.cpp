@@ -222,3 +222,49 @@ double Input::GetMouseDeltaY()
     return mouseDeltaY;
 }
 
+// State snapshot / override (input replay)
+
+void Input::CaptureState(InputState& out)
+{
+    for (int i = 0; i < MaxKeys; i++)
+    {
+        out.keys[i] = (keysDown[i] ? StateDown : 0) |
+                      (keysPressed[i] ? StatePressed : 0) |
+                      (keysReleased[i] ? StateReleased : 0);
+    }
+
+    for (int i = 0; i < MaxMouseButtons; i++)
+    {
+        out.mouseButtons[i] = (mouseButtonsDown[i] ? StateDown : 0) |
+                              (mouseButtonsPressed[i] ? StatePressed : 0) |
+                              (mouseButtonsReleased[i] ? StateReleased : 0);
+    }
+
+    out.mouseDeltaX = mouseDeltaX;
+    out.mouseDeltaY = mouseDeltaY;
+}
+
+void Input::ApplyState(const InputState& state)
+{
+    for (int i = 0; i < MaxKeys; i++)
+    {
+        keysDown[i] = (state.keys[i] & StateDown) != 0;
+        keysPressed[i] = (state.keys[i] & StatePressed) != 0;
+        keysReleased[i] = (state.keys[i] & StateReleased) != 0;
+    }
+
+    for (int i = 0; i < MaxMouseButtons; i++)
+    {
+        mouseButtonsDown[i] = (state.mouseButtons[i] & StateDown) != 0;
+        mouseButtonsPressed[i] = (state.mouseButtons[i] & StatePressed) != 0;
+        mouseButtonsReleased[i] = (state.mouseButtons[i] & StateReleased) != 0;
+    }
+
+    mouseDeltaX = state.mouseDeltaX;
+    mouseDeltaY = state.mouseDeltaY;
+}
+
+void Input::ResetState()
+{
+    ApplyState(InputState{});
+}
@@ -0,0 +1,303 @@
+#include "../include/Input/InputReplay.h"
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <cstring>
+
+namespace
+{
+    const char Magic[4] = { 'E', 'I', 'N', 'P' };
+    const uint32_t FormatVersion = 1;
+
+    const uint8_t FlagMouseButtons = 1 << 0;
+    const uint8_t FlagMouseDelta = 1 << 1;
+
+    std::ofstream recordFile;
+    std::streampos recordCountsOffset = 0;
+    uint32_t recordFrames = 0;
+    uint32_t recordTicks = 0;
+    Input::InputState recordPrevious; // last written state, keys are delta encoded against it
+
+    std::ifstream replayFile;
+    uint32_t replayFrames = 0;
+    uint32_t replayTotalFrames = 0;
+    Input::InputState replayCurrent;
+
+    template <typename T>
+    void writePod(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readPod(std::ifstream& file, T& value)
+    {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<bool>(file);
+    }
+}
+
+// ============================================================
+// Recording
+// ============================================================
+
+bool InputReplay::StartRecording(const std::string& path, const SessionHeader& header)
+{
+    StopRecording();
+
+    std::error_code ec;
+    std::filesystem::path filePath(path);
+    if (filePath.has_parent_path())
+        std::filesystem::create_directories(filePath.parent_path(), ec);
+
+    recordFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!recordFile)
+    {
+        std::cerr << "[InputReplay] Could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    recordFile.write(Magic, sizeof(Magic));
+    writePod(recordFile, FormatVersion);
+    writePod(recordFile, header.fixedDt);
+    writePod(recordFile, static_cast<uint8_t>(header.pipelinedPhysics ? 1 : 0));
+    writePod(recordFile, static_cast<uint8_t>(header.mode));
+    writePod(recordFile, header.cameraPosition.x);
+    writePod(recordFile, header.cameraPosition.y);
+    writePod(recordFile, header.cameraPosition.z);
+    writePod(recordFile, header.cameraYaw);
+    writePod(recordFile, header.cameraPitch);
+    writePod(recordFile, static_cast<uint16_t>(header.scenePath.size()));
+    recordFile.write(header.scenePath.data(), header.scenePath.size());
+
+    // Patched by StopRecording()
+    recordCountsOffset = recordFile.tellp();
+    writePod(recordFile, uint32_t(0));
+    writePod(recordFile, uint32_t(0));
+
+    recordFrames = 0;
+    recordTicks = 0;
+    recordPrevious = Input::InputState{};
+
+    std::cout << "[InputReplay] Recording to " << path << std::endl;
+    return true;
+}
+
+void InputReplay::RecordFrame(float deltaTime, int fixedTicks, EngineMode mode)
+{
+    if (!recordFile.is_open())
+        return;
+
+    Input::InputState state;
+    Input::CaptureState(state);
+
+    uint16_t changedKeys = 0;
+    for (int i = 0; i < Input::MaxKeys; i++)
+    {
+        if (state.keys[i] != recordPrevious.keys[i])
+            changedKeys++;
+    }
+
+    uint8_t flags = 0;
+    if (std::memcmp(state.mouseButtons, recordPrevious.mouseButtons, sizeof(state.mouseButtons)) != 0)
+        flags |= FlagMouseButtons;
+    if (state.mouseDeltaX != 0.0 || state.mouseDeltaY != 0.0)
+        flags |= FlagMouseDelta;
+
+    writePod(recordFile, deltaTime);
+    writePod(recordFile, static_cast<uint16_t>(fixedTicks));
+    writePod(recordFile, static_cast<uint8_t>(mode));
+    writePod(recordFile, flags);
+    writePod(recordFile, changedKeys);
+
+    for (int i = 0; i < Input::MaxKeys; i++)
+    {
+        if (state.keys[i] != recordPrevious.keys[i])
+        {
+            writePod(recordFile, static_cast<uint16_t>(i));
+            writePod(recordFile, state.keys[i]);
+        }
+    }
+
+    if (flags & FlagMouseButtons)
+        recordFile.write(reinterpret_cast<const char*>(state.mouseButtons), sizeof(state.mouseButtons));
+
+    if (flags & FlagMouseDelta)
+    {
+        writePod(recordFile, state.mouseDeltaX);
+        writePod(recordFile, state.mouseDeltaY);
+    }
+
+    recordPrevious = state;
+    recordFrames++;
+    recordTicks += static_cast<uint32_t>(fixedTicks);
+}
+
+void InputReplay::StopRecording()
+{
+    if (!recordFile.is_open())
+        return;
+
+    recordFile.seekp(recordCountsOffset);
+    writePod(recordFile, recordFrames);
+    writePod(recordFile, recordTicks);
+    recordFile.close();
+
+    std::cout << "[InputReplay] Recorded " << recordFrames << " frames, "
+        << recordTicks << " physics ticks" << std::endl;
+}
+
+bool InputReplay::IsRecording()
+{
+    return recordFile.is_open();
+}
+
+// ============================================================
+// Replay
+// ============================================================
+
+bool InputReplay::StartReplay(const std::string& path, SessionHeader& header)
+{
+    StopReplay();
+
+    replayFile.open(path, std::ios::binary);
+    if (!replayFile)
+    {
+        std::cerr << "[InputReplay] Could not open " << path << std::endl;
+        return false;
+    }
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    replayFile.read(magic, sizeof(magic));
+    readPod(replayFile, version);
+    if (!replayFile || std::memcmp(magic, Magic, sizeof(Magic)) != 0 || version != FormatVersion)
+    {
+        std::cerr << "[InputReplay] " << path << " is not a version " << FormatVersion << " input recording" << std::endl;
+        replayFile.close();
+        return false;
+    }
+
+    uint8_t pipelined = 0;
+    uint8_t mode = 0;
+    uint16_t pathLength = 0;
+    readPod(replayFile, header.fixedDt);
+    readPod(replayFile, pipelined);
+    readPod(replayFile, mode);
+    readPod(replayFile, header.cameraPosition.x);
+    readPod(replayFile, header.cameraPosition.y);
+    readPod(replayFile, header.cameraPosition.z);
+    readPod(replayFile, header.cameraYaw);
+    readPod(replayFile, header.cameraPitch);
+    readPod(replayFile, pathLength);
+    header.scenePath.resize(pathLength);
+    replayFile.read(&header.scenePath[0], pathLength);
+    readPod(replayFile, header.frameCount);
+    readPod(replayFile, header.tickCount);
+
+    if (!replayFile)
+    {
+        std::cerr << "[InputReplay] " << path << " has a truncated header" << std::endl;
+        replayFile.close();
+        return false;
+    }
+
+    header.pipelinedPhysics = pipelined != 0;
+    header.mode = static_cast<EngineMode>(mode);
+
+    // A recording that was never closed has no counts, it replays until the data runs out
+    replayFrames = 0;
+    replayTotalFrames = header.frameCount;
+    replayCurrent = Input::InputState{};
+
+    std::cout << "[InputReplay] Replaying " << path << " (" << header.frameCount << " frames, "
+        << header.tickCount << " physics ticks)" << std::endl;
+    return true;
+}
+
+bool InputReplay::NextFrame(Frame& out)
+{
+    if (!replayFile.is_open())
+        return false;
+
+    if (replayTotalFrames != 0 && replayFrames >= replayTotalFrames)
+    {
+        StopReplay();
+        return false;
+    }
+
+    uint16_t fixedTicks = 0;
+    uint8_t mode = 0;
+    uint8_t flags = 0;
+    uint16_t changedKeys = 0;
+
+    // Pressed/released only last one frame, held state carries over
+    for (int i = 0; i < Input::MaxKeys; i++)
+        replayCurrent.keys[i] &= Input::StateDown;
+    for (int i = 0; i < Input::MaxMouseButtons; i++)
+        replayCurrent.mouseButtons[i] &= Input::StateDown;
+    replayCurrent.mouseDeltaX = 0.0;
+    replayCurrent.mouseDeltaY = 0.0;
+
+    bool ok = readPod(replayFile, out.deltaTime) &&
+        readPod(replayFile, fixedTicks) &&
+        readPod(replayFile, mode) &&
+        readPod(replayFile, flags) &&
+        readPod(replayFile, changedKeys);
+
+    for (uint16_t i = 0; ok && i < changedKeys; i++)
+    {
+        uint16_t key = 0;
+        uint8_t state = 0;
+        ok = readPod(replayFile, key) && readPod(replayFile, state) && key < Input::MaxKeys;
+        if (ok)
+            replayCurrent.keys[key] = state;
+    }
+
+    if (ok && (flags & FlagMouseButtons))
+    {
+        replayFile.read(reinterpret_cast<char*>(replayCurrent.mouseButtons), sizeof(replayCurrent.mouseButtons));
+        ok = static_cast<bool>(replayFile);
+    }
+
+    if (ok && (flags & FlagMouseDelta))
+        ok = readPod(replayFile, replayCurrent.mouseDeltaX) && readPod(replayFile, replayCurrent.mouseDeltaY);
+
+    if (!ok)
+    {
+        if (replayTotalFrames != 0)
+            std::cerr << "[InputReplay] Recording ended early at frame " << replayFrames << std::endl;
+        StopReplay();
+        return false;
+    }
+
+    out.fixedTicks = fixedTicks;
+    out.mode = static_cast<EngineMode>(mode);
+    out.input = replayCurrent;
+    replayFrames++;
+    return true;
+}
+
+void InputReplay::StopReplay()
+{
+    if (!replayFile.is_open())
+        return;
+
+    replayFile.close();
+    std::cout << "[InputReplay] Replay stopped after " << replayFrames << " frames" << std::endl;
+}
+
+bool InputReplay::IsReplaying()
+{
+    return replayFile.is_open();
+}
+
+uint32_t InputReplay::GetFrameIndex()
+{
+    return IsRecording() ? recordFrames : replayFrames;
+}
+
+uint32_t InputReplay::GetFrameCount()
+{
+    return IsRecording() ? recordFrames : replayTotalFrames;
+}
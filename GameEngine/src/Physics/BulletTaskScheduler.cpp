@@ -0,0 +1,142 @@
+#include "../include/Physics/BulletTaskScheduler.h"
+
+#ifdef ENGINE_BULLET_MT
+
+#include "../include/Core/ThreadPool.h"
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    // One range of a parallel loop, run through TaskGroup::Job so nothing allocates per range
+    struct ForRange {
+        const btIParallelForBody* body;
+        int begin;
+        int end;
+
+        static void run(void* context)
+        {
+            ForRange& range = *static_cast<ForRange*>(context);
+            range.body->forLoop(range.begin, range.end);
+        }
+    };
+
+    struct SumRange {
+        const btIParallelSumBody* body;
+        int begin;
+        int end;
+        btScalar sum;
+
+        static void run(void* context)
+        {
+            SumRange& range = *static_cast<SumRange*>(context);
+            range.sum = range.body->sumLoop(range.begin, range.end);
+        }
+    };
+}
+
+BulletTaskScheduler::BulletTaskScheduler(ThreadPool& pool)
+    : btITaskScheduler("EngineThreadPool"), pool(pool), numThreads(1)
+{
+    // btCollisionDispatcherMt sizes its per-thread batch arrays from getNumThreads()
+    // when it is constructed, so start at the full thread-index count. The owner
+    // lowers it to getMaxLoopThreads() once the world exists (see Physics::initialize).
+    numThreads = getMaxNumThreads();
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const
+{
+    // Pool workers plus both threads that may call stepSimulation (main thread when
+    // serial, PhysicsStepThread when pipelined). Each gets its own btGetCurrentThreadIndex,
+    // and the Mt dispatcher/solver pool index per-thread arrays by it.
+    return std::min(static_cast<int>(pool.getWorkerCount()) + 2, static_cast<int>(BT_MAX_THREAD_COUNT));
+}
+
+int BulletTaskScheduler::getMaxLoopThreads() const
+{
+    // Only one stepping thread joins a given loop
+    return std::max(1, getMaxNumThreads() - 1);
+}
+
+void BulletTaskScheduler::setNumThreads(int count)
+{
+    numThreads = std::max(1, std::min(count, getMaxLoopThreads()));
+}
+
+int BulletTaskScheduler::rangeCount(int iBegin, int iEnd, int grainSize) const
+{
+    int count = iEnd - iBegin;
+    if (count <= 0)
+        return 0;
+
+    int grain = std::max(grainSize, 1);
+    int byGrain = (count + grain - 1) / grain;
+    return std::max(1, std::min(byGrain, numThreads));
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+{
+    int ranges = rangeCount(iBegin, iEnd, grainSize);
+    if (ranges <= 1)
+    {
+        if (ranges == 1)
+            body.forLoop(iBegin, iEnd);
+        return;
+    }
+
+    // ranges <= numThreads <= BT_MAX_THREAD_COUNT
+    int count = iEnd - iBegin;
+    std::array<ForRange, BT_MAX_THREAD_COUNT> rangeData;
+    std::array<TaskGroup::Job, BT_MAX_THREAD_COUNT> jobs;
+    TaskGroup group(pool);
+    for (int r = 1; r < ranges; r++)
+    {
+        int begin = iBegin + static_cast<int>(static_cast<long long>(count) * r / ranges);
+        int end = iBegin + static_cast<int>(static_cast<long long>(count) * (r + 1) / ranges);
+        rangeData[r] = ForRange{ &body, begin, end };
+        jobs[r].function = &ForRange::run;
+        jobs[r].context = &rangeData[r];
+        group.run(jobs[r]);
+    }
+
+    body.forLoop(iBegin, iBegin + count / ranges);
+    group.wait();
+}
+
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
+{
+    int ranges = rangeCount(iBegin, iEnd, grainSize);
+    if (ranges <= 1)
+        return ranges == 1 ? body.sumLoop(iBegin, iEnd) : btScalar(0);
+
+    int count = iEnd - iBegin;
+    std::array<SumRange, BT_MAX_THREAD_COUNT> rangeData;
+    std::array<TaskGroup::Job, BT_MAX_THREAD_COUNT> jobs;
+    {
+        TaskGroup group(pool);
+        for (int r = 0; r < ranges; r++)
+        {
+            int begin = iBegin + static_cast<int>(static_cast<long long>(count) * r / ranges);
+            int end = iBegin + static_cast<int>(static_cast<long long>(count) * (r + 1) / ranges);
+            rangeData[r] = SumRange{ &body, begin, end, btScalar(0) };
+        }
+
+        for (int r = 1; r < ranges; r++)
+        {
+            jobs[r].function = &SumRange::run;
+            jobs[r].context = &rangeData[r];
+            group.run(jobs[r]);
+        }
+
+        SumRange::run(&rangeData[0]);
+        group.wait();
+    }
+
+    // Summed in range order so the result doesn't depend on scheduling
+    btScalar sum = 0;
+    for (int r = 0; r < ranges; r++)
+        sum += rangeData[r].sum;
+    return sum;
+}
+
+#endif // ENGINE_BULLET_MT
@@ -0,0 +1,116 @@
+#include "../include/Physics/CollisionLayers.h"
+#include <iostream>
+
+CollisionLayers& CollisionLayers::getInstance()
+{
+    static CollisionLayers instance;
+    return instance;
+}
+
+CollisionLayers::CollisionLayers()
+{
+    for (auto& row : matrix)
+        row.store(0, std::memory_order_relaxed);
+    resetDefaults();
+}
+
+void CollisionLayers::resetDefaults()
+{
+    names = { "Static", "Dynamic", "Player", "Trigger", "Debris" };
+    for (auto& row : matrix)
+        row.store(0, std::memory_order_relaxed);
+
+    // Static geometry never needs pairs with itself or with triggers
+    setCollides(Static, Dynamic, true);
+    setCollides(Static, Player, true);
+    setCollides(Static, Debris, true);
+
+    setCollides(Dynamic, Dynamic, true);
+    setCollides(Dynamic, Player, true);
+    setCollides(Dynamic, Trigger, true);
+    setCollides(Dynamic, Debris, true);
+
+    setCollides(Player, Player, true);
+    setCollides(Player, Trigger, true);
+
+    // Debris only lands on the world and gets knocked by dynamic bodies
+    version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+const std::string& CollisionLayers::getLayerName(int layer) const
+{
+    static const std::string invalid = "<invalid>";
+    return isValid(layer) ? names[layer] : invalid;
+}
+
+int CollisionLayers::findLayer(const std::string& name) const
+{
+    for (int i = 0; i < getLayerCount(); i++)
+    {
+        if (names[i] == name)
+            return i;
+    }
+    return -1;
+}
+
+int CollisionLayers::addLayer(const std::string& name)
+{
+    int existing = findLayer(name);
+    if (existing >= 0)
+        return existing;
+
+    if (getLayerCount() >= MaxLayers)
+    {
+        std::cerr << "CollisionLayers: can't add '" << name << "', all " << MaxLayers << " layers are in use" << std::endl;
+        return -1;
+    }
+
+    // New layers start out colliding with every existing layer (Bullet's default)
+    int layer = getLayerCount();
+    names.push_back(name);
+    for (int other = 0; other <= layer; other++)
+        setCollides(layer, other, true);
+
+    version.fetch_add(1, std::memory_order_acq_rel);
+    return layer;
+}
+
+bool CollisionLayers::shouldCollide(int layerA, int layerB) const
+{
+    if (!isValid(layerA) || !isValid(layerB))
+        return true;
+    return (matrix[layerA].load(std::memory_order_relaxed) & (1u << layerB)) != 0;
+}
+
+void CollisionLayers::setCollides(int layerA, int layerB, bool collide)
+{
+    if (!isValid(layerA) || !isValid(layerB))
+        return;
+
+    if (collide)
+    {
+        matrix[layerA].fetch_or(1u << layerB, std::memory_order_relaxed);
+        matrix[layerB].fetch_or(1u << layerA, std::memory_order_relaxed);
+    }
+    else
+    {
+        matrix[layerA].fetch_and(~(1u << layerB), std::memory_order_relaxed);
+        matrix[layerB].fetch_and(~(1u << layerA), std::memory_order_relaxed);
+    }
+    version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+int CollisionLayers::getGroup(int layer) const
+{
+    // Objects without a valid layer behave like Bullet's default (collide with all)
+    if (!isValid(layer))
+        return 0x7FFF;
+    return 1 << layer;
+}
+
+int CollisionLayers::getMask(int layer) const
+{
+    if (!isValid(layer))
+        return 0xFFFF;
+    return static_cast<int>(matrix[layer].load(std::memory_order_relaxed)) | QueryGroup;
+}
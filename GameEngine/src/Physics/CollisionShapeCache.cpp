@@ -0,0 +1,126 @@
+#include "../include/Physics/CollisionShapeCache.h"
+#include "../include/Scene/RenderComponent.h"
+#include "../include/Core/Log.h"
+#include <cmath>
+#include <functional>
+
+CollisionShapeCache::~CollisionShapeCache()
+{
+    clear();
+}
+
+size_t CollisionShapeCache::KeyHash::operator()(const Key& key) const
+{
+    size_t h = std::hash<int>()(key.type);
+    h = h * 31 + std::hash<int32_t>()(key.x);
+    h = h * 31 + std::hash<int32_t>()(key.y);
+    h = h * 31 + std::hash<int32_t>()(key.z);
+    return h;
+}
+
+CollisionShapeCache::Key CollisionShapeCache::makeKey(ShapeType type, const glm::vec3& size)
+{
+    auto quantize = [](float value) {
+        return static_cast<int32_t>(std::lround(value / Quantum));
+    };
+
+    // Only the components a shape actually uses take part in the key,
+    // so a sphere of radius r matches regardless of size.y/size.z
+    Key key{ static_cast<int>(type), 0, 0, 0 };
+    switch (type) {
+    case ShapeType::CUBE:
+        key.x = quantize(size.x);
+        key.y = quantize(size.y);
+        key.z = quantize(size.z);
+        break;
+    case ShapeType::SPHERE:
+        key.x = quantize(size.x);
+        break;
+    case ShapeType::CAPSULE:
+        key.x = quantize(size.x);
+        key.y = quantize(size.y);
+        break;
+    default:
+        // Unknown types fall back to a unit cube in createShape()
+        key.type = static_cast<int>(ShapeType::CUBE);
+        key.x = key.y = key.z = quantize(1.0f);
+        break;
+    }
+    return key;
+}
+
+btCollisionShape* CollisionShapeCache::createShape(ShapeType type, const glm::vec3& size)
+{
+    switch (type) {
+    case ShapeType::CUBE:
+        // Bullet uses halfs for box shapes size
+        LOG_DEBUG(LogCategory::Physics, "Created box collider: " << size.x << "x" << size.y << "x" << size.z);
+        return new btBoxShape(btVector3(size.x / 2.0f, size.y / 2.0f, size.z / 2.0f));
+    case ShapeType::SPHERE:
+        // size.x = radius
+        LOG_DEBUG(LogCategory::Physics, "Created sphere collider: radius=" << size.x);
+        return new btSphereShape(size.x);
+    case ShapeType::CAPSULE: {
+        // Total = cylinderHeight + 2*radius, so: cylinderHeight = total - 2*radius
+        float totalHeight = size.y;
+        float cylinderHeight = totalHeight - 2.0f * size.x;
+
+        // Clamp to prevent negative/zero cylinder height
+        if (cylinderHeight < 0.1f) cylinderHeight = 0.1f;
+
+        LOG_DEBUG(LogCategory::Physics, "Created capsule collider: radius=" << size.x);
+        return new btCapsuleShape(size.x, cylinderHeight);
+    }
+    default:
+        LOG_WARN(LogCategory::Physics, "Unknown ShapeType for rigid body creation! defaulting to cube");
+        return new btBoxShape(btVector3(0.5f, 0.5f, 0.5f));
+    }
+}
+
+btCollisionShape* CollisionShapeCache::acquire(ShapeType type, const glm::vec3& size)
+{
+    Key key = makeKey(type, size);
+
+    auto result = entries.try_emplace(key);
+    Entry& entry = result.first->second;
+    if (result.second) {
+        entry.shape = createShape(type, size);
+        entry.key = &result.first->first;
+        entry.shape->setUserPointer(&entry);
+    }
+
+    entry.refCount++;
+    return entry.shape;
+}
+
+void CollisionShapeCache::release(btCollisionShape* shape)
+{
+    if (!shape) return;
+
+    Entry* entry = static_cast<Entry*>(shape->getUserPointer());
+    if (!entry || entry->shape != shape) {
+        LOG_WARN(LogCategory::Physics, "CollisionShapeCache: release of a shape it doesn't own, ignored");
+        return;
+    }
+
+    if (--entry->refCount > 0)
+        return;
+
+    Key key = *entry->key; // copy, erase() destroys the node the key lives in
+    delete shape;
+    entries.erase(key);
+}
+
+void CollisionShapeCache::clear()
+{
+    for (auto& pair : entries)
+        delete pair.second.shape;
+    entries.clear();
+}
+
+int CollisionShapeCache::getReferenceCount(const btCollisionShape* shape) const
+{
+    if (!shape) return 0;
+    const Entry* entry = static_cast<const Entry*>(shape->getUserPointer());
+    return (entry && entry->shape == shape) ? entry->refCount : 0;
+}
@@ -1,5 +1,6 @@
 #include "../include/Physics/ConstraintRegistry.h"
 #include "../include/Scene/GameObject.h"
+#include "../include/Core/Profiler.h"
 #include <iostream>
 #include <algorithm>
 
@@ -48,6 +49,7 @@ Constraint* ConstraintRegistry::addConstraint(std::unique_ptr<Constraint> constr
     // Store the constraint and get raw pointer
     Constraint* rawPtr = constraint.get();
     constraints.push_back(std::move(constraint));
+    version++;
 
     // Update indices
     addToIndices(rawPtr);
@@ -77,6 +79,7 @@ void ConstraintRegistry::removeConstraint(Constraint* constraint) {
 
         // Remove from vector (destroys the constraint)
         constraints.erase(it);
+        version++;
 
         std::cout << "Removed constraint (remaining: " << constraints.size() << ")" << std::endl;
     }
@@ -105,6 +108,7 @@ void ConstraintRegistry::clearAll() {
 
     // Clear all storage
     constraints.clear();
+    version++;
     nameIndex.clear();
     objectIndex.clear();
 
@@ -188,6 +192,7 @@ bool ConstraintRegistry::hasConstraint(const std::string& name) const {
 // Update 
 
 void ConstraintRegistry::update() {
+    PROFILE_SCOPE("ConstraintRegistry::update");
     // Check for broken constraints
     for (auto it = constraints.begin(); it != constraints.end(); ) {
         auto& constraint = *it;
@@ -209,6 +214,7 @@ void ConstraintRegistry::update() {
 
                 // Remove from vector
                 it = constraints.erase(it);
+                version++;
                 continue;
             }
         }
@@ -0,0 +1,180 @@
+#include "../include/Physics/ContactEvents.h"
+#include "../include/Core/Profiler.h"
+#include <algorithm>
+
+namespace
+{
+    glm::vec3 toGlm(const btVector3& v) { return glm::vec3(v.x(), v.y(), v.z()); }
+}
+
+void ContactEvents::collect(btDispatcher& dispatcher)
+{
+    PROFILE_SCOPE("ContactEvents::collect");
+
+    // Before anything new is queued: a removed body's pooled storage may be reused
+    flushForgotten();
+    currentPairs.clear();
+
+    int manifoldCount = dispatcher.getNumManifolds();
+    for (int i = 0; i < manifoldCount; i++) {
+        const btPersistentManifold* manifold = dispatcher.getManifoldByIndexInternal(i);
+        int contactCount = manifold->getNumContacts();
+        if (contactCount == 0) continue;
+
+        const btCollisionObject* body0 = manifold->getBody0();
+        const btCollisionObject* body1 = manifold->getBody1();
+
+        // Trigger ghosts report through Trigger
+        if (!body0->hasContactResponse() || !body1->hasContactResponse()) continue;
+
+        GameObject* object0 = static_cast<GameObject*>(body0->getUserPointer());
+        GameObject* object1 = static_cast<GameObject*>(body1->getUserPointer());
+        if (!object0 && !object1) continue;
+
+        // Only points at or inside the surface touch, manifolds keep points within
+        // the contact breaking threshold. Deepest one stands for the contact, impulses add up.
+        int deepest = -1;
+        float impulse = 0.0f;
+        for (int c = 0; c < contactCount; c++) {
+            const btManifoldPoint& point = manifold->getContactPoint(c);
+            if (point.getDistance() > 0.0f) continue;
+            impulse += point.getAppliedImpulse();
+            if (deepest < 0 || point.getDistance() < manifold->getContactPoint(deepest).getDistance())
+                deepest = c;
+        }
+        if (deepest < 0) continue;
+        const btManifoldPoint& contact = manifold->getContactPoint(deepest);
+
+        PairState pair;
+        pair.point = toGlm(contact.getPositionWorldOnB());
+        pair.normal = toGlm(contact.m_normalWorldOnB);
+        pair.impulse = impulse;
+        pair.distance = contact.getDistance();
+
+        // Sorted key, normal flipped when the bodies swap so it still points B -> A
+        uintptr_t key0 = reinterpret_cast<uintptr_t>(body0);
+        uintptr_t key1 = reinterpret_cast<uintptr_t>(body1);
+        if (key0 < key1) {
+            pair.keyA = key0; pair.objectA = object0;
+            pair.keyB = key1; pair.objectB = object1;
+        }
+        else {
+            pair.keyA = key1; pair.objectA = object1;
+            pair.keyB = key0; pair.objectB = object0;
+            pair.normal = -pair.normal;
+        }
+
+        currentPairs.push_back(pair);
+    }
+
+    std::sort(currentPairs.begin(), currentPairs.end());
+
+    // A pair can own several manifolds (compound shapes), merge them in place
+    if (!currentPairs.empty()) {
+        size_t write = 0;
+        for (size_t read = 1; read < currentPairs.size(); read++) {
+            PairState& kept = currentPairs[write];
+            const PairState& next = currentPairs[read];
+            if (kept.samePair(next)) {
+                kept.impulse += next.impulse;
+                if (next.distance < kept.distance) {
+                    kept.point = next.point;
+                    kept.normal = next.normal;
+                    kept.distance = next.distance;
+                }
+            }
+            else {
+                currentPairs[++write] = next;
+            }
+        }
+        currentPairs.resize(write + 1);
+    }
+
+    // Merge walk over both sorted lists
+    size_t prev = 0;
+    size_t curr = 0;
+    while (prev < previousPairs.size() || curr < currentPairs.size()) {
+        if (curr == currentPairs.size()
+            || (prev < previousPairs.size() && previousPairs[prev] < currentPairs[curr])) {
+            queue(ContactEventType::Exit, previousPairs[prev++]);
+        }
+        else if (prev == previousPairs.size() || currentPairs[curr] < previousPairs[prev]) {
+            queue(ContactEventType::Enter, currentPairs[curr++]);
+        }
+        else {
+            queue(ContactEventType::Stay, currentPairs[curr++]);
+            prev++;
+        }
+    }
+
+    previousPairs.swap(currentPairs);
+}
+
+void ContactEvents::queue(ContactEventType type, const PairState& pair)
+{
+    ContactEvent event;
+    event.type = type;
+    event.objectA = pair.objectA;
+    event.objectB = pair.objectB;
+    event.point = pair.point;
+    event.normal = pair.normal;
+    event.impulse = type == ContactEventType::Exit ? 0.0f : pair.impulse;
+    events.push_back(event);
+}
+
+void ContactEvents::forget(const btCollisionObject* body)
+{
+    if (!body) return;
+
+    forgottenBodies.push_back(reinterpret_cast<uintptr_t>(body));
+
+    // The GameObject may be destroyed right after its body, so keep the pointer now
+    if (GameObject* object = static_cast<GameObject*>(body->getUserPointer()))
+        forgottenObjects.push_back(object);
+}
+
+void ContactEvents::flushForgotten()
+{
+    if (!forgottenBodies.empty()) {
+        std::sort(forgottenBodies.begin(), forgottenBodies.end());
+        auto forgotten = [this](uintptr_t key) {
+            return std::binary_search(forgottenBodies.begin(), forgottenBodies.end(), key);
+        };
+
+        // One pass however many bodies went, erase keeps previousPairs sorted
+        previousPairs.erase(
+            std::remove_if(previousPairs.begin(), previousPairs.end(),
+                [&forgotten](const PairState& pair) { return forgotten(pair.keyA) || forgotten(pair.keyB); }),
+            previousPairs.end());
+        forgottenBodies.clear();
+    }
+
+    if (!forgottenObjects.empty()) {
+        std::sort(forgottenObjects.begin(), forgottenObjects.end());
+        auto forgotten = [this](GameObject* object) {
+            return object && std::binary_search(forgottenObjects.begin(), forgottenObjects.end(), object);
+        };
+
+        events.erase(
+            std::remove_if(events.begin(), events.end(),
+                [&forgotten](const ContactEvent& event) { return forgotten(event.objectA) || forgotten(event.objectB); }),
+            events.end());
+        forgottenObjects.clear();
+    }
+}
+
+void ContactEvents::takeEvents(std::vector<ContactEvent>& out)
+{
+    flushForgotten();
+    out.clear();
+    out.swap(events);
+}
+
+void ContactEvents::clear()
+{
+    previousPairs.clear();
+    currentPairs.clear();
+    events.clear();
+    forgottenBodies.clear();
+    forgottenObjects.clear();
+}
@@ -0,0 +1,476 @@
+#include "../include/Physics/DynamicAABBTree.h"
+#include "../include/Scene/GameObject.h"
+#include <iostream>
+#include <algorithm>
+
+DynamicAABBTree::DynamicAABBTree(float fatMargin) : fatMargin(fatMargin) {
+    if (fatMargin < 0.0f) {
+        std::cerr << "Warning: Invalid AABB tree margin, using default 0.25f" << std::endl;
+        this->fatMargin = 0.25f;
+    }
+}
+
+int32_t DynamicAABBTree::allocateNode() {
+    int32_t node;
+    if (freeList != NoNode) {
+        node = freeList;
+        freeList = nodes[node].parent;
+        nodes[node] = Node();
+    }
+    else {
+        node = static_cast<int32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+    nodeCount++;
+    return node;
+}
+
+void DynamicAABBTree::freeNode(int32_t node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+    nodeCount--;
+}
+
+void DynamicAABBTree::setFatBox(int32_t leaf, uint32_t index) {
+    glm::vec3 reach = halfExtents[index] + glm::vec3(fatMargin);
+    nodes[leaf].min = positions[index] - reach;
+    nodes[leaf].max = positions[index] + reach;
+}
+
+void DynamicAABBTree::insertLeaf(int32_t leaf) {
+    if (root == NoNode) {
+        root = leaf;
+        nodes[leaf].parent = NoNode;
+        return;
+    }
+
+    // Walk down towards the sibling that adds the least surface area. Going
+    // deeper always costs at least the growth of the current node's box.
+    glm::vec3 leafMin = nodes[leaf].min;
+    glm::vec3 leafMax = nodes[leaf].max;
+    int32_t index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        float area = surfaceArea(node.min, node.max);
+        float combinedArea = surfaceArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+        // Cost of pairing the leaf with this node under a new parent
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t childIndex) {
+            const Node& child = nodes[childIndex];
+            float enlarged = surfaceArea(glm::min(child.min, leafMin), glm::max(child.max, leafMax));
+            if (child.isLeaf())
+                return enlarged + inheritanceCost;
+            return enlarged - surfaceArea(child.min, child.max) + inheritanceCost;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    int32_t sibling = index;
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t newParent = allocateNode();
+
+    Node& parentNode = nodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+    parentNode.height = nodes[sibling].height + 1;
+    setUnion(parentNode, nodes[sibling], nodes[leaf]);
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != NoNode) {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else {
+        root = newParent;
+    }
+
+    refitUpwards(newParent);
+}
+
+void DynamicAABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = NoNode;
+        return;
+    }
+
+    // The sibling takes the parent's place
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandParent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent != NoNode) {
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        freeNode(parent);
+        refitUpwards(grandParent);
+    }
+    else {
+        root = sibling;
+        nodes[sibling].parent = NoNode;
+        freeNode(parent);
+    }
+}
+
+void DynamicAABBTree::refitUpwards(int32_t index) {
+    while (index != NoNode) {
+        index = balance(index);
+
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        setUnion(node, child1, child2);
+
+        index = node.parent;
+    }
+}
+
+int32_t DynamicAABBTree::balance(int32_t iA) {
+    Node* A = &nodes[iA];
+    if (A->isLeaf() || A->height < 2)
+        return iA;
+
+    int32_t iB = A->child1;
+    int32_t iC = A->child2;
+    Node* B = &nodes[iB];
+    Node* C = &nodes[iC];
+    int32_t heightDiff = C->height - B->height;
+
+    // C is too tall: C takes A's place and A keeps the shorter of C's children
+    if (heightDiff > 1) {
+        int32_t iF = C->child1;
+        int32_t iG = C->child2;
+        Node* F = &nodes[iF];
+        Node* G = &nodes[iG];
+
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+        if (C->parent != NoNode) {
+            if (nodes[C->parent].child1 == iA)
+                nodes[C->parent].child1 = iC;
+            else
+                nodes[C->parent].child2 = iC;
+        }
+        else {
+            root = iC;
+        }
+
+        if (F->height > G->height) {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            setUnion(*A, *B, *G);
+            setUnion(*C, *A, *F);
+            A->height = 1 + std::max(B->height, G->height);
+            C->height = 1 + std::max(A->height, F->height);
+        }
+        else {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            setUnion(*A, *B, *F);
+            setUnion(*C, *A, *G);
+            A->height = 1 + std::max(B->height, F->height);
+            C->height = 1 + std::max(A->height, G->height);
+        }
+        return iC;
+    }
+
+    // B is too tall: the mirror image
+    if (heightDiff < -1) {
+        int32_t iD = B->child1;
+        int32_t iE = B->child2;
+        Node* D = &nodes[iD];
+        Node* E = &nodes[iE];
+
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+        if (B->parent != NoNode) {
+            if (nodes[B->parent].child1 == iA)
+                nodes[B->parent].child1 = iB;
+            else
+                nodes[B->parent].child2 = iB;
+        }
+        else {
+            root = iB;
+        }
+
+        if (D->height > E->height) {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            setUnion(*A, *C, *E);
+            setUnion(*B, *A, *D);
+            A->height = 1 + std::max(C->height, E->height);
+            B->height = 1 + std::max(A->height, D->height);
+        }
+        else {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            setUnion(*A, *C, *D);
+            setUnion(*B, *A, *E);
+            A->height = 1 + std::max(C->height, D->height);
+            B->height = 1 + std::max(A->height, E->height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void DynamicAABBTree::insertObject(GameObject* obj) {
+    if (!obj) return;
+    if (objectIndex.find(obj) != objectIndex.NotFound) return; // Already inserted
+
+    uint32_t index = static_cast<uint32_t>(objects.size());
+    objects.push_back(obj);
+    positions.push_back(obj->getPosition());
+    halfExtents.push_back(obj->getScale() * 0.5f);
+    objectIndex.set(obj, index);
+
+    int32_t leaf = allocateNode();
+    nodes[leaf].object = index;
+    setFatBox(leaf, index);
+    objectLeaf.push_back(leaf);
+    insertLeaf(leaf);
+}
+
+void DynamicAABBTree::removeObject(GameObject* obj) {
+    if (!obj) return;
+
+    uint32_t index = objectIndex.find(obj);
+    if (index == objectIndex.NotFound) return; // Not in tree
+
+    int32_t leaf = objectLeaf[index];
+    removeLeaf(leaf);
+    freeNode(leaf);
+
+    // Swap-and-pop: the last object takes the freed index
+    uint32_t last = static_cast<uint32_t>(objects.size() - 1);
+    if (index != last) {
+        objects[index] = objects[last];
+        positions[index] = positions[last];
+        halfExtents[index] = halfExtents[last];
+        objectLeaf[index] = objectLeaf[last];
+        nodes[objectLeaf[index]].object = index;
+        objectIndex.set(objects[index], index);
+    }
+
+    objects.pop_back();
+    positions.pop_back();
+    halfExtents.pop_back();
+    objectLeaf.pop_back();
+    objectIndex.erase(obj);
+}
+
+void DynamicAABBTree::updateObject(GameObject* obj) {
+    if (!obj) return;
+
+    uint32_t index = objectIndex.find(obj);
+    if (index == objectIndex.NotFound) {
+        insertObject(obj); // Not in tree yet
+        return;
+    }
+
+    glm::vec3 position = obj->getPosition();
+    glm::vec3 halfExtent = obj->getScale() * 0.5f;
+    positions[index] = position;
+    halfExtents[index] = halfExtent;
+
+    // Still inside its fat box, and the box isn't left oversized by a shrink
+    int32_t leaf = objectLeaf[index];
+    const Node& node = nodes[leaf];
+    glm::vec3 boxMin = position - halfExtent;
+    glm::vec3 boxMax = position + halfExtent;
+    glm::vec3 slack = (node.max - node.min) - (halfExtent * 2.0f + glm::vec3(fatMargin * 4.0f));
+    bool inside = boxMin.x >= node.min.x && boxMin.y >= node.min.y && boxMin.z >= node.min.z
+        && boxMax.x <= node.max.x && boxMax.y <= node.max.y && boxMax.z <= node.max.z;
+    if (inside && slack.x <= 0.0f && slack.y <= 0.0f && slack.z <= 0.0f)
+        return;
+
+    removeLeaf(leaf);
+    setFatBox(leaf, index);
+    insertLeaf(leaf);
+}
+
+void DynamicAABBTree::clear() {
+    nodes.clear();
+    root = NoNode;
+    freeList = NoNode;
+    nodeCount = 0;
+
+    objects.clear();
+    positions.clear();
+    halfExtents.clear();
+    objectLeaf.clear();
+    objectIndex.clear();
+}
+
+float DynamicAABBTree::distSquaredToNode(const Node& node, const glm::vec3& point) const {
+    glm::vec3 outside = glm::max(glm::max(node.min - point, point - node.max), glm::vec3(0.0f));
+    return glm::dot(outside, outside);
+}
+
+template <typename Visit, typename Bound>
+void DynamicAABBTree::forEachNearestFirst(const glm::vec3& position, Visit&& visit, Bound&& bound) const {
+    if (root == NoNode) return;
+
+    nodeStack.clear();
+    nodeStack.push_back(root);
+    while (!nodeStack.empty()) {
+        const Node& node = nodes[nodeStack.back()];
+        nodeStack.pop_back();
+
+        // A fat box holds the object's position, an inner box all of its leaves
+        if (distSquaredToNode(node, position) > bound()) continue;
+
+        if (node.isLeaf()) {
+            glm::vec3 diff = positions[node.object] - position;
+            float distSquared = glm::dot(diff, diff);
+            if (distSquared <= bound())
+                visit(node.object, distSquared);
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is searched next
+        float dist1 = distSquaredToNode(nodes[node.child1], position);
+        float dist2 = distSquaredToNode(nodes[node.child2], position);
+        if (dist1 <= dist2) {
+            nodeStack.push_back(node.child2);
+            nodeStack.push_back(node.child1);
+        }
+        else {
+            nodeStack.push_back(node.child1);
+            nodeStack.push_back(node.child2);
+        }
+    }
+}
+
+std::vector<GameObject*> DynamicAABBTree::queryRadius(
+    const glm::vec3& center,
+    float radius,
+    std::function<bool(GameObject*)> filter) const
+{
+    std::vector<GameObject*> results;
+    float radiusSquared = radius * radius;
+
+    forEachNearestFirst(center,
+        [&](uint32_t index, float) {
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            results.push_back(obj);
+        },
+        [radiusSquared]() { return radiusSquared; });
+
+    return results;
+}
+
+GameObject* DynamicAABBTree::queryNearest(
+    const glm::vec3& position,
+    float maxRadius,
+    std::function<bool(GameObject*)> filter) const
+{
+    GameObject* nearest = nullptr;
+    float minDistSquared = maxRadius * maxRadius;
+
+    forEachNearestFirst(position,
+        [&](uint32_t index, float distSquared) {
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            minDistSquared = distSquared;
+            nearest = obj;
+        },
+        [&]() { return minDistSquared; });
+
+    return nearest;
+}
+
+void DynamicAABBTree::queryKNearest(
+    const glm::vec3& position,
+    int k,
+    float maxRadius,
+    std::vector<GameObject*>& out,
+    std::function<bool(GameObject*)> filter) const
+{
+    out.clear();
+    if (k <= 0) return;
+
+    float maxRadiusSquared = maxRadius * maxRadius;
+    nearestCandidates.reset(static_cast<size_t>(k));
+
+    forEachNearestFirst(position,
+        [&](uint32_t index, float distSquared) {
+            if (!nearestCandidates.wants(distSquared)) return;
+
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            nearestCandidates.add(distSquared, index);
+        },
+        [&]() { return nearestCandidates.bound(maxRadiusSquared); });
+
+    const auto& closest = nearestCandidates.sortClosestFirst();
+    out.reserve(closest.size());
+    for (const auto& candidate : closest)
+        out.push_back(objects[candidate.second]);
+}
+
+void DynamicAABBTree::queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const {
+    out.clear();
+    if (root == NoNode) return;
+
+    nodeStack.clear();
+    nodeStack.push_back(root);
+    while (!nodeStack.empty()) {
+        const Node& node = nodes[nodeStack.back()];
+        nodeStack.pop_back();
+
+        if (node.min.x > max.x || node.max.x < min.x
+            || node.min.y > max.y || node.max.y < min.y
+            || node.min.z > max.z || node.max.z < min.z)
+            continue;
+
+        if (!node.isLeaf()) {
+            nodeStack.push_back(node.child1);
+            nodeStack.push_back(node.child2);
+            continue;
+        }
+
+        // The fat box overlaps, test the object's own box
+        uint32_t index = node.object;
+        glm::vec3 boxMin = positions[index] - halfExtents[index];
+        glm::vec3 boxMax = positions[index] + halfExtents[index];
+        if (boxMin.x > max.x || boxMax.x < min.x
+            || boxMin.y > max.y || boxMax.y < min.y
+            || boxMin.z > max.z || boxMax.z < min.z)
+            continue;
+        out.push_back(objects[index]);
+    }
+}
+
+void DynamicAABBTree::printStats() const {
+    std::cout << "=== Dynamic AABB Tree ===" << std::endl;
+    std::cout << "Fat margin: " << fatMargin << " units" << std::endl;
+    std::cout << "Objects: " << objects.size() << std::endl;
+    std::cout << "Nodes: " << nodeCount << std::endl;
+    std::cout << "Height: " << getHeight() << std::endl;
+    std::cout << "====================" << std::endl;
+}
@@ -1,5 +1,7 @@
 #include "../include/Physics/ForceGeneratorRegistry.h"
 #include "../include/Physics/ForceGenerator.h"
+#include "../include/Core/Profiler.h"
+#include "../include/Core/Log.h"
 #include <iostream>
 #include <algorithm>
 
@@ -37,8 +39,8 @@ ForceGenerator* ForceGeneratorRegistry::addGenerator(std::unique_ptr<ForceGenera
     ForceGenerator* ptr = generator.get();
     generators.push_back(std::move(generator));
 
-    std::cout << "[ForceGeneratorRegistry] Added '" << ptr->getName()
-        << "' (total: " << generators.size() << ")" << std::endl;
+    LOG_DEBUG(LogCategory::Physics, "[ForceGeneratorRegistry] Added '" << ptr->getName()
+        << "' (total: " << generators.size() << ")");
 
     return ptr;
 }
@@ -54,7 +56,7 @@ void ForceGeneratorRegistry::removeGenerator(ForceGenerator* generator)
 
     if (it != generators.end())
     {
-        std::cout << "[ForceGeneratorRegistry] Removed '" << (*it)->getName() << "'" << std::endl;
+        LOG_DEBUG(LogCategory::Physics, "[ForceGeneratorRegistry] Removed '" << (*it)->getName() << "'");
         generators.erase(it);
     }
 }
@@ -118,6 +120,7 @@ ForceGenerator* ForceGeneratorRegistry::createExplosion(const std::string& name,
 // update method to apply all active generators to all rigid bodies in the world, then remove expired generators
 void ForceGeneratorRegistry::update(float deltaTime)
 {
+    PROFILE_SCOPE("ForceGeneratorRegistry::update");
     if (!dynamicsWorld) return;
 
     // Iterate every collision object in the physics world
@@ -0,0 +1,405 @@
+#include "../include/Physics/LooseOctree.h"
+#include "../include/Scene/GameObject.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+LooseOctree::LooseOctree(float minNodeSize, float initialRootSize)
+    : minNodeSize(minNodeSize), initialRootSize(initialRootSize) {
+    if (minNodeSize <= 0.0f) {
+        std::cerr << "Warning: Invalid octree node size, using default 1.0f" << std::endl;
+        this->minNodeSize = 1.0f;
+    }
+    if (initialRootSize < this->minNodeSize)
+        this->initialRootSize = this->minNodeSize;
+}
+
+int32_t LooseOctree::createChildren(int32_t parent) {
+    int32_t block;
+    if (!freeBlocks.empty()) {
+        block = freeBlocks.back();
+        freeBlocks.pop_back();
+    }
+    else {
+        block = static_cast<int32_t>(nodes.size());
+        nodes.resize(nodes.size() + 8);
+    }
+
+    const Node& owner = nodes[parent];
+    float childHalf = owner.halfSize * 0.5f;
+    for (int octant = 0; octant < 8; ++octant) {
+        Node& child = nodes[block + octant];
+        child.center = owner.center + glm::vec3(
+            (octant & 1) ? childHalf : -childHalf,
+            (octant & 2) ? childHalf : -childHalf,
+            (octant & 4) ? childHalf : -childHalf);
+        child.halfSize = childHalf;
+        child.parent = parent;
+        child.firstChild = NoNode;
+        child.objects.clear();
+    }
+    nodes[parent].firstChild = block;
+    return block;
+}
+
+void LooseOctree::growRootToFit(const glm::vec3& position, float extent) {
+    // A NaN or infinite position can't be reached by doubling, it stays at the root
+    bool finite = std::isfinite(position.x) && std::isfinite(position.y) && std::isfinite(position.z) && std::isfinite(extent);
+
+    if (root == NoNode) {
+        root = static_cast<int32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes[root].center = finite ? position : glm::vec3(0.0f);
+        nodes[root].halfSize = initialRootSize * 0.5f;
+    }
+
+    while (finite) {
+        const Node& current = nodes[root];
+        glm::vec3 offset = position - current.center;
+        if (std::abs(offset.x) <= current.halfSize && std::abs(offset.y) <= current.halfSize
+            && std::abs(offset.z) <= current.halfSize && extent <= current.halfSize)
+            return;
+
+        // The old root becomes the octant of a root twice its size that faces the position.
+        // The root keeps its node index, its contents move down into the new block.
+        glm::vec3 direction(offset.x >= 0.0f ? 1.0f : -1.0f, offset.y >= 0.0f ? 1.0f : -1.0f, offset.z >= 0.0f ? 1.0f : -1.0f);
+        glm::vec3 oldCenter = current.center;
+        float oldHalf = current.halfSize;
+        int32_t oldChildren = current.firstChild;
+
+        nodes[root].center = oldCenter + direction * oldHalf;
+        nodes[root].halfSize = oldHalf * 2.0f;
+        int32_t block = createChildren(root);
+        int32_t moved = block + octantOf(nodes[root], oldCenter);
+
+        Node& slot = nodes[moved];
+        slot.center = oldCenter;
+        slot.firstChild = oldChildren;
+        slot.objects.swap(nodes[root].objects);
+        for (uint32_t index : slot.objects)
+            objectNode[index] = moved;
+        if (oldChildren != NoNode)
+            for (int octant = 0; octant < 8; ++octant)
+                nodes[oldChildren + octant].parent = moved;
+    }
+}
+
+int32_t LooseOctree::findNode(const glm::vec3& position, float extent) {
+    growRootToFit(position, extent);
+
+    int32_t n = root;
+    for (;;) {
+        float childHalf = nodes[n].halfSize * 0.5f;
+        if (extent > childHalf || childHalf * 2.0f < minNodeSize)
+            return n;
+
+        if (nodes[n].firstChild == NoNode)
+            createChildren(n);
+        n = nodes[n].firstChild + octantOf(nodes[n], position);
+    }
+}
+
+bool LooseOctree::staysInNode(int32_t n, const glm::vec3& position, float extent) const {
+    const Node& node = nodes[n];
+    glm::vec3 offset = position - node.center;
+    if (std::abs(offset.x) > node.halfSize || std::abs(offset.y) > node.halfSize
+        || std::abs(offset.z) > node.halfSize || extent > node.halfSize)
+        return false;
+
+    // Also has to be as deep as it can go
+    float childHalf = node.halfSize * 0.5f;
+    return extent > childHalf || childHalf * 2.0f < minNodeSize;
+}
+
+void LooseOctree::attach(uint32_t index, int32_t node) {
+    objectNode[index] = node;
+    objectSlot[index] = static_cast<uint32_t>(nodes[node].objects.size());
+    nodes[node].objects.push_back(index);
+}
+
+void LooseOctree::detach(uint32_t index) {
+    std::vector<uint32_t>& list = nodes[objectNode[index]].objects;
+    uint32_t slot = objectSlot[index];
+    uint32_t last = list.back();
+    list[slot] = last;
+    objectSlot[last] = slot;
+    list.pop_back();
+}
+
+void LooseOctree::pruneEmpty(int32_t n) {
+    while (n != NoNode) {
+        const Node& node = nodes[n];
+        int32_t parent = node.parent;
+        if (parent == NoNode || !node.objects.empty() || node.firstChild != NoNode)
+            return;
+
+        // Only whole blocks are freed, every sibling has to be empty too
+        int32_t block = nodes[parent].firstChild;
+        for (int octant = 0; octant < 8; ++octant) {
+            const Node& sibling = nodes[block + octant];
+            if (!sibling.objects.empty() || sibling.firstChild != NoNode)
+                return;
+        }
+        nodes[parent].firstChild = NoNode;
+        freeBlocks.push_back(block);
+        n = parent;
+    }
+}
+
+void LooseOctree::insertObject(GameObject* obj) {
+    if (!obj) return;
+    if (objectIndex.find(obj) != objectIndex.NotFound) return; // Already inserted
+
+    uint32_t index = static_cast<uint32_t>(objects.size());
+    glm::vec3 position = obj->getPosition();
+    glm::vec3 halfExtent = obj->getScale() * 0.5f;
+
+    objects.push_back(obj);
+    positions.push_back(position);
+    halfExtents.push_back(halfExtent);
+    objectNode.push_back(NoNode);
+    objectSlot.push_back(0);
+    objectIndex.set(obj, index);
+
+    attach(index, findNode(position, largestExtent(halfExtent)));
+}
+
+void LooseOctree::removeObject(GameObject* obj) {
+    if (!obj) return;
+
+    uint32_t index = objectIndex.find(obj);
+    if (index == objectIndex.NotFound) return; // Not in tree
+
+    int32_t node = objectNode[index];
+    detach(index);
+
+    // Swap-and-pop: the last object takes the freed index
+    uint32_t last = static_cast<uint32_t>(objects.size() - 1);
+    if (index != last) {
+        objects[index] = objects[last];
+        positions[index] = positions[last];
+        halfExtents[index] = halfExtents[last];
+        objectNode[index] = objectNode[last];
+        objectSlot[index] = objectSlot[last];
+        nodes[objectNode[index]].objects[objectSlot[index]] = index;
+        objectIndex.set(objects[index], index);
+    }
+
+    objects.pop_back();
+    positions.pop_back();
+    halfExtents.pop_back();
+    objectNode.pop_back();
+    objectSlot.pop_back();
+    objectIndex.erase(obj);
+
+    pruneEmpty(node);
+}
+
+void LooseOctree::updateObject(GameObject* obj) {
+    if (!obj) return;
+
+    uint32_t index = objectIndex.find(obj);
+    if (index == objectIndex.NotFound) {
+        insertObject(obj); // Not in tree yet
+        return;
+    }
+
+    glm::vec3 position = obj->getPosition();
+    glm::vec3 halfExtent = obj->getScale() * 0.5f;
+    positions[index] = position;
+    halfExtents[index] = halfExtent;
+
+    int32_t node = objectNode[index];
+    float extent = largestExtent(halfExtent);
+    if (staysInNode(node, position, extent)) return;
+
+    detach(index);
+    attach(index, findNode(position, extent));
+    pruneEmpty(node);
+}
+
+void LooseOctree::clear() {
+    nodes.clear();
+    freeBlocks.clear();
+    root = NoNode;
+
+    objects.clear();
+    positions.clear();
+    halfExtents.clear();
+    objectNode.clear();
+    objectSlot.clear();
+    objectIndex.clear();
+}
+
+float LooseOctree::distSquaredToNode(const Node& node, const glm::vec3& point) const {
+    glm::vec3 outside = glm::max(glm::abs(point - node.center) - glm::vec3(node.halfSize), glm::vec3(0.0f));
+    return glm::dot(outside, outside);
+}
+
+template <typename Visit, typename Bound>
+void LooseOctree::forEachNearestFirst(const glm::vec3& position, Visit&& visit, Bound&& bound) const {
+    if (root == NoNode) return;
+
+    nodeStack.clear();
+    nodeStack.push_back(root);
+    while (!nodeStack.empty()) {
+        const Node& node = nodes[nodeStack.back()];
+        nodeStack.pop_back();
+
+        // Every position stored at or below a node lies in its tight cube
+        if (distSquaredToNode(node, position) > bound()) continue;
+
+        for (uint32_t index : node.objects) {
+            glm::vec3 diff = positions[index] - position;
+            float distSquared = glm::dot(diff, diff);
+            if (distSquared <= bound())
+                visit(index, distSquared);
+        }
+
+        if (node.firstChild == NoNode) continue;
+
+        // Push the farthest child first so the nearest one is searched next
+        std::pair<float, int32_t> children[8];
+        int count = 0;
+        for (int octant = 0; octant < 8; ++octant) {
+            int32_t child = node.firstChild + octant;
+            const Node& childNode = nodes[child];
+            if (childNode.objects.empty() && childNode.firstChild == NoNode) continue;
+
+            float distSquared = distSquaredToNode(childNode, position);
+            if (distSquared <= bound())
+                children[count++] = { distSquared, child };
+        }
+        std::sort(children, children + count,
+            [](const std::pair<float, int32_t>& a, const std::pair<float, int32_t>& b) { return a.first > b.first; });
+        for (int i = 0; i < count; ++i)
+            nodeStack.push_back(children[i].second);
+    }
+}
+
+std::vector<GameObject*> LooseOctree::queryRadius(
+    const glm::vec3& center,
+    float radius,
+    std::function<bool(GameObject*)> filter) const
+{
+    std::vector<GameObject*> results;
+    float radiusSquared = radius * radius;
+
+    forEachNearestFirst(center,
+        [&](uint32_t index, float) {
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            results.push_back(obj);
+        },
+        [radiusSquared]() { return radiusSquared; });
+
+    return results;
+}
+
+GameObject* LooseOctree::queryNearest(
+    const glm::vec3& position,
+    float maxRadius,
+    std::function<bool(GameObject*)> filter) const
+{
+    GameObject* nearest = nullptr;
+    float minDistSquared = maxRadius * maxRadius;
+
+    forEachNearestFirst(position,
+        [&](uint32_t index, float distSquared) {
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            minDistSquared = distSquared;
+            nearest = obj;
+        },
+        [&]() { return minDistSquared; });
+
+    return nearest;
+}
+
+void LooseOctree::queryKNearest(
+    const glm::vec3& position,
+    int k,
+    float maxRadius,
+    std::vector<GameObject*>& out,
+    std::function<bool(GameObject*)> filter) const
+{
+    out.clear();
+    if (k <= 0) return;
+
+    float maxRadiusSquared = maxRadius * maxRadius;
+    nearestCandidates.reset(static_cast<size_t>(k));
+
+    forEachNearestFirst(position,
+        [&](uint32_t index, float distSquared) {
+            if (!nearestCandidates.wants(distSquared)) return;
+
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            nearestCandidates.add(distSquared, index);
+        },
+        [&]() { return nearestCandidates.bound(maxRadiusSquared); });
+
+    const auto& closest = nearestCandidates.sortClosestFirst();
+    out.reserve(closest.size());
+    for (const auto& candidate : closest)
+        out.push_back(objects[candidate.second]);
+}
+
+void LooseOctree::queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const {
+    out.clear();
+    if (root == NoNode) return;
+
+    nodeStack.clear();
+    nodeStack.push_back(root);
+    while (!nodeStack.empty()) {
+        const Node& node = nodes[nodeStack.back()];
+        nodeStack.pop_back();
+
+        // Boxes stored at or below a node stay inside its loose cube
+        glm::vec3 loose(node.halfSize * 2.0f);
+        glm::vec3 looseMin = node.center - loose;
+        glm::vec3 looseMax = node.center + loose;
+        if (looseMin.x > max.x || looseMax.x < min.x
+            || looseMin.y > max.y || looseMax.y < min.y
+            || looseMin.z > max.z || looseMax.z < min.z)
+            continue;
+
+        for (uint32_t index : node.objects) {
+            glm::vec3 boxMin = positions[index] - halfExtents[index];
+            glm::vec3 boxMax = positions[index] + halfExtents[index];
+            if (boxMin.x > max.x || boxMax.x < min.x
+                || boxMin.y > max.y || boxMax.y < min.y
+                || boxMin.z > max.z || boxMax.z < min.z)
+                continue;
+            out.push_back(objects[index]);
+        }
+
+        if (node.firstChild != NoNode)
+            for (int octant = 0; octant < 8; ++octant)
+                nodeStack.push_back(node.firstChild + octant);
+    }
+}
+
+void LooseOctree::printStats() const {
+    std::cout << "=== Loose Octree ===" << std::endl;
+    std::cout << "Smallest node: " << minNodeSize << " units" << std::endl;
+    std::cout << "Objects: " << objects.size() << std::endl;
+    std::cout << "Nodes: " << getNodeCount() << std::endl;
+
+    if (root != NoNode) {
+        std::cout << "Root size: " << nodes[root].halfSize * 2.0f << " units" << std::endl;
+
+        size_t maxInNode = 0;
+        int maxDepth = 0;
+        for (uint32_t index = 0; index < objects.size(); ++index) {
+            int depth = 0;
+            for (int32_t n = objectNode[index]; nodes[n].parent != NoNode; n = nodes[n].parent)
+                depth++;
+            maxDepth = std::max(maxDepth, depth);
+            maxInNode = std::max(maxInNode, nodes[objectNode[index]].objects.size());
+        }
+        std::cout << "Deepest object: " << maxDepth << " levels below the root" << std::endl;
+        std::cout << "Max in one node: " << maxInNode << std::endl;
+    }
+    std::cout << "====================" << std::endl;
+}
@@ -4,14 +4,40 @@
 #include "../include/Physics/ConstraintRegistry.h"
 #include "../include/Physics/PhysicsQuery.h"
 #include "../include/Physics/TriggerRegistry.h" 
+#include "../include/Core/Profiler.h"
+#include "../include/Core/Log.h"
+#include "../include/Core/ThreadPool.h"
+#include "../include/Physics/CollisionLayers.h"
+#include <LinearMath/btThreads.h>
+#include <algorithm>
 #include <iostream>
 
+#ifdef ENGINE_BULLET_MT
+#include "../include/Physics/BulletTaskScheduler.h"
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
+
+namespace {
+    // Threads one Bullet loop can be split across, 1 without the multithreaded world
+    int maxLoopThreads(const btITaskScheduler* scheduler) {
+#ifdef ENGINE_BULLET_MT
+        if (scheduler)
+            return static_cast<const BulletTaskScheduler*>(scheduler)->getMaxLoopThreads();
+#endif
+        (void)scheduler;
+        return 1;
+    }
+}
+
 
 Physics::Physics(): 
     collisionConfiguration(nullptr), 
     dispatcher(nullptr), 
     broadphase(nullptr),
     solver(nullptr),
+    solverMt(nullptr),
     dynamicsWorld(nullptr)
 {
 }
@@ -26,33 +52,77 @@ void Physics::initialize() {
     // Initialize material registry
     MaterialRegistry::getInstance().initializeDefaults();
 
-	//create collision configuration, default memory and collision setup
-    collisionConfiguration = new btDefaultCollisionConfiguration();
-
-
-    //2 phase pipeline, broadphase and narrowphase
-    //create collision dispatcher
-    dispatcher = new btCollisionDispatcher(collisionConfiguration);
-    //create general purpose broadphase 
-    broadphase = new btDbvtBroadphase();
-
-
-    //create constraint solver for contact resolution(doesnt use pararrel proccesing)
-    solver = new btSequentialImpulseConstraintSolver();
-
-    //create the dynamics world 
-    dynamicsWorld = new btDiscreteDynamicsWorld(
-        dispatcher,
-        broadphase,
-        solver,
-        collisionConfiguration
-    );
+#ifdef ENGINE_BULLET_MT
+    if (multithreaded) {
+        // Bullet's parallel loops run on the engine pool (no-op if already started)
+        ThreadPool& pool = ThreadPool::getInstance();
+        pool.initialize();
+        taskScheduler = new BulletTaskScheduler(pool);
+        btSetTaskScheduler(taskScheduler);
+
+        // Pools sized up front, the Mt dispatcher allocates from them on several threads
+        btDefaultCollisionConstructionInfo cci;
+        cci.m_defaultMaxPersistentManifoldPoolSize = 80000;
+        cci.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+        collisionConfiguration = new btDefaultCollisionConfiguration(cci);
+
+        //narrowphase pairs are processed in parallel batches. Its per-thread manifold
+        //arrays are sized from getNumThreads() here, which the scheduler starts at
+        //getMaxNumThreads() (workers + both stepping threads)
+        dispatcher = new btCollisionDispatcherMt(collisionConfiguration, 40);
+        broadphase = new btDbvtBroadphase();
+
+        //one solver per thread for small islands, a batched solver for large ones
+        //(sized for every thread that can step the world, see BulletTaskScheduler)
+        solver = new btConstraintSolverPoolMt(taskScheduler->getMaxNumThreads());
+        solverMt = new btSequentialImpulseConstraintSolverMt();
+
+        dynamicsWorld = new btDiscreteDynamicsWorldMt(
+            dispatcher,
+            broadphase,
+            static_cast<btConstraintSolverPoolMt*>(solver),
+            solverMt,
+            collisionConfiguration
+        );
+
+        // Everything sized by thread index exists, split loops over workers + the stepping thread
+        taskScheduler->setNumThreads(maxLoopThreads(taskScheduler));
+
+        std::cout << "Multithreaded physics world (" << taskScheduler->getNumThreads() << " threads)" << std::endl;
+    }
+    else
+#endif
+    {
+        //create collision configuration, default memory and collision setup
+        collisionConfiguration = new btDefaultCollisionConfiguration();
+
+
+        //2 phase pipeline, broadphase and narrowphase
+        //create collision dispatcher
+        dispatcher = new btCollisionDispatcher(collisionConfiguration);
+        //create general purpose broadphase 
+        broadphase = new btDbvtBroadphase();
+
+
+        //create constraint solver for contact resolution(doesnt use pararrel proccesing, see setMultithreaded)
+        solver = new btSequentialImpulseConstraintSolver();
+
+        //create the dynamics world 
+        dynamicsWorld = new btDiscreteDynamicsWorld(
+            dispatcher,
+            broadphase,
+            solver,
+            collisionConfiguration
+        );
+    }
 
     //Set gravity (9.8 m/s² downward)
     dynamicsWorld->setGravity(btVector3(0, -9.8, 0));
 
     std::cout << "Physics world created with gravity: (0, -1.8, 0)" << std::endl;
 
+    appliedLayerVersion = CollisionLayers::getInstance().getVersion();
+
     querySystem = std::make_unique<PhysicsQuery>(dynamicsWorld);  
     // Initialize constraint registry with our dynamics world
     ConstraintRegistry::getInstance().initialize(dynamicsWorld);
@@ -75,40 +145,8 @@ btRigidBody* Physics::createRigidBody(
     float mass,
     const std::string& materialName)
 {
-    btCollisionShape* shape = nullptr;
-
-    // Create collision shape
-    switch (type) {
-    case ShapeType::CUBE:
-        // Bullet uses halfs for box shapes size
-        shape = new btBoxShape(btVector3(size.x / 2.0f, size.y / 2.0f, size.z / 2.0f));
-        std::cout << "Created box collider: " << size.x << "x" << size.y << "x" << size.z << std::endl;
-        break;
-    case ShapeType::SPHERE:
-        // size.x = radius
-        shape = new btSphereShape(size.x);
-        std::cout << "Created sphere collider: radius=" << size.x << std::endl;
-        break;
-    case ShapeType::CAPSULE:{
-        // Total = cylinderHeight + 2*radius, so: cylinderHeight = total - 2*radius
-        float totalHeight = size.y;
-        float cylinderHeight = totalHeight - 2.0f * size.x;
-
-        // Clamp to prevent negative/zero cylinder height
-        if (cylinderHeight < 0.1f) cylinderHeight = 0.1f;
-
-        shape = new btCapsuleShape(size.x, cylinderHeight);
-        std::cout << "Created capsule collider: radius=" << size.x << std::endl;
-        break;
-    }
-    default:
-        std:: cerr << "Unknown ShapeType for rigid body creation! defaulting to cube" << std::endl;
-        shape = new btBoxShape(btVector3(0.5f, 0.5f, 0.5f));
-        break;
-
-    }
-
-    collisionShapes.push_back(shape);
+    // Shared with every other body of the same type and size
+    btCollisionShape* shape = shapeCache.acquire(type, size);
 
     // Set initial transform
     btTransform transform;
@@ -121,19 +159,16 @@ btRigidBody* Physics::createRigidBody(
         shape->calculateLocalInertia(mass, localInertia);
     }
 
-    // Create motion state
-    btDefaultMotionState* motionState = new btDefaultMotionState(transform);
-
-    // Create rigid body
-    btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, shape, localInertia);
-    btRigidBody* body = new btRigidBody(rbInfo);
+    // Create rigid body and motion state (pooled, see RigidBodyStore)
+    RigidBodyHandle handle = bodies.create(mass, transform, shape, localInertia);
+    btRigidBody* body = bodies.get(handle);
 
 	// Apply material properties - create material var and get instance of material from registry
     const PhysicsMaterial& material = MaterialRegistry::getInstance().getMaterial(materialName);
     applyMaterial(body, material);
 
-    dynamicsWorld->addRigidBody(body);
-    rigidBodies.push_back(body);
+    // Static/dynamic layer by mass, the scene can move it to another layer
+    addToWorld(body, CollisionLayers::defaultLayerForMass(mass));
 
     return body;
 }
@@ -146,7 +181,7 @@ btRigidBody* Physics::resizeRigidBody(
     const std::string& materialName)
 {
     if (!oldBody) {
-        std::cerr << "Error: Cannot resize null rigid body" << std::endl;
+        LOG_ERROR(LogCategory::Physics, "Error: Cannot resize null rigid body");
         return nullptr;
     }
 
@@ -161,10 +196,12 @@ btRigidBody* Physics::resizeRigidBody(
     float linearDamping = oldBody->getLinearDamping();
     float angularDamping = oldBody->getAngularDamping();
 
-    std::cout << "Resizing rigid body at ("
+    LOG_DEBUG(LogCategory::Physics, "Resizing rigid body at ("
         << transform.getOrigin().x() << ", "
         << transform.getOrigin().y() << ", "
-        << transform.getOrigin().z() << ")" << std::endl;
+        << transform.getOrigin().z() << ")");
+
+    int layer = getCollisionLayer(oldBody);
 
     //  Remove old body
     removeRigidBody(oldBody);
@@ -182,7 +219,7 @@ btRigidBody* Physics::resizeRigidBody(
     );
 
     if (!newBody) {
-        std::cerr << "Error: Failed to create new rigid body during resize" << std::endl;
+        LOG_ERROR(LogCategory::Physics, "Error: Failed to create new rigid body during resize");
         return nullptr;
     }
 
@@ -197,7 +234,12 @@ btRigidBody* Physics::resizeRigidBody(
         newBody->activate(true);
     }
 
-    std::cout << "Rigid body resized successfully" << std::endl;
+    // Keep the layer it was on
+    if (layer >= 0 && layer != getCollisionLayer(newBody)) {
+        setCollisionLayer(newBody, layer);
+    }
+
+    LOG_DEBUG(LogCategory::Physics, "Rigid body resized successfully");
 
     return newBody;
 }
@@ -205,29 +247,132 @@ btRigidBody* Physics::resizeRigidBody(
 void Physics::removeRigidBody(btRigidBody* body) {
     if (!body || !dynamicsWorld) return;
 
+    RigidBodyHandle handle = bodies.handleOf(body);
+    if (handle.isNull()) {
+        LOG_WARN(LogCategory::Physics, "removeRigidBody: body was not created by this Physics, ignored");
+        return;
+    }
+
+    // Its pairs end here, the pooled body may come back at the same address
+    contactEvents.forget(body);
+
     // Must remove from world BEFORE deleting anything
     dynamicsWorld->removeRigidBody(body);
 
-    // Remove and delete the collision shape - this is the missing step.
-    // Without this, orphaned shapes accumulate and Bullet's broadphase
-    // cache can hold stale references to freed shape memory → crash.
-    btCollisionShape* shape = body->getCollisionShape();
-    if (shape) {
-        auto shapeIt = std::find(collisionShapes.begin(), collisionShapes.end(), shape);
-        if (shapeIt != collisionShapes.end()) {
-            collisionShapes.erase(shapeIt);
+    // Drop the body's reference to its shared collision shape, the shape is
+    // deleted with the last body using it. Without this, orphaned shapes
+    // accumulate and Bullet's broadphase cache can hold stale references
+    // to freed shape memory → crash.
+    shapeCache.release(body->getCollisionShape());
+
+    // Frees the slot (swap-and-pop) and returns body + motion state to their pools
+    bodies.destroy(handle);
+}
+
+void Physics::addToWorld(btRigidBody* body, int layer) {
+    const CollisionLayers& layers = CollisionLayers::getInstance();
+    body->setUserIndex2(layer);
+    dynamicsWorld->addRigidBody(body, layers.getGroup(layer), layers.getMask(layer));
+}
+
+void Physics::setCollisionLayer(btCollisionObject* object, int layer) {
+    if (!object || !dynamicsWorld) return;
+
+    const CollisionLayers& layers = CollisionLayers::getInstance();
+    object->setUserIndex2(layer);
+
+    // Not in the world (e.g. a disabled trigger): the layer is applied when it is added
+    if (!object->getBroadphaseHandle()) return;
+
+    if (setProxyFilter(object, layers.getGroup(layer), layers.getMask(layer)))
+        repairFilteredPairs(&object, 1);
+}
+
+bool Physics::setProxyFilter(btCollisionObject* object, int group, int mask) {
+    btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+    if (proxy->m_collisionFilterGroup == group && proxy->m_collisionFilterMask == mask)
+        return false;
+
+    proxy->m_collisionFilterGroup = group;
+    proxy->m_collisionFilterMask = mask;
+    return true;
+}
+
+namespace {
+    // Removes pairs whose proxies no longer accept each other (same test as the pair cache's)
+    struct RemoveFilteredPairs : public btOverlapCallback {
+        bool processOverlap(btBroadphasePair& pair) override {
+            const btBroadphaseProxy* a = pair.m_pProxy0;
+            const btBroadphaseProxy* b = pair.m_pProxy1;
+            bool collides = (a->m_collisionFilterGroup & b->m_collisionFilterMask) != 0 &&
+                (b->m_collisionFilterGroup & a->m_collisionFilterMask) != 0;
+            return !collides;
         }
-        delete shape;
+    };
+}
+
+void Physics::repairFilteredPairs(btCollisionObject* const* changed, int count) {
+    // Removing a pair also frees its algorithm and manifold (what cleanProxyFromPairs
+    // does), but the pair itself has to go or the narrowphase would keep dispatching it
+    RemoveFilteredPairs removeFiltered;
+    broadphase->getOverlappingPairCache()->processAllOverlappingPairs(&removeFiltered, dispatcher);
+
+    // The dbvt only looks for new pairs when a proxy moves, force that for the changed ones
+    // so bodies already overlapping (or asleep) pair up with layers they now collide with
+    btDbvtBroadphase* dbvt = static_cast<btDbvtBroadphase*>(broadphase);
+    for (int i = 0; i < count; i++) {
+        btBroadphaseProxy* proxy = changed[i]->getBroadphaseHandle();
+        dbvt->setAabbForceUpdate(proxy, proxy->m_aabbMin, proxy->m_aabbMax, dispatcher);
     }
+}
 
-    // Remove body from tracking vector
-    auto it = std::find(rigidBodies.begin(), rigidBodies.end(), body);
-    if (it != rigidBodies.end()) {
-        rigidBodies.erase(it);
+int Physics::getCollisionLayer(const btCollisionObject* object) const {
+    return object ? object->getUserIndex2() : -1;
+}
+
+void Physics::refreshCollisionFilters() {
+    if (!dynamicsWorld) return;
+
+    const CollisionLayers& layers = CollisionLayers::getInstance();
+    appliedLayerVersion = layers.getVersion();
+
+    // All filters first, so the pair pass below sees both sides of every pair updated
+    filterChanged.clear();
+    const btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        btCollisionObject* object = objects[i];
+        int layer = object->getUserIndex2();
+        if (layer >= 0 && object->getBroadphaseHandle() &&
+            setProxyFilter(object, layers.getGroup(layer), layers.getMask(layer)))
+            filterChanged.push_back(object);
     }
 
-    delete body->getMotionState();
-    delete body;
+    if (!filterChanged.empty())
+        repairFilteredPairs(filterChanged.data(), static_cast<int>(filterChanged.size()));
+
+    LOG_INFO(LogCategory::Physics, "Collision layers re-applied, " << filterChanged.size() << " objects changed filter");
+}
+
+void Physics::applyCollisionLayerChanges() {
+    if (dynamicsWorld && appliedLayerVersion != CollisionLayers::getInstance().getVersion())
+        refreshCollisionFilters();
+}
+
+int Physics::getBroadphasePairCount() const {
+    if (!dynamicsWorld) return 0;
+    return dynamicsWorld->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+}
+
+void Physics::removeRigidBody(RigidBodyHandle handle) {
+    removeRigidBody(bodies.get(handle));
+}
+
+btRigidBody* Physics::getRigidBody(RigidBodyHandle handle) const {
+    return bodies.get(handle);
+}
+
+RigidBodyHandle Physics::getRigidBodyHandle(const btRigidBody* body) const {
+    return bodies.handleOf(body);
 }
 
 void Physics::applyMaterial(btRigidBody* body, const PhysicsMaterial& material) {
@@ -240,25 +385,86 @@ void Physics::applyMaterial(btRigidBody* body, const PhysicsMaterial& material)
     body->setRestitution(material.restitution);
 
     // Density is used at creation time to calculate mass
-    std::cout << " Applied '" << material.name << "': "
+    LOG_DEBUG(LogCategory::Physics, " Applied '" << material.name << "': "
         << "friction=" << body->getFriction()
-        << ", restitution=" << body->getRestitution() << std::endl;
+        << ", restitution=" << body->getRestitution());
     
 }
 
 void Physics::update(float fixedDeltaTime) {
+    PROFILE_SCOPE("Physics::update");
     if (!dynamicsWorld) return;
 
     //Step the simulation by exactly fixedDeltaTime (should always be 1/60s)
     //maxSubSteps = 1 because Engine.cpp already handles the fixed timestep loop
     //This just advances physics by one fixed step
-    dynamicsWorld->stepSimulation(fixedDeltaTime, 1, fixedDeltaTime);
+    applyCollisionLayerChanges();
+    stepWorld(1, fixedDeltaTime);
+    postStep(fixedDeltaTime);
+}
+
+void Physics::stepWorld(int tickCount, float fixedDeltaTime) {
+    PROFILE_SCOPE("Physics::stepSimulation");
+    if (!dynamicsWorld || tickCount <= 0) return;
+
+    // Thread count changes are applied between steps, never during one
+    int threads = requestedSolverThreads.exchange(0);
+    if (threads > 0 && taskScheduler)
+        taskScheduler->setNumThreads(threads);
+
+    // One exact fixed step per call, as the serial path does. Passing dt * tickCount
+    // can round to one substep fewer and leave the rest in Bullet's local time,
+    // which it then uses to extrapolate the motion states.
+    for (int tick = 0; tick < tickCount; tick++) {
+        dynamicsWorld->stepSimulation(fixedDeltaTime, 1, fixedDeltaTime);
+
+        // Still on the stepping thread, the main thread takes the events after the step
+        contactEvents.collect(*dispatcher);
+    }
+}
+
+void Physics::postStep(float fixedDeltaTime) {
     // Update constraints (check for broken constraints)
     ConstraintRegistry::getInstance().update();
 	// Update triggers (check for enter/exit events)
     TriggerRegistry::getInstance().update(fixedDeltaTime);
 }
 
+void Physics::setMultithreaded(bool enabled) {
+    if (dynamicsWorld) {
+        std::cerr << "Physics::setMultithreaded must be called before initialize()" << std::endl;
+        return;
+    }
+    if (enabled && !isMultithreadingAvailable()) {
+        std::cerr << "Multithreaded physics needs the ENGINE_BULLET_MT build option, using the single-threaded world" << std::endl;
+        enabled = false;
+    }
+    multithreaded = enabled;
+}
+
+bool Physics::isMultithreadingAvailable() {
+#ifdef ENGINE_BULLET_MT
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Physics::setSolverThreadCount(int count) {
+    if (count > 0)
+        requestedSolverThreads.store(count);
+}
+
+int Physics::getSolverThreadCount() const {
+    if (!taskScheduler) return 1;
+    int pending = requestedSolverThreads.load();
+    return pending > 0 ? std::max(1, std::min(pending, maxLoopThreads(taskScheduler))) : taskScheduler->getNumThreads();
+}
+
+int Physics::getMaxSolverThreadCount() const {
+    return maxLoopThreads(taskScheduler);
+}
+
 int Physics::getRigidBodyCount() const {
     if (!dynamicsWorld) return 0;
     return dynamicsWorld->getNumCollisionObjects();
@@ -275,27 +481,33 @@ void Physics::cleanup() {
     TriggerRegistry::getInstance().clearAll();
 
     // delete all rigid bodies (including ground)
-    for (btRigidBody* body : rigidBodies) {
+    for (btRigidBody* body : bodies.getBodies()) {
         dynamicsWorld->removeRigidBody(body);
-        delete body->getMotionState();
-        delete body;
     }
-    rigidBodies.clear();
+    bodies.clear();
+    contactEvents.clear();
 
     // delete all collision shapes
-    for (btCollisionShape* shape : collisionShapes) {
-        delete shape;
-    }
-    collisionShapes.clear();
+    shapeCache.clear();
 
     //Delete dynamics world and components
     delete dynamicsWorld;
+    delete solverMt;
     delete solver;
     delete broadphase;
     delete dispatcher;
     delete collisionConfiguration;
 
+#ifdef ENGINE_BULLET_MT
+    if (taskScheduler) {
+        btSetTaskScheduler(nullptr);
+        delete taskScheduler;
+        taskScheduler = nullptr;
+    }
+#endif
+
     dynamicsWorld = nullptr;
+    solverMt = nullptr;
     solver = nullptr;
     broadphase = nullptr;
     dispatcher = nullptr;
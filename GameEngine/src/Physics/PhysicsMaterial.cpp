@@ -99,6 +99,7 @@ MaterialRegistry::MaterialRegistry() {
  */
 void MaterialRegistry::registerMaterial(const PhysicsMaterial& material) {
     materials[material.name] = material;
+    version++;
     std::cout << "Registered material: " << material.name
         << " (friction=" << material.friction
         << ", restitution=" << material.restitution
@@ -0,0 +1,12 @@
+#include "../include/Physics/PhysicsMotionState.h"
+
+void PhysicsMotionState::setWorldTransform(const btTransform& transform)
+{
+    worldTransform = transform;
+
+    if (!queued && movedList && body)
+    {
+        queued = true;
+        movedList->push_back(body);
+    }
+}
@@ -1,8 +1,129 @@
 #include "../include/Physics/PhysicsQuery.h"
 #include "../include/Scene/GameObject.h"
+#include "../include/Physics/CollisionLayers.h"
+#include "../include/Core/ThreadPool.h"
+#include "../include/Core/Profiler.h"
+#include <BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h>
 #include <algorithm>
+#include <array>
 #include <iostream>
 
+// Output of an overlap query: a fixed caller buffer, or a caller-owned vector
+struct OverlapResults {
+    GameObject** data = nullptr;
+    size_t capacity = 0;
+    std::vector<GameObject*>* growable = nullptr;
+    size_t count = 0;
+
+    OverlapResults(GameObject** data, size_t capacity)
+        : data(data), capacity(capacity) {
+    }
+
+    explicit OverlapResults(std::vector<GameObject*>& out)
+        : growable(&out) {
+        out.clear();
+    }
+
+    // Adds obj once (a body touching a box reports several contact points),
+    // returns false once a fixed buffer is full
+    bool add(GameObject* obj)
+    {
+        if (growable) {
+            if (std::find(growable->begin(), growable->end(), obj) == growable->end())
+                growable->push_back(obj);
+            count = growable->size();
+            return true;
+        }
+
+        if (count >= capacity) return false;
+        if (std::find(data, data + count, obj) == data + count)
+            data[count++] = obj;
+        return count < capacity;
+    }
+};
+
+namespace
+{
+    // Rays per pool task, below this the dispatch costs more than the rays
+    const size_t RaysPerTask = 32;
+    const size_t MaxBatchRanges = 64;
+
+    btVector3 toBullet(const glm::vec3& v) { return btVector3(v.x, v.y, v.z); }
+    glm::vec3 toGlm(const btVector3& v) { return glm::vec3(v.x(), v.y(), v.z()); }
+
+    btTransform makeTransform(const glm::vec3& position, const glm::quat& rotation)
+    {
+        return btTransform(btQuaternion(rotation.x, rotation.y, rotation.z, rotation.w), toBullet(position));
+    }
+
+    // Capsule bodies are created from the total height, Bullet wants the cylinder part
+    float capsuleCylinderHeight(float radius, float height)
+    {
+        return std::max(height - 2.0f * radius, 0.0f);
+    }
+
+    // Closest convex hit that ignores trigger ghosts (no contact response)
+    struct SolidConvexResultCallback : public btCollisionWorld::ClosestConvexResultCallback {
+        SolidConvexResultCallback(const btVector3& from, const btVector3& to)
+            : btCollisionWorld::ClosestConvexResultCallback(from, to) {
+        }
+
+        bool needsCollision(btBroadphaseProxy* proxy0) const override
+        {
+            if (!btCollisionWorld::ClosestConvexResultCallback::needsCollision(proxy0))
+                return false;
+            const btCollisionObject* obj = static_cast<const btCollisionObject*>(proxy0->m_clientObject);
+            return obj->hasContactResponse();
+        }
+    };
+
+    // Narrowphase contacts of the query object, each GameObject reported once
+    struct OverlapContactCallback : public btCollisionWorld::ContactResultCallback {
+        const btCollisionObject* queryObject;
+        OverlapResults& results;
+
+        OverlapContactCallback(const btCollisionObject* queryObject, OverlapResults& results)
+            : queryObject(queryObject), results(results) {
+        }
+
+        btScalar addSingleResult(btManifoldPoint& cp,
+            const btCollisionObjectWrapper* colObj0Wrap, int, int,
+            const btCollisionObjectWrapper* colObj1Wrap, int, int) override
+        {
+            // Points within the contact threshold but not yet touching
+            if (cp.getDistance() > 0.0f) return 0;
+
+            const btCollisionObject* other = colObj0Wrap->getCollisionObject();
+            if (other == queryObject)
+                other = colObj1Wrap->getCollisionObject();
+
+            if (GameObject* obj = static_cast<GameObject*>(other->getUserPointer()))
+                results.add(obj);
+            return 0;
+        }
+    };
+
+    // Broadphase proxies whose AABB overlaps the query box
+    struct OverlapAabbCallback : public btBroadphaseAabbCallback {
+        OverlapResults& results;
+        short collisionMask;
+
+        OverlapAabbCallback(OverlapResults& results, short collisionMask)
+            : results(results), collisionMask(collisionMask) {
+        }
+
+        bool process(const btBroadphaseProxy* proxy) override
+        {
+            if ((proxy->m_collisionFilterGroup & collisionMask) == 0) return true;
+
+            const btCollisionObject* other = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+            if (GameObject* obj = static_cast<GameObject*>(other->getUserPointer()))
+                return results.add(obj);
+            return true;
+        }
+    };
+}
+
 PhysicsQuery::PhysicsQuery(btDiscreteDynamicsWorld* world)
     : dynamicsWorld(world)
 {
@@ -94,6 +215,8 @@ bool PhysicsQuery::raycast(
 
     // Perform raycast
     btCollisionWorld::ClosestRayResultCallback rayCallback(btFrom, btTo);
+    // Every layer's mask accepts the query group, collisionMask picks the layers to hit
+    rayCallback.m_collisionFilterGroup = CollisionLayers::QueryGroup;
     rayCallback.m_collisionFilterMask = collisionMask;
 
     dynamicsWorld->rayTest(btFrom, btTo, rayCallback);
@@ -121,6 +244,7 @@ std::vector<RaycastHit> PhysicsQuery::raycastAll(
 
     // Use AllHitsRayResultCallback to get all intersections
     btCollisionWorld::AllHitsRayResultCallback rayCallback(btFrom, btTo);
+    rayCallback.m_collisionFilterGroup = CollisionLayers::QueryGroup;
     dynamicsWorld->rayTest(btFrom, btTo, rayCallback);
 
     if (!rayCallback.hasHit()) {
@@ -172,6 +296,314 @@ std::vector<RaycastHit> PhysicsQuery::raycastAll(
 }
 
 
+size_t PhysicsQuery::raycastBatch(const Ray* rays, RaycastHit* hits, size_t count) const
+{
+    PROFILE_SCOPE("PhysicsQuery::raycastBatch");
+    if (count == 0) return 0;
+
+    if (!dynamicsWorld) {
+        std::cerr << "Error: PhysicsQuery has no dynamics world" << std::endl;
+        std::fill(hits, hits + count, RaycastHit());
+        return 0;
+    }
+
+    struct CastRange {
+        const PhysicsQuery* query;
+        const Ray* rays;
+        RaycastHit* hits;
+        size_t begin;
+        size_t end;
+        size_t hitCount;
+
+        static void run(void* context) {
+            CastRange& range = *static_cast<CastRange*>(context);
+            range.hitCount = 0;
+            for (size_t i = range.begin; i < range.end; ++i) {
+                const Ray& ray = range.rays[i];
+                if (range.query->raycast(ray.from, ray.to, range.hits[i], ray.collisionMask))
+                    range.hitCount++;
+            }
+        }
+    };
+
+    size_t ranges = 1;
+#ifdef ENGINE_BULLET_MT
+    // btDbvtBroadphase::rayTest shares one traversal stack unless Bullet is
+    // built with BT_THREADSAFE, so only split the batch in that build
+    ThreadPool& pool = ThreadPool::getInstance();
+    ranges = std::min({ static_cast<size_t>(pool.getWorkerCount()) + 1,
+        (count + RaysPerTask - 1) / RaysPerTask, MaxBatchRanges });
+#endif
+
+    if (ranges <= 1) {
+        CastRange all{ this, rays, hits, 0, count, 0 };
+        CastRange::run(&all);
+        return all.hitCount;
+    }
+
+#ifdef ENGINE_BULLET_MT
+    // Contiguous ranges, the calling thread takes the first one. Ranges and jobs
+    // live on the stack, so a batch doesn't allocate.
+    std::array<CastRange, MaxBatchRanges> rangeData;
+    std::array<TaskGroup::Job, MaxBatchRanges> jobs;
+    {
+        TaskGroup group(pool);
+        for (size_t r = 0; r < ranges; r++)
+            rangeData[r] = CastRange{ this, rays, hits, count * r / ranges, count * (r + 1) / ranges, 0 };
+
+        for (size_t r = 1; r < ranges; r++) {
+            jobs[r].function = &CastRange::run;
+            jobs[r].context = &rangeData[r];
+            group.run(jobs[r]);
+        }
+
+        CastRange::run(&rangeData[0]);
+        group.wait();
+    }
+
+    size_t hitCount = 0;
+    for (size_t r = 0; r < ranges; r++)
+        hitCount += rangeData[r].hitCount;
+    return hitCount;
+#else
+    CastRange all{ this, rays, hits, 0, count, 0 };
+    CastRange::run(&all);
+    return all.hitCount;
+#endif
+}
+
+size_t PhysicsQuery::raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits) const
+{
+    hits.resize(rays.size());
+    return raycastBatch(rays.data(), hits.data(), rays.size());
+}
+
+
+// Sweeps
+
+bool PhysicsQuery::sweepShape(
+    const btConvexShape& shape,
+    const glm::vec3& from,
+    const glm::vec3& to,
+    const glm::quat& rotation,
+    RaycastHit& hitInfo,
+    short collisionMask) const
+{
+    hitInfo = RaycastHit();
+
+    if (!dynamicsWorld) {
+        std::cerr << "Error: PhysicsQuery has no dynamics world" << std::endl;
+        return false;
+    }
+
+    btTransform start = makeTransform(from, rotation);
+    btTransform end = makeTransform(to, rotation);
+
+    SolidConvexResultCallback sweepCallback(start.getOrigin(), end.getOrigin());
+    sweepCallback.m_collisionFilterGroup = CollisionLayers::QueryGroup;
+    sweepCallback.m_collisionFilterMask = collisionMask;
+
+    dynamicsWorld->convexSweepTest(&shape, start, end, sweepCallback);
+
+    if (!sweepCallback.hasHit())
+        return false;
+
+    hitInfo.object = getGameObject(sweepCallback.m_hitCollisionObject);
+    hitInfo.point = toGlm(sweepCallback.m_hitPointWorld);
+    hitInfo.normal = toGlm(sweepCallback.m_hitNormalWorld);
+    hitInfo.distance = sweepCallback.m_closestHitFraction * glm::length(to - from);
+
+    if (const btRigidBody* body = btRigidBody::upcast(sweepCallback.m_hitCollisionObject)) {
+        hitInfo.friction = body->getFriction();
+        hitInfo.restitution = body->getRestitution();
+    }
+    else {
+        hitInfo.friction = 0.5f;
+        hitInfo.restitution = 0.0f;
+    }
+    return true;
+}
+
+bool PhysicsQuery::sweepSphere(
+    const glm::vec3& from,
+    const glm::vec3& to,
+    float radius,
+    RaycastHit& hitInfo,
+    short collisionMask) const
+{
+    // Query shapes live on the stack, nothing is allocated per sweep
+    btSphereShape shape(radius);
+    return sweepShape(shape, from, to, glm::quat(1, 0, 0, 0), hitInfo, collisionMask);
+}
+
+bool PhysicsQuery::sweepBox(
+    const glm::vec3& from,
+    const glm::vec3& to,
+    const glm::vec3& halfExtents,
+    const glm::quat& rotation,
+    RaycastHit& hitInfo,
+    short collisionMask) const
+{
+    btBoxShape shape(toBullet(halfExtents));
+    return sweepShape(shape, from, to, rotation, hitInfo, collisionMask);
+}
+
+bool PhysicsQuery::sweepCapsule(
+    const glm::vec3& from,
+    const glm::vec3& to,
+    float radius,
+    float height,
+    RaycastHit& hitInfo,
+    short collisionMask) const
+{
+    btCapsuleShape shape(radius, capsuleCylinderHeight(radius, height));
+    return sweepShape(shape, from, to, glm::quat(1, 0, 0, 0), hitInfo, collisionMask);
+}
+
+
+// Overlaps
+
+void PhysicsQuery::overlapShape(
+    btCollisionShape& shape,
+    const glm::vec3& center,
+    const glm::quat& rotation,
+    OverlapResults& results,
+    short collisionMask) const
+{
+    if (!dynamicsWorld) {
+        std::cerr << "Error: PhysicsQuery has no dynamics world" << std::endl;
+        return;
+    }
+
+    // Never added to the world, contactTest only needs its shape and transform
+    btCollisionObject queryObject;
+    queryObject.setCollisionShape(&shape);
+    queryObject.setWorldTransform(makeTransform(center, rotation));
+
+    OverlapContactCallback contactCallback(&queryObject, results);
+    contactCallback.m_collisionFilterGroup = CollisionLayers::QueryGroup;
+    contactCallback.m_collisionFilterMask = collisionMask;
+
+    dynamicsWorld->contactTest(&queryObject, contactCallback);
+}
+
+void PhysicsQuery::collectAABB(
+    const glm::vec3& min,
+    const glm::vec3& max,
+    OverlapResults& results,
+    short collisionMask) const
+{
+    if (!dynamicsWorld) {
+        std::cerr << "Error: PhysicsQuery has no dynamics world" << std::endl;
+        return;
+    }
+
+    OverlapAabbCallback aabbCallback(results, collisionMask);
+    dynamicsWorld->getBroadphase()->aabbTest(toBullet(min), toBullet(max), aabbCallback);
+}
+
+size_t PhysicsQuery::overlapSphere(
+    const glm::vec3& center,
+    float radius,
+    GameObject** results,
+    size_t maxResults,
+    short collisionMask) const
+{
+    OverlapResults out(results, maxResults);
+    btSphereShape shape(radius);
+    overlapShape(shape, center, glm::quat(1, 0, 0, 0), out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapBox(
+    const glm::vec3& center,
+    const glm::vec3& halfExtents,
+    const glm::quat& rotation,
+    GameObject** results,
+    size_t maxResults,
+    short collisionMask) const
+{
+    OverlapResults out(results, maxResults);
+    btBoxShape shape(toBullet(halfExtents));
+    overlapShape(shape, center, rotation, out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapCapsule(
+    const glm::vec3& center,
+    float radius,
+    float height,
+    GameObject** results,
+    size_t maxResults,
+    short collisionMask) const
+{
+    OverlapResults out(results, maxResults);
+    btCapsuleShape shape(radius, capsuleCylinderHeight(radius, height));
+    overlapShape(shape, center, glm::quat(1, 0, 0, 0), out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapAABB(
+    const glm::vec3& min,
+    const glm::vec3& max,
+    GameObject** results,
+    size_t maxResults,
+    short collisionMask) const
+{
+    OverlapResults out(results, maxResults);
+    collectAABB(min, max, out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapSphere(
+    const glm::vec3& center,
+    float radius,
+    std::vector<GameObject*>& results,
+    short collisionMask) const
+{
+    OverlapResults out(results);
+    btSphereShape shape(radius);
+    overlapShape(shape, center, glm::quat(1, 0, 0, 0), out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapBox(
+    const glm::vec3& center,
+    const glm::vec3& halfExtents,
+    const glm::quat& rotation,
+    std::vector<GameObject*>& results,
+    short collisionMask) const
+{
+    OverlapResults out(results);
+    btBoxShape shape(toBullet(halfExtents));
+    overlapShape(shape, center, rotation, out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapCapsule(
+    const glm::vec3& center,
+    float radius,
+    float height,
+    std::vector<GameObject*>& results,
+    short collisionMask) const
+{
+    OverlapResults out(results);
+    btCapsuleShape shape(radius, capsuleCylinderHeight(radius, height));
+    overlapShape(shape, center, glm::quat(1, 0, 0, 0), out, collisionMask);
+    return out.count;
+}
+
+size_t PhysicsQuery::overlapAABB(
+    const glm::vec3& min,
+    const glm::vec3& max,
+    std::vector<GameObject*>& results,
+    short collisionMask) const
+{
+    OverlapResults out(results);
+    collectAABB(min, max, out, collisionMask);
+    return out.count;
+}
+
 // quick Queries
 bool PhysicsQuery::isGrounded(
     const glm::vec3& position,
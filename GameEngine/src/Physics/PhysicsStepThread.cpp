@@ -0,0 +1,73 @@
+#include "../include/Physics/PhysicsStepThread.h"
+#include "../include/Physics/Physics.h"
+#include "../include/Core/Profiler.h"
+
+PhysicsStepThread::PhysicsStepThread(Physics& physics) : physics(physics)
+{
+    worker = std::thread(&PhysicsStepThread::run, this);
+}
+
+PhysicsStepThread::~PhysicsStepThread()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wakeWorker.notify_one();
+    if (worker.joinable())
+        worker.join();
+}
+
+void PhysicsStepThread::kick(int tickCount, float fixedDeltaTime)
+{
+    if (tickCount <= 0) return;
+
+    // Never overlap two steps
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingTicks = tickCount;
+        pendingDt = fixedDeltaTime;
+        busy = true;
+    }
+    wakeWorker.notify_one();
+}
+
+int PhysicsStepThread::wait()
+{
+    PROFILE_SCOPE("PhysicsStepThread::wait");
+    std::unique_lock<std::mutex> lock(mutex);
+    stepDone.wait(lock, [this] { return !busy; });
+
+    int stepped = pendingTicks;
+    pendingTicks = 0;
+    return stepped;
+}
+
+bool PhysicsStepThread::isBusy()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return busy;
+}
+
+void PhysicsStepThread::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wakeWorker.wait(lock, [this] { return busy || stopRequested; });
+        if (stopRequested)
+            return;
+
+        int ticks = pendingTicks;
+        float dt = pendingDt;
+
+        lock.unlock();
+        physics.stepWorld(ticks, dt);
+        lock.lock();
+
+        busy = false;
+        stepDone.notify_all();
+    }
+}
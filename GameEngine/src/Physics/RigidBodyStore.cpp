@@ -0,0 +1,122 @@
+#include "../include/Physics/RigidBodyStore.h"
+#include <algorithm>
+
+RigidBodyStore::~RigidBodyStore()
+{
+    clear();
+}
+
+RigidBodyHandle RigidBodyStore::create(btScalar mass, const btTransform& transform,
+    btCollisionShape* shape, const btVector3& localInertia)
+{
+    uint32_t slotIndex;
+    if (!freeSlots.empty()) {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        slotIndex = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    PhysicsMotionState* motionState = motionStatePool.create(transform, &movedBodies);
+    btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, shape, localInertia);
+    btRigidBody* body = bodyPool.create(rbInfo);
+    body->setUserIndex(static_cast<int>(slotIndex));
+    motionState->setBody(body);
+
+    Slot& slot = slots[slotIndex];
+    slot.body = body;
+    slot.motionState = motionState;
+    slot.denseIndex = static_cast<uint32_t>(dense.size());
+    dense.push_back(body);
+    denseToSlot.push_back(slotIndex);
+
+    return RigidBodyHandle{ slotIndex, slot.generation };
+}
+
+bool RigidBodyStore::destroy(RigidBodyHandle handle)
+{
+    if (!get(handle))
+        return false;
+
+    Slot& slot = slots[handle.index];
+
+    // Swap-and-pop from the dense array
+    uint32_t denseIndex = slot.denseIndex;
+    uint32_t lastSlot = denseToSlot.back();
+    dense[denseIndex] = dense.back();
+    denseToSlot[denseIndex] = lastSlot;
+    slots[lastSlot].denseIndex = denseIndex;
+    dense.pop_back();
+    denseToSlot.pop_back();
+
+    unqueueMoved(slot);
+    bodyPool.destroy(slot.body);
+    motionStatePool.destroy(slot.motionState);
+
+    slot.body = nullptr;
+    slot.motionState = nullptr;
+    slot.generation++; // invalidates outstanding handles
+    freeSlots.push_back(handle.index);
+    return true;
+}
+
+btRigidBody* RigidBodyStore::get(RigidBodyHandle handle) const
+{
+    if (handle.index >= slots.size())
+        return nullptr;
+
+    const Slot& slot = slots[handle.index];
+    return slot.generation == handle.generation ? slot.body : nullptr;
+}
+
+RigidBodyHandle RigidBodyStore::handleOf(const btRigidBody* body) const
+{
+    if (!body)
+        return RigidBodyHandle{};
+
+    int index = body->getUserIndex();
+    if (index < 0 || static_cast<size_t>(index) >= slots.size() || slots[index].body != body)
+        return RigidBodyHandle{};
+
+    return RigidBodyHandle{ static_cast<uint32_t>(index), slots[index].generation };
+}
+
+void RigidBodyStore::clear()
+{
+    for (uint32_t slotIndex : denseToSlot) {
+        Slot& slot = slots[slotIndex];
+        bodyPool.destroy(slot.body);
+        motionStatePool.destroy(slot.motionState);
+        slot.body = nullptr;
+        slot.motionState = nullptr;
+        slot.generation++;
+        freeSlots.push_back(slotIndex);
+    }
+    dense.clear();
+    denseToSlot.clear();
+    movedBodies.clear();
+}
+
+void RigidBodyStore::clearMovedBodies()
+{
+    for (btRigidBody* body : movedBodies)
+        static_cast<PhysicsMotionState*>(body->getMotionState())->clearQueued();
+    movedBodies.clear();
+}
+
+void RigidBodyStore::unqueueMoved(Slot& slot)
+{
+    if (!slot.motionState->isQueued())
+        return;
+
+    // The moved list only holds this frame's moving bodies, a linear search is cheap
+    auto it = std::find(movedBodies.begin(), movedBodies.end(), slot.body);
+    if (it != movedBodies.end())
+    {
+        *it = movedBodies.back();
+        movedBodies.pop_back();
+    }
+    slot.motionState->clearQueued();
+}
@@ -4,125 +4,268 @@
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <utility>
+
+namespace
+{
+    bool inRange(const glm::ivec3& c, const glm::ivec3& min, const glm::ivec3& max) {
+        return c.x >= min.x && c.x <= max.x
+            && c.y >= min.y && c.y <= max.y
+            && c.z >= min.z && c.z <= max.z;
+    }
+}
 
 SpatialGrid::SpatialGrid(float cellSize) : cellSize(cellSize) {
     if (cellSize <= 0.0f) {
         std::cerr << "Warning: Invalid cell size, using default 10.0f" << std::endl;
         this->cellSize = 10.0f;
     }
+    invCellSize = 1.0f / this->cellSize;
 }
 
-// Convert world position to grid cell coordinate
-glm::ivec3 SpatialGrid::worldToCell(const glm::vec3& worldPos) const {
-    return glm::ivec3(
-        static_cast<int>(std::floor(worldPos.x / cellSize)),
-        static_cast<int>(std::floor(worldPos.y / cellSize)),
-        static_cast<int>(std::floor(worldPos.z / cellSize))
-    );
+// Cells an object overlaps (large objects span multiple cells)
+void SpatialGrid::getObjectCellRange(const GameObject* obj, glm::ivec3& outMin, glm::ivec3& outMax) const {
+    glm::vec3 halfSize = obj->getScale() * 0.5f;
+    glm::vec3 position = obj->getPosition();
+    outMin = worldToCell(position - halfSize);
+    outMax = worldToCell(position + halfSize);
 }
 
-// Get all cells an object overlaps (large objects span multiple cells)
-std::vector<glm::ivec3> SpatialGrid::getObjectCells(
-    const glm::vec3& position,
-    const glm::vec3& size) const
-{
-    glm::vec3 halfSize = size * 0.5f;
-    glm::vec3 min = position - halfSize;
-    glm::vec3 max = position + halfSize;
-    return getCellsInAABB(min, max);
+uint32_t SpatialGrid::allocateBlock(const glm::ivec3& coord) {
+    uint32_t blockIndex;
+    if (!freeBlocks.empty()) {
+        blockIndex = freeBlocks.back();
+        freeBlocks.pop_back();
+    }
+    else {
+        blockIndex = static_cast<uint32_t>(blocks.size());
+        blocks.emplace_back();
+    }
+
+    CellBlock& block = blocks[blockIndex];
+    block.coord = coord;
+    block.count = 0;
+    block.next = NoBlock;
+    return blockIndex;
 }
 
-// Get all cells in a bounding box
-std::vector<glm::ivec3> SpatialGrid::getCellsInAABB(
-    const glm::vec3& min,
-    const glm::vec3& max) const
-{
-    glm::ivec3 minCell = worldToCell(min);
-    glm::ivec3 maxCell = worldToCell(max);
-
-    std::vector<glm::ivec3> cellList;
-    for (int x = minCell.x; x <= maxCell.x; ++x) {
-        for (int y = minCell.y; y <= maxCell.y; ++y) {
-            for (int z = minCell.z; z <= maxCell.z; ++z) {
-                cellList.push_back(glm::ivec3(x, y, z));
-            }
-        }
+void SpatialGrid::addToCell(const glm::ivec3& coord, uint32_t index) {
+    uint32_t first = cellLookup.find(coord);
+    if (first == cellLookup.NotFound) {
+        first = allocateBlock(coord);
+        cellLookup.set(coord, first);
+    }
+    else if (blocks[first].count == BlockEntries) {
+        // First block full: its entries move to a new block chained behind it
+        uint32_t full = allocateBlock(coord);
+        blocks[full] = blocks[first];
+        blocks[first].count = 0;
+        blocks[first].next = full;
     }
-    return cellList;
+
+    CellBlock& block = blocks[first];
+    block.objects[block.count++] = index;
 }
 
-void SpatialGrid::insertObject(GameObject* obj) {
-    if (!obj) return;
-    if (objectToCells.find(obj) != objectToCells.end()) return; // Already inserted
+void SpatialGrid::removeFromCell(const glm::ivec3& coord, uint32_t index) {
+    uint32_t first = cellLookup.find(coord);
+    if (first == cellLookup.NotFound) return;
+
+    // The last entry of the first block fills the hole
+    CellBlock& head = blocks[first];
+    for (uint32_t b = first; b != NoBlock; b = blocks[b].next) {
+        CellBlock& block = blocks[b];
+        uint32_t* end = block.objects + block.count;
+        uint32_t* it = std::find(block.objects, end, index);
+        if (it == end) continue;
 
-    std::vector<glm::ivec3> overlappingCells = getObjectCells(obj->getPosition(), obj->getScale());
+        *it = head.objects[--head.count];
+        break;
+    }
+    if (head.count > 0) return;
 
-    for (const auto& cell : overlappingCells) {
-        cells[cell].insert(obj);
-        objectToCells[obj].insert(cell);
+    if (head.next != NoBlock) {
+        // Pull the next (full) block forward so the first block stays the partial one
+        uint32_t next = head.next;
+        head = blocks[next];
+        freeBlocks.push_back(next);
+    }
+    else {
+        cellLookup.erase(coord);
+        freeBlocks.push_back(first);
     }
 }
 
+void SpatialGrid::renumberInCell(const glm::ivec3& coord, uint32_t from, uint32_t to) {
+    uint32_t first = cellLookup.find(coord);
+    if (first == cellLookup.NotFound) return;
+
+    for (uint32_t b = first; b != NoBlock; b = blocks[b].next) {
+        CellBlock& block = blocks[b];
+        uint32_t* end = block.objects + block.count;
+        uint32_t* it = std::find(block.objects, end, from);
+        if (it != end) {
+            *it = to;
+            return;
+        }
+    }
+}
+
+void SpatialGrid::insertObject(GameObject* obj) {
+    if (!obj) return;
+    if (objectIndex.find(obj) != objectIndex.NotFound) return; // Already inserted
+
+    uint32_t index = static_cast<uint32_t>(objects.size());
+    glm::vec3 position = obj->getPosition();
+    glm::vec3 halfSize = obj->getScale() * 0.5f;
+    glm::ivec3 minCell, maxCell;
+    getObjectCellRange(obj, minCell, maxCell);
+
+    objects.push_back(obj);
+    boxes.push_back(ObjectBox{ position, halfSize });
+    cellMin.push_back(minCell);
+    cellMax.push_back(maxCell);
+    objectIndex.set(obj, index);
+
+    for (int x = minCell.x; x <= maxCell.x; ++x)
+        for (int y = minCell.y; y <= maxCell.y; ++y)
+            for (int z = minCell.z; z <= maxCell.z; ++z)
+                addToCell(glm::ivec3(x, y, z), index);
+}
+
 void SpatialGrid::removeObject(GameObject* obj) {
     if (!obj) return;
 
-    auto it = objectToCells.find(obj);
-    if (it == objectToCells.end()) return; // Not in grid
+    uint32_t index = objectIndex.find(obj);
+    if (index == objectIndex.NotFound) return; // Not in grid
 
     // Remove from all cells
-    for (const auto& cell : it->second) {
-        auto cellIt = cells.find(cell);
-        if (cellIt != cells.end()) {
-            cellIt->second.erase(obj);
-            if (cellIt->second.empty()) {
-                cells.erase(cellIt); // Free empty cells
-            }
-        }
+    glm::ivec3 minCell = cellMin[index];
+    glm::ivec3 maxCell = cellMax[index];
+    for (int x = minCell.x; x <= maxCell.x; ++x)
+        for (int y = minCell.y; y <= maxCell.y; ++y)
+            for (int z = minCell.z; z <= maxCell.z; ++z)
+                removeFromCell(glm::ivec3(x, y, z), index);
+
+    // Swap-and-pop: the last object takes the freed index, its cells are renumbered
+    uint32_t last = static_cast<uint32_t>(objects.size() - 1);
+    if (index != last) {
+        glm::ivec3 lastMin = cellMin[last];
+        glm::ivec3 lastMax = cellMax[last];
+        for (int x = lastMin.x; x <= lastMax.x; ++x)
+            for (int y = lastMin.y; y <= lastMax.y; ++y)
+                for (int z = lastMin.z; z <= lastMax.z; ++z)
+                    renumberInCell(glm::ivec3(x, y, z), last, index);
+
+        objects[index] = objects[last];
+        boxes[index] = boxes[last];
+        cellMin[index] = lastMin;
+        cellMax[index] = lastMax;
+        objectIndex.set(objects[index], index);
     }
 
-    objectToCells.erase(it);
+    objects.pop_back();
+    boxes.pop_back();
+    cellMin.pop_back();
+    cellMax.pop_back();
+    objectIndex.erase(obj);
 }
 
 void SpatialGrid::updateObject(GameObject* obj) {
     if (!obj) return;
 
-    auto it = objectToCells.find(obj);
-    if (it == objectToCells.end()) {
+    uint32_t index = objectIndex.find(obj);
+    if (index == objectIndex.NotFound) {
         insertObject(obj); // Not in grid yet
         return;
     }
 
-    // Calculate new cells
-    std::vector<glm::ivec3> newCells = getObjectCells(obj->getPosition(), obj->getScale());
-    std::unordered_set<glm::ivec3, GridCellHash> newCellSet(newCells.begin(), newCells.end());
+    glm::vec3 position = obj->getPosition();
+    glm::vec3 halfSize = obj->getScale() * 0.5f;
+    boxes[index] = ObjectBox{ position, halfSize };
+
+    glm::ivec3 newMin, newMax;
+    getObjectCellRange(obj, newMin, newMax);
 
     // Early exit if no change
-    if (it->second == newCellSet) return;
-
-    // Remove from old cells
-    for (const auto& cell : it->second) {
-        if (newCellSet.find(cell) == newCellSet.end()) {
-            auto cellIt = cells.find(cell);
-            if (cellIt != cells.end()) {
-                cellIt->second.erase(obj);
-                if (cellIt->second.empty()) cells.erase(cellIt);
+    glm::ivec3 oldMin = cellMin[index];
+    glm::ivec3 oldMax = cellMax[index];
+    if (newMin == oldMin && newMax == oldMax) return;
+
+    // Leave cells only in the old range, join cells only in the new one.
+    // Entries are plain indices, so the kept cells need no touching.
+    for (int x = oldMin.x; x <= oldMax.x; ++x)
+        for (int y = oldMin.y; y <= oldMax.y; ++y)
+            for (int z = oldMin.z; z <= oldMax.z; ++z) {
+                glm::ivec3 cell(x, y, z);
+                if (!inRange(cell, newMin, newMax))
+                    removeFromCell(cell, index);
             }
-        }
-    }
 
-    // Add to new cells
-    for (const auto& cell : newCellSet) {
-        if (it->second.find(cell) == it->second.end()) {
-            cells[cell].insert(obj);
-        }
-    }
+    for (int x = newMin.x; x <= newMax.x; ++x)
+        for (int y = newMin.y; y <= newMax.y; ++y)
+            for (int z = newMin.z; z <= newMax.z; ++z) {
+                glm::ivec3 cell(x, y, z);
+                if (!inRange(cell, oldMin, oldMax))
+                    addToCell(cell, index);
+            }
 
-    it->second = newCellSet;
+    cellMin[index] = newMin;
+    cellMax[index] = newMax;
 }
 
 void SpatialGrid::clear() {
-    cells.clear();
-    objectToCells.clear();
+    objects.clear();
+    boxes.clear();
+    cellMin.clear();
+    cellMax.clear();
+    objectIndex.clear();
+
+    // The block pool keeps its capacity
+    blocks.clear();
+    freeBlocks.clear();
+    cellLookup.clear();
+}
+
+uint32_t SpatialGrid::nextStamp() const {
+    if (visitStamps.size() < objects.size())
+        visitStamps.resize(objects.size(), 0);
+
+    // After 4 billion queries the stamps wrap, start over from clean ones
+    if (++currentStamp == 0) {
+        std::fill(visitStamps.begin(), visitStamps.end(), 0u);
+        currentStamp = 1;
+    }
+    return currentStamp;
+}
+
+bool SpatialGrid::segmentHitsObject(uint32_t index, const glm::vec3& from, const glm::vec3& invDelta, float& outT) const {
+    const ObjectBox& box = boxes[index];
+    const float center[3] = { box.position.x, box.position.y, box.position.z };
+    const float half[3] = { box.halfSize.x, box.halfSize.y, box.halfSize.z };
+
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        float low = center[axis] - half[axis];
+        float high = center[axis] + half[axis];
+
+        // Parallel to this slab: inside it for the whole segment or never
+        if (std::isinf(invDelta[axis])) {
+            if (from[axis] < low || from[axis] > high) return false;
+            continue;
+        }
+
+        float t0 = (low - from[axis]) * invDelta[axis];
+        float t1 = (high - from[axis]) * invDelta[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
+        if (tEnter > tExit) return false;
+    }
+
+    outT = tEnter;
+    return true;
 }
 
 std::vector<GameObject*> SpatialGrid::queryRadius(
@@ -130,37 +273,86 @@ std::vector<GameObject*> SpatialGrid::queryRadius(
     float radius,
     std::function<bool(GameObject*)> filter) const
 {
-    // Get bounding box for the sphere
-    glm::vec3 radiusVec(radius, radius, radius);
-    std::vector<glm::ivec3> queryCells = getCellsInAABB(center - radiusVec, center + radiusVec);
-
-    // Collect candidates (use set to avoid duplicates)
-    std::unordered_set<GameObject*> candidates;
-    for (const auto& cell : queryCells) {
-        auto it = cells.find(cell);
-        if (it != cells.end()) {
-            for (GameObject* obj : it->second) {
-                candidates.insert(obj);
-            }
-        }
-    }
-
-    // Filter by actual distance
     std::vector<GameObject*> results;
-    float radiusSquared = radius * radius;
+    if (objects.empty()) return results;
 
-    for (GameObject* obj : candidates) {
-        if (filter && !filter(obj)) continue;
+    results.reserve(16); // one allocation covers a typical query instead of several regrows
+    forEachInSphere(center, radius, [&](uint32_t index, float) {
+        GameObject* obj = objects[index];
+        if (filter && !filter(obj)) return;
+        results.push_back(obj);
+    });
 
-        glm::vec3 diff = obj->getPosition() - center;
-        float distSquared = glm::dot(diff, diff);
+    return results;
+}
 
-        if (distSquared <= radiusSquared) {
-            results.push_back(obj);
-        }
+template <typename Visit, typename Bound>
+void SpatialGrid::forEachNearestFirst(const glm::vec3& position, float maxRadius, Visit&& visit, Bound&& bound) const {
+    if (objects.empty() || maxRadius < 0.0f) return;
+
+    glm::vec3 radiusVec(maxRadius, maxRadius, maxRadius);
+    glm::ivec3 queryMin = worldToCell(position - radiusVec);
+    glm::ivec3 queryMax = worldToCell(position + radiusVec);
+    glm::ivec3 home = worldToCell(position);
+    int maxShell = 0;
+    for (int axis = 0; axis < 3; ++axis)
+        maxShell = std::max(maxShell, std::max(home[axis] - queryMin[axis], queryMax[axis] - home[axis]));
+
+    // Sparse grid: fewer live cells than the search cube, one pass over them beats the shells
+    double side = 2.0 * maxShell + 1.0;
+    if (side * side * side > static_cast<double>(cellLookup.size())) {
+        forEachInSphere(position, maxRadius, [&](uint32_t index, float distSquared) {
+            if (distSquared <= bound()) visit(index, distSquared);
+        });
+        return;
     }
 
-    return results;
+    for (int shell = 0; shell <= maxShell; ++shell) {
+        float boundSquared = bound();
+
+        // Every cell in this shell or beyond lies outside the block already searched
+        if (shell > 0) {
+            float gap = std::numeric_limits<float>::max();
+            for (int axis = 0; axis < 3; ++axis) {
+                float low = (home[axis] - shell + 1) * cellSize;
+                float high = (home[axis] + shell) * cellSize;
+                gap = std::min(gap, std::min(position[axis] - low, high - position[axis]));
+            }
+            if (gap * gap > boundSquared) break;
+        }
+
+        // The shell is the surface of the (2 * shell + 1)^3 block: full z columns on
+        // its x/y edges, only the two z faces inside them
+        for (int x = -shell; x <= shell; ++x)
+            for (int y = -shell; y <= shell; ++y) {
+                bool edge = std::abs(x) == shell || std::abs(y) == shell;
+                int zStep = edge ? 1 : 2 * shell;
+                for (int z = -shell; z <= shell; z += zStep) {
+                    glm::ivec3 coord = home + glm::ivec3(x, y, z);
+                    if (!inRange(coord, queryMin, queryMax)) continue;
+
+                    glm::vec3 cellLow = glm::vec3(coord) * cellSize;
+                    glm::vec3 nearest = glm::clamp(position, cellLow, cellLow + glm::vec3(cellSize));
+                    glm::vec3 diff = nearest - position;
+                    if (glm::dot(diff, diff) > boundSquared) continue;
+
+                    uint32_t cellIndex = cellLookup.find(coord);
+                    if (cellIndex == cellLookup.NotFound) continue;
+
+                    // Center-cell rule as in forEachInSphere, the shell bound holds for the center
+                    forEachInCell(blocks[cellIndex], [&](uint32_t index) {
+                        const glm::vec3& objectPosition = boxes[index].position;
+                        float dx = objectPosition.x - position.x;
+                        float dy = objectPosition.y - position.y;
+                        float dz = objectPosition.z - position.z;
+                        float distSquared = dx * dx + dy * dy + dz * dz;
+                        if (distSquared <= bound() && worldToCell(objectPosition) == coord)
+                            visit(index, distSquared);
+                    });
+                    boundSquared = bound();
+                }
+            }
+    }
 }
 
 GameObject* SpatialGrid::queryNearest(
@@ -168,41 +360,72 @@ GameObject* SpatialGrid::queryNearest(
     float maxRadius,
     std::function<bool(GameObject*)> filter) const
 {
-    std::vector<GameObject*> candidates = queryRadius(position, maxRadius, filter);
-    if (candidates.empty()) return nullptr;
-
     GameObject* nearest = nullptr;
-    float minDistSquared = std::numeric_limits<float>::max();
+    float minDistSquared = maxRadius * maxRadius;
 
-    for (GameObject* obj : candidates) {
-        glm::vec3 diff = obj->getPosition() - position;
-        float distSquared = glm::dot(diff, diff);
-
-        if (distSquared < minDistSquared) {
+    forEachNearestFirst(position, maxRadius,
+        [&](uint32_t index, float distSquared) {
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
             minDistSquared = distSquared;
             nearest = obj;
-        }
-    }
+        },
+        [&]() { return minDistSquared; });
 
     return nearest;
 }
 
+void SpatialGrid::queryKNearest(
+    const glm::vec3& position,
+    int k,
+    float maxRadius,
+    std::vector<GameObject*>& out,
+    std::function<bool(GameObject*)> filter) const
+{
+    out.clear();
+    if (k <= 0) return;
+
+    float maxRadiusSquared = maxRadius * maxRadius;
+    nearestCandidates.reset(static_cast<size_t>(k));
+
+    forEachNearestFirst(position, maxRadius,
+        [&](uint32_t index, float distSquared) {
+            if (!nearestCandidates.wants(distSquared)) return;
+
+            GameObject* obj = objects[index];
+            if (filter && !filter(obj)) return;
+            nearestCandidates.add(distSquared, index);
+        },
+        [&]() { return nearestCandidates.bound(maxRadiusSquared); });
+
+    const auto& closest = nearestCandidates.sortClosestFirst();
+    out.reserve(closest.size());
+    for (const auto& candidate : closest)
+        out.push_back(objects[candidate.second]);
+}
+
+void SpatialGrid::queryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<GameObject*>& out) const {
+    out.clear();
+    visitAABB(min, max, [&out](GameObject* obj) { out.push_back(obj); });
+}
+
 void SpatialGrid::printStats() const {
     std::cout << "=== Spatial Grid ===" << std::endl;
     std::cout << "Cell size: " << cellSize << " units" << std::endl;
-    std::cout << "Objects: " << objectToCells.size() << std::endl;
-    std::cout << "Active cells: " << cells.size() << std::endl;
+    std::cout << "Objects: " << objects.size() << std::endl;
+    std::cout << "Active cells: " << cellLookup.size() << std::endl;
 
-    if (!cells.empty()) {
+    if (!cellLookup.empty()) {
         size_t total = 0;
         size_t maxInCell = 0;
-        for (const auto& pair : cells) {
-            size_t count = pair.second.size();
+        cellLookup.forEach([&](const glm::ivec3&, uint32_t cellIndex) {
+            size_t count = 0;
+            forEachInCell(blocks[cellIndex], [&](uint32_t) { count++; });
             total += count;
             maxInCell = std::max(maxInCell, count);
-        }
-        std::cout << "Avg per cell: " << (float)total / cells.size() << std::endl;
+        });
+        std::cout << "Avg per cell: " << (float)total / cellLookup.size() << std::endl;
         std::cout << "Max in one cell: " << maxInCell << std::endl;
     }
     std::cout << "====================" << std::endl;
-}
\ No newline at end of file
+}
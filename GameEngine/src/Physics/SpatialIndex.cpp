@@ -0,0 +1,35 @@
+#include "../include/Physics/SpatialIndex.h"
+#include "../include/Physics/SpatialGrid.h"
+#include "../include/Physics/LooseOctree.h"
+#include "../include/Physics/DynamicAABBTree.h"
+
+const char* spatialIndexTypeToString(SpatialIndexType type)
+{
+    switch (type)
+    {
+    case SpatialIndexType::UniformGrid: return "grid";
+    case SpatialIndexType::LooseOctree: return "octree";
+    case SpatialIndexType::AABBTree: return "aabbtree";
+    }
+    return "grid";
+}
+
+bool spatialIndexTypeFromString(const std::string& name, SpatialIndexType& out)
+{
+    if (name == "grid") out = SpatialIndexType::UniformGrid;
+    else if (name == "octree") out = SpatialIndexType::LooseOctree;
+    else if (name == "aabbtree") out = SpatialIndexType::AABBTree;
+    else return false;
+    return true;
+}
+
+std::unique_ptr<ISpatialIndex> createSpatialIndex(SpatialIndexType type, float cellSize)
+{
+    switch (type)
+    {
+    case SpatialIndexType::LooseOctree: return std::make_unique<LooseOctree>();
+    case SpatialIndexType::AABBTree: return std::make_unique<DynamicAABBTree>();
+    case SpatialIndexType::UniformGrid: break;
+    }
+    return std::make_unique<SpatialGrid>(cellSize);
+}
@@ -1,5 +1,7 @@
 #include "../include/Physics/Trigger.h"
 #include "../include/Scene/GameObject.h"
+#include "../include/Core/Log.h"
+#include "../include/Physics/CollisionLayers.h"
 #include <iostream>
 #include <algorithm>
 
@@ -18,6 +20,7 @@ Trigger::Trigger(const std::string& triggerName,
     teleportDestination(0.0f),
     forceDirection(0.0f, 1.0f, 0.0f),
     forceMagnitude(10.0f),
+    collisionLayer(CollisionLayers::Trigger),
     id(nextID++)
 {
     // Create collision shape (box by default)
@@ -41,8 +44,8 @@ Trigger::Trigger(const std::string& triggerName,
         btCollisionObject::CF_NO_CONTACT_RESPONSE
     );
 
-    std::cout << "Created trigger '" << name << "' at ("
-        << pos.x << ", " << pos.y << ", " << pos.z << ")" << std::endl;
+    LOG_DEBUG(LogCategory::Trigger, "Created trigger '" << name << "' at ("
+        << pos.x << ", " << pos.y << ", " << pos.z << ")");
 }
 
 Trigger::~Trigger() {
@@ -51,7 +54,7 @@ Trigger::~Trigger() {
 }
 void Trigger::requireTag(const std::string& tag)
 {
-    std::cout << "[Trigger] requireTag called: '" << tag << "' on '" << name << "'" << std::endl;
+    LOG_DEBUG(LogCategory::Trigger, "[Trigger] requireTag called: '" << tag << "' on '" << name << "'");
     requiredTags.insert(tag);
 }
 // Returns true if obj has ALL of the trigger's required tags,
@@ -79,17 +82,22 @@ void Trigger::update(btDiscreteDynamicsWorld* world, float deltaTime) {
         if (!rb || rb->getInvMass() == 0.0f) continue;
         // Get GameObject from user pointer
         GameObject* obj = static_cast<GameObject*>(colObj->getUserPointer());
-        if (obj) {
-            std::cout << "[Trigger debug] Overlapping: '" << obj->getName()
-                << "' tags: ";
-            for (const auto& t : obj->getTags()) std::cout << "'" << t << "' ";
-            std::cout << "| Required: ";
-            for (const auto& t : requiredTags) std::cout << "'" << t << "' ";
-            std::cout << std::endl;
-        }
-        else {
-            std::cout << "[Trigger debug] Overlapping object has null user pointer" << std::endl;
+#if ENGINE_LOG_DEBUG
+        // Per body, per tick: only formatted when Trigger is at Debug level
+        if (Log::isEnabled(LogCategory::Trigger, LogLevel::Debug)) {
+            std::ostringstream msg;
+            if (obj) {
+                msg << "[Trigger debug] Overlapping: '" << obj->getName() << "' tags: ";
+                for (const auto& t : obj->getTags()) msg << "'" << t << "' ";
+                msg << "| Required: ";
+                for (const auto& t : requiredTags) msg << "'" << t << "' ";
+            }
+            else {
+                msg << "[Trigger debug] Overlapping object has null user pointer";
+            }
+            Log::write(LogCategory::Trigger, LogLevel::Debug, msg.str());
         }
+#endif
         if (obj && passesTagFilter(obj) ) {
             currentlyInside.push_back(obj);
         }
@@ -103,7 +111,7 @@ void Trigger::update(btDiscreteDynamicsWorld* world, float deltaTime) {
 
         if (!wasInside) {
             // Object just entered!
-            std::cout << "[Trigger '" << name << "'] Object entered" << std::endl;
+            LOG_DEBUG(LogCategory::Trigger, "[Trigger '" << name << "'] Object entered");
 			// Add to our list of what's inside
             objectsInside.push_back(obj);
 
@@ -132,7 +140,7 @@ void Trigger::update(btDiscreteDynamicsWorld* world, float deltaTime) {
 
         if (!stillInside) {
             // Object just exited!
-            std::cout << "[Trigger '" << name << "'] Object exited" << std::endl;
+            LOG_DEBUG(LogCategory::Trigger, "[Trigger '" << name << "'] Object exited");
 
             if (onExitCallback) {
                 onExitCallback(obj);
@@ -149,8 +157,8 @@ void Trigger::executeDefaultBehavior(GameObject* obj) {
 
     switch (type) {
     case TriggerType::TELEPORT:
-        std::cout << "[TELEPORT] Teleporting to (" << teleportDestination.x
-            << ", " << teleportDestination.y << ", " << teleportDestination.z << ")" << std::endl;
+        LOG_DEBUG(LogCategory::Trigger, "[TELEPORT] Teleporting to (" << teleportDestination.x
+            << ", " << teleportDestination.y << ", " << teleportDestination.z << ")");
         obj->setPosition(teleportDestination);
         break;
 
@@ -164,7 +172,7 @@ void Trigger::executeDefaultBehavior(GameObject* obj) {
                     forceDirection.z * forceMagnitude
                 );
                 body->applyCentralImpulse(force);
-                std::cout << "[SPEED ZONE] Applied force" << std::endl;
+                LOG_DEBUG(LogCategory::Trigger, "[SPEED ZONE] Applied force");
             }
         }
         break;
@@ -1,6 +1,9 @@
 #include "../include/Physics/TriggerRegistry.h"
 #include "../include/Physics/Trigger.h"
 #include "../include/Scene/GameObject.h"
+#include "../include/Core/Profiler.h"
+#include "../include/Core/Log.h"
+#include "../include/Physics/CollisionLayers.h"
 #include <iostream>
 #include <algorithm>
 
@@ -55,9 +58,10 @@ Trigger* TriggerRegistry::addTrigger(std::unique_ptr<Trigger> trigger) {
     // Store and return raw pointer
     Trigger* rawPtr = trigger.get();
     triggers.push_back(std::move(trigger));
+    version++;
 
-    std::cout << "Added trigger '" << rawPtr->getName() << "' (total: "
-        << triggers.size() << ")" << std::endl;
+    LOG_DEBUG(LogCategory::Trigger, "Added trigger '" << rawPtr->getName() << "' (total: "
+        << triggers.size() << ")");
 
     return rawPtr;
 }
@@ -79,8 +83,9 @@ void TriggerRegistry::removeTrigger(Trigger* trigger) {
 
         // Remove from vector (destroys the trigger)
         triggers.erase(it);
+        version++;
 
-        std::cout << "Removed trigger (remaining: " << triggers.size() << ")" << std::endl;
+        LOG_DEBUG(LogCategory::Trigger, "Removed trigger (remaining: " << triggers.size() << ")");
     }
 }
 
@@ -107,6 +112,7 @@ void TriggerRegistry::clearAll() {
 
     // Clear storage
     triggers.clear();
+    version++;
 
     std::cout << "All triggers cleared" << std::endl;
 }
@@ -114,6 +120,7 @@ void TriggerRegistry::clearAll() {
 // === Update ===
 
 void TriggerRegistry::update(float deltaTime) {
+    PROFILE_SCOPE("TriggerRegistry::update");
     // Update all active triggers
     for (auto& trigger : triggers) {
         if (trigger && trigger->isEnabled()) {
@@ -282,6 +289,18 @@ void TriggerRegistry::printAllTriggers() const {
     std::cout << "====================\n" << std::endl;
 }
 
+void TriggerRegistry::setCollisionLayer(Trigger* trigger, int layer) {
+    if (!trigger || trigger->getCollisionLayer() == layer) return;
+
+    trigger->setCollisionLayer(layer);
+
+    btPairCachingGhostObject* ghostObject = trigger->getGhostObject();
+    if (dynamicsWorld && ghostObject && ghostObject->getBroadphaseHandle()) {
+        removeFromPhysicsWorld(trigger);
+        addToPhysicsWorld(trigger);
+    }
+}
+
 // === Private Helpers ===
 
 void TriggerRegistry::addToPhysicsWorld(Trigger* trigger) {
@@ -289,10 +308,14 @@ void TriggerRegistry::addToPhysicsWorld(Trigger* trigger) {
 
     btPairCachingGhostObject* ghostObject = trigger->getGhostObject();
     if (ghostObject) {
+        // Layer group/mask, so triggers only pair with the layers they can affect
+        const CollisionLayers& layers = CollisionLayers::getInstance();
+        int layer = trigger->getCollisionLayer();
+        ghostObject->setUserIndex2(layer);
         dynamicsWorld->addCollisionObject(
             ghostObject,
-            btBroadphaseProxy::SensorTrigger,
-            btBroadphaseProxy::AllFilter
+            layers.getGroup(layer),
+            layers.getMask(layer)
         );
     }
 }
@@ -1,5 +1,6 @@
 #include "../include/Rendering/Cubemap.h"
 #include "../external/stb/stb_image.h"
+#include "../include/Core/Log.h"
 #include <iostream>
 
 Cubemap::Cubemap() : textureID(0), width(0), height(0) {
@@ -35,41 +36,61 @@ bool Cubemap::loadFromFiles(const std::vector<std::string>& faces) {
         return false;
     }
 
+    std::vector<CubemapImage> images(faces.size());
+    for (size_t i = 0; i < faces.size(); i++) {
+        if (!decodeFace(faces[i], images[i]))
+            return false;
+    }
+
+    return uploadFaces(images);
+}
+
+bool Cubemap::decodeFace(const std::string& path, CubemapImage& out) {
+    // Don't flip cubemap textures. The per-thread setting keeps concurrent
+    // texture decodes (which do flip) from racing on stb's global flag.
+    stbi_set_flip_vertically_on_load_thread(false);
+
+    unsigned char* data = stbi_load(path.c_str(), &out.width, &out.height, &out.channels, 0);
+    if (!data) {
+        std::cerr << "ERROR::CUBEMAP: Failed to load " << path << std::endl;
+        std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+
+    out.pixels = std::unique_ptr<unsigned char, void (*)(void*)>(data, stbi_image_free);
+    LOG_DEBUG(LogCategory::Render, "Decoded cubemap face: " << path);
+    return true;
+}
+
+bool Cubemap::uploadFaces(const std::vector<CubemapImage>& faces) {
+    if (faces.size() != 6) {
+        std::cerr << "ERROR::CUBEMAP: Must provide exactly 6 face textures" << std::endl;
+        return false;
+    }
+
+    for (const CubemapImage& face : faces) {
+        if (!face.isValid()) {
+            std::cerr << "ERROR::CUBEMAP: Missing face data, not uploading" << std::endl;
+            return false;
+        }
+    }
+
+    cleanup();
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
-    // Don't flip cubemap textures
-    stbi_set_flip_vertically_on_load(false);
+    // First face dimensions
+    width = faces[0].width;
+    height = faces[0].height;
 
-    // Load each face
     for (unsigned int i = 0; i < faces.size(); i++) {
-        int w, h, channels;
-        unsigned char* data = stbi_load(faces[i].c_str(), &w, &h, &channels, 0);
-
-        if (data) {
-            // Store first face dimensions
-            if (i == 0) {
-                width = w;
-                height = h;
-            }
-
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-
-            // Upload to corresponding cubemap face
-            glTexImage2D(
-                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,  // Face: +X, -X, +Y, -Y, +Z, -Z
-                0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data
-            );
-
-            stbi_image_free(data);
-            std::cout << "Loaded cubemap face " << i << ": " << faces[i] << std::endl;
-        }
-        else {
-            std::cerr << "ERROR::CUBEMAP: Failed to load " << faces[i] << std::endl;
-            std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
-            cleanup();
-            return false;
-        }
+        GLenum format = (faces[i].channels == 4) ? GL_RGBA : GL_RGB;
+
+        // Upload to corresponding cubemap face
+        glTexImage2D(
+            GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,  // Face: +X, -X, +Y, -Y, +Z, -Z
+            0, format, faces[i].width, faces[i].height, 0, format, GL_UNSIGNED_BYTE, faces[i].pixels.get()
+        );
     }
 
     // Set cubemap parameters
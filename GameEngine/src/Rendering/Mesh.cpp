@@ -78,11 +78,21 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
     return *this;
 }
 
-void Mesh::setData(const std::vector<float>& interleavedVertices,
+void Mesh::setVertexData(const std::vector<float>& interleavedVertices,
     const std::vector<unsigned int>& inds) {
     vertices = interleavedVertices;
     indices = inds;
     indexCount = inds.size();
+}
+
+void Mesh::setData(const std::vector<float>& interleavedVertices,
+    const std::vector<unsigned int>& inds) {
+    setVertexData(interleavedVertices, inds);
+    upload();
+}
+
+void Mesh::upload() {
+    if (VAO != 0) return; // already on the GPU
 
     // Generate buffers
     glGenVertexArrays(1, &VAO);
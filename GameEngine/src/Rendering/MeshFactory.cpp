@@ -40,7 +40,7 @@ static void calculateTangentBitangent(
 }
 
 
-Mesh MeshFactory::createCube() {
+Mesh MeshFactory::createCube(bool uploadToGPU) {
     // Format: pos(3) + normal(3) + uv(2) + tangent(3) + bitangent(3) = 14 floats
     std::vector<float> vertices = {
         // Front face (normal: 0, 0, 1, tangent: 1, 0, 0, bitangent: 0, 1, 0)
@@ -90,11 +90,14 @@ Mesh MeshFactory::createCube() {
     };
 
     Mesh mesh;
-    mesh.setData(vertices, indices);
+    if (uploadToGPU)
+        mesh.setData(vertices, indices);
+    else
+        mesh.setVertexData(vertices, indices);
     return mesh;
 }
 
-Mesh MeshFactory::createSphere(float radius, int sectors, int stacks) {
+Mesh MeshFactory::createSphere(float radius, int sectors, int stacks, bool uploadToGPU) {
     std::vector<float> vertices;
     std::vector<unsigned int> indices;
 
@@ -161,11 +164,14 @@ Mesh MeshFactory::createSphere(float radius, int sectors, int stacks) {
     }
 
     Mesh mesh;
-    mesh.setData(vertices, indices);
+    if (uploadToGPU)
+        mesh.setData(vertices, indices);
+    else
+        mesh.setVertexData(vertices, indices);
     return mesh;
 }
 
-Mesh MeshFactory::createCylinder(float radius, float height, int sectors) {
+Mesh MeshFactory::createCylinder(float radius, float height, int sectors, bool uploadToGPU) {
     std::vector<float> vertices;
     std::vector<unsigned int> indices;
     float halfHeight = height / 2.0f;
@@ -305,11 +311,14 @@ Mesh MeshFactory::createCylinder(float radius, float height, int sectors) {
     }
 
     Mesh mesh;
-    mesh.setData(vertices, indices);
+    if (uploadToGPU)
+        mesh.setData(vertices, indices);
+    else
+        mesh.setVertexData(vertices, indices);
     return mesh;
 }
 
-Mesh MeshFactory::loadFromFile(const std::string& filepath) {
+Mesh MeshFactory::loadFromFile(const std::string& filepath, bool uploadToGPU) {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -456,6 +465,9 @@ Mesh MeshFactory::loadFromFile(const std::string& filepath) {
     }
 
     Mesh mesh;
-    mesh.setData(vertices, indices);
+    if (uploadToGPU)
+        mesh.setData(vertices, indices);
+    else
+        mesh.setVertexData(vertices, indices);
     return mesh;
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "../include/Physics/TriggerRegistry.h"
 #include "../include/Physics/ForceGenerator.h"
 #include "../include/Rendering/PointLight.h"
+#include "../include/Core/Profiler.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <GLFW/glfw3.h>
@@ -25,15 +26,35 @@ Renderer::~Renderer() {
 }
 
 void Renderer::initialize() {
+	initializePipeline();
+
+	PrimitiveMeshData primitives;
+	buildPrimitiveMeshes(primitives);
+	uploadPrimitiveMeshes(primitives);
+}
+
+void Renderer::buildPrimitiveMeshes(PrimitiveMeshData& out) {
+	out.cube = MeshFactory::createCube(false);
+	out.sphere = MeshFactory::createSphere(1.0f, 36, 18, false);
+	out.cylinder = MeshFactory::createCylinder(1.0f, 2.0f, 36, false);
+}
+
+void Renderer::initializePipeline() {
 	// Create shader programs
 	shaderManager.createProgram("shaders/basic.vert", "shaders/basic.frag", "main");
 	shaderManager.createProgram("shaders/shadow_depth.vert", "shaders/shadow_depth.frag", "shadow");
 
 	shadowMap.initialize();
+}
 
-	cubeMesh = MeshFactory::createCube();
-	sphereMesh = MeshFactory::createSphere();
-	cylinderMesh = MeshFactory::createCylinder();
+void Renderer::uploadPrimitiveMeshes(PrimitiveMeshData& data) {
+	cubeMesh = std::move(data.cube);
+	sphereMesh = std::move(data.sphere);
+	cylinderMesh = std::move(data.cylinder);
+
+	cubeMesh.upload();
+	sphereMesh.upload();
+	cylinderMesh.upload();
 }
 
 bool Renderer::loadSkybox(const std::vector<std::string>& faces) {
@@ -44,10 +65,19 @@ bool Renderer::loadSkybox(const std::vector<std::string>& faces) {
 	return false;
 }
 
+bool Renderer::loadSkybox(const std::vector<CubemapImage>& faces) {
+	if (skybox.loadCubemap(faces)) {
+		skyboxEnabled = true;
+		return true;
+	}
+	return false;
+}
+
 void Renderer::renderShadowPass(
 	const Camera& camera,
-	const std::vector<std::unique_ptr<GameObject>>& objects)
+	const RenderSnapshot& snapshot)
 {
+	PROFILE_SCOPE("Renderer::renderShadowPass");
 	// Calculate light space matrix
 	glm::vec3 sceneCenter = glm::vec3(0.0f, 0.0f, 0.0f);  // Could be dynamic based on objects
 	float sceneRadius = 50.0f;  // Could be calculated from scene bounds
@@ -66,16 +96,16 @@ void Renderer::renderShadowPass(
 	glUniformMatrix4fv(lightSpaceLoc, 1, GL_FALSE, &lightSpaceMatrix[0][0]);
 
 	// Render all objects (only their depth)
-	for (const auto& obj : objects) {
+	for (const auto& item : snapshot.objects) {
 		glm::mat4 model = Transform::model(
-			obj->getPosition(),
-			obj->getRotation(),
-			obj->getScale()
+			item.position,
+			item.rotation,
+			item.scale
 		);
 		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
 		// Use the object's render mesh
-		Mesh* mesh = obj->getRender().getRenderMesh();
+		Mesh* mesh = item.object->getRender().getRenderMesh();
 		if (!mesh) mesh = &cubeMesh;
 
 		mesh->draw();
@@ -85,11 +115,12 @@ void Renderer::renderShadowPass(
 	shadowMap.unbind();
 }
 
-void Renderer::drawGameObject(const GameObject& obj, int modelLoc, int colorLoc) {
+void Renderer::drawGameObject(const RenderSnapshotObject& item, int modelLoc, int colorLoc) {
+	const GameObject& obj = *item.object;
 	glm::mat4 model = Transform::model(
-		obj.getPosition(),
-		obj.getRotation(),
-		obj.getScale()
+		item.position,
+		item.rotation,
+		item.scale
 	);
 	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
@@ -188,16 +219,15 @@ void Renderer::drawGameObject(const GameObject& obj, int modelLoc, int colorLoc)
 void Renderer::draw(int windowWidth,
 	int windowHeight,
 	const Camera& camera,
-	const std::vector<std::unique_ptr<GameObject>>& objects,
-	const GameObject* primarySelection,
-	const std::vector<GameObject*>& selectedObjects) {
+	const RenderSnapshot& snapshot) {
 	if (windowHeight == 0)
 		return;
 
 	// SHADOW PASS - Render from light's perspective
-	renderShadowPass(camera, objects);
+	renderShadowPass(camera, snapshot);
 
 	// MAIN PASS - Render scene normally
+	PROFILE_SCOPE("Renderer::mainPass");
 	glViewport(0, 0, windowWidth, windowHeight);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glEnable(GL_DEPTH_TEST);
@@ -246,15 +276,10 @@ void Renderer::draw(int windowWidth,
 	glUniform1i(shadowMapLoc, 1);
 
 
-	for (const auto& obj : objects)
+	for (const auto& item : snapshot.objects)
 	{
-		bool isSelected =
-			std::find(selectedObjects.begin(),
-				selectedObjects.end(),
-				obj.get()) != selectedObjects.end();
-
 		glUniform1i(glGetUniformLocation(mainShader, "uIsSelected"),
-			isSelected ? 1 : 0);
+			item.selected ? 1 : 0);
 
 		glUniform3f(glGetUniformLocation(mainShader, "uHighlightColor"),
 			0.0f, 1.0f, 1.0f); // cyan
@@ -262,30 +287,30 @@ void Renderer::draw(int windowWidth,
 		glUniform1f(glGetUniformLocation(mainShader, "uHighlightStrength"),
 			0.6f);
 
-		drawGameObject(*obj, modelLoc, colorLoc);
+		drawGameObject(item, modelLoc, colorLoc);
 
 		// Outline ONLY for primary selection
-		if (primarySelection && obj.get() == primarySelection)
+		if (item.primarySelection)
 		{
-			drawOutlineOnly(*obj, modelLoc, colorLoc);
+			drawOutlineOnly(item, modelLoc, colorLoc);
 		}
 
 		if (debugPhysicsEnabled)
 		{
-			drawDebugCollisionShape(*obj, modelLoc, colorLoc);
+			drawDebugCollisionShape(item, modelLoc, colorLoc);
 		}
 	}
 }
 
 // Draws a black wire overlay on top of the object (if mesh has edge indices).
 // Does NOT change your friend's base draw code.
-void Renderer::drawOutlineOnly(const GameObject& obj, int modelLoc, int colorLoc)
+void Renderer::drawOutlineOnly(const RenderSnapshotObject& item, int modelLoc, int colorLoc)
 {
 	// Build model matrix
-	glm::mat4 model = Transform::model(obj.getPosition(), obj.getRotation(), obj.getScale());
+	glm::mat4 model = Transform::model(item.position, item.rotation, item.scale);
 	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
-	Mesh* mesh = obj.getRender().getRenderMesh();
+	Mesh* mesh = item.object->getRender().getRenderMesh();
 	if (!mesh) mesh = &cubeMesh;
 
 	// Force "edge shader path" to black using your existing fragment test
@@ -306,26 +331,14 @@ void Renderer::drawOutlineOnly(const GameObject& obj, int modelLoc, int colorLoc
 	glDisable(GL_POLYGON_OFFSET_LINE);
 }
 
-void Renderer::drawDebugCollisionShape(const GameObject& obj, int modelLoc, int colorLoc) {
-	glm::vec3 debugScale = obj.getScale();
-
-	btRigidBody* rb = obj.getRigidBody();
-	if (rb && rb->getCollisionShape()) {
-		btCollisionShape* shape = rb->getCollisionShape();
-		if (shape->getShapeType() == BOX_SHAPE_PROXYTYPE) {
-			btBoxShape* box = static_cast<btBoxShape*>(shape);
-			btVector3 half = box->getHalfExtentsWithMargin();
-			debugScale = glm::vec3(
-				half.x() * 2.0f,
-				half.y() * 2.0f,
-				half.z() * 2.0f
-			);
-		}
-	}
+void Renderer::drawDebugCollisionShape(const RenderSnapshotObject& item, int modelLoc, int colorLoc) {
+	const GameObject& obj = *item.object;
+
+	// Box shape size comes from the snapshot, the body may be mid-step
 	glm::mat4 model = Transform::model(
-		obj.getPosition(),
-		obj.getRotation(),
-		debugScale
+		item.position,
+		item.rotation,
+		item.collisionScale
 	);
 	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
@@ -373,7 +386,7 @@ void Renderer::drawDebugCollisionShape(const GameObject& obj, int modelLoc, int
 	glEnable(GL_DEPTH_TEST);
 }
 
-void Renderer::drawTriggerDebug(const std::vector<Trigger*>& triggers, const Camera& camera, int fbW, int fbH)
+void Renderer::drawTriggerDebug(const RenderSnapshot& snapshot, const Camera& camera, int fbW, int fbH)
 {
 
 	if (!debugPhysicsEnabled) return;
@@ -399,20 +412,18 @@ void Renderer::drawTriggerDebug(const std::vector<Trigger*>& triggers, const Cam
 	glLineWidth(1.5f);
 	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-	for (Trigger* trigger : triggers)
+	for (const RenderSnapshotTrigger& trigger : snapshot.triggers)
 	{
-		if (!trigger || !trigger->isEnabled()) continue;
-
 		// Yellow for teleport, green for speed zone, white for others
-		switch (trigger->getType())
+		switch (trigger.type)
 		{
 		case TriggerType::TELEPORT:    glUniform3f(colorLoc, 1.0f, 1.0f, 0.0f); break;
 		case TriggerType::SPEED_ZONE:  glUniform3f(colorLoc, 0.0f, 1.0f, 0.0f); break;
 		default:                       glUniform3f(colorLoc, 1.0f, 1.0f, 1.0f); break;
 		}
 
-		glm::mat4 model = glm::translate(glm::mat4(1.0f), trigger->getPosition());
-		model = glm::scale(model, trigger->getSize());
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), trigger.position);
+		model = glm::scale(model, trigger.size);
 		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
 		cubeMesh.draw();
@@ -423,7 +434,7 @@ void Renderer::drawTriggerDebug(const std::vector<Trigger*>& triggers, const Cam
 	glUniform3fv(lightColorLoc, 1, &mainLight.getFinalColor()[0]);
 }
 
-void Renderer::drawForceGeneratorDebug(const std::vector<ForceGenerator*>& generators, const Camera& camera, int fbW, int fbH)
+void Renderer::drawForceGeneratorDebug(const RenderSnapshot& snapshot, const Camera& camera, int fbW, int fbH)
 {
 	if (!debugPhysicsEnabled) return;
 	if (fbW == 0 || fbH == 0) return;
@@ -448,11 +459,9 @@ void Renderer::drawForceGeneratorDebug(const std::vector<ForceGenerator*>& gener
 	glLineWidth(1.5f);
 	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-	for (ForceGenerator* gen : generators)
+	for (const RenderSnapshotForceGenerator& gen : snapshot.forceGenerators)
 	{
-		if (!gen || !gen->isEnabled()) continue;
-
-		switch (gen->getType())
+		switch (gen.type)
 		{
 		case ForceGeneratorType::WIND:         glUniform3f(colorLoc, 0.5f, 0.8f, 1.0f); break; // light blue
 		case ForceGeneratorType::GRAVITY_WELL: glUniform3f(colorLoc, 0.8f, 0.0f, 1.0f); break; // purple
@@ -462,8 +471,8 @@ void Renderer::drawForceGeneratorDebug(const std::vector<ForceGenerator*>& gener
 		}
 
 		// Generators use radius so draw as sphere scaled to diameter
-		float r = gen->getRadius();
-		glm::mat4 model = glm::translate(glm::mat4(1.0f), gen->getPosition());
+		float r = gen.radius;
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), gen.position);
 		model = glm::scale(model, glm::vec3(r * 2.0f));
 		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
@@ -475,7 +484,7 @@ void Renderer::drawForceGeneratorDebug(const std::vector<ForceGenerator*>& gener
 	glUniform3fv(lightColorLoc, 1, &mainLight.getFinalColor()[0]);
 }
 
-void Renderer::drawPointLightDebug(const std::vector<PointLight*>& lights, const Camera& camera, int fbW, int fbH)
+void Renderer::drawPointLightDebug(const RenderSnapshot& snapshot, const Camera& camera, int fbW, int fbH)
 {
 	if (!debugPhysicsEnabled) return;
 	if (fbW == 0 || fbH == 0) return;
@@ -500,16 +509,14 @@ void Renderer::drawPointLightDebug(const std::vector<PointLight*>& lights, const
 	glLineWidth(1.5f);
 	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-	for (PointLight* light : lights)
+	for (const RenderSnapshotPointLight& light : snapshot.pointLights)
 	{
-		if (!light || !light->isEnabled()) continue;
-
 		// Use the light's own colour for the wireframe
-		glm::vec3 col = light->getColour();
+		glm::vec3 col = light.colour;
 		glUniform3f(colorLoc, col.r, col.g, col.b);
 
 		// Draw sphere
-		glm::mat4 model = glm::translate(glm::mat4(1.0f), light->getPosition());
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), light.position);
 		model = glm::scale(model, glm::vec3(1.0f));
 		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
 
@@ -521,22 +528,20 @@ void Renderer::drawPointLightDebug(const std::vector<PointLight*>& lights, const
 	glUniform3fv(lightColorLoc, 1, &mainLight.getFinalColor()[0]);
 }
 
-void Renderer::uploadPointLights(const std::vector<PointLight*>& lights)
+void Renderer::uploadPointLights(const RenderSnapshot& snapshot)
 {
 	unsigned int mainShader = shaderManager.getProgram("main");
 	glUseProgram(mainShader);
 
 	int count = 0;
-	for (PointLight* l : lights)
+	for (const RenderSnapshotPointLight& l : snapshot.pointLights)
 	{
-		if (!l || !l->isEnabled()) continue;
 		if (count >= 16) break;
 
-		std::string base = "pointLightPositions[" + std::to_string(count) + "]";
-		glUniform3fv(glGetUniformLocation(mainShader, ("pointLightPositions[" + std::to_string(count) + "]").c_str()), 1, &l->getPosition()[0]);
-		glUniform3fv(glGetUniformLocation(mainShader, ("pointLightColours[" + std::to_string(count) + "]").c_str()), 1, &l->getColour()[0]);
-		glUniform1f(glGetUniformLocation(mainShader, ("pointLightIntensities[" + std::to_string(count) + "]").c_str()), l->getIntensity());
-		glUniform1f(glGetUniformLocation(mainShader, ("pointLightRadii[" + std::to_string(count) + "]").c_str()), l->getRadius());
+		glUniform3fv(glGetUniformLocation(mainShader, ("pointLightPositions[" + std::to_string(count) + "]").c_str()), 1, &l.position[0]);
+		glUniform3fv(glGetUniformLocation(mainShader, ("pointLightColours[" + std::to_string(count) + "]").c_str()), 1, &l.colour[0]);
+		glUniform1f(glGetUniformLocation(mainShader, ("pointLightIntensities[" + std::to_string(count) + "]").c_str()), l.intensity);
+		glUniform1f(glGetUniformLocation(mainShader, ("pointLightRadii[" + std::to_string(count) + "]").c_str()), l.radius);
 		count++;
 	}
 
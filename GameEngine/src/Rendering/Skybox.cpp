@@ -142,6 +142,17 @@ bool Skybox::loadCubemap(const std::vector<std::string>& faces) {
     return true;
 }
 
+bool Skybox::loadCubemap(const std::vector<CubemapImage>& faces) {
+    if (!cubemap.uploadFaces(faces)) {
+        return false;
+    }
+
+    setupMesh();
+    setupShaders();
+
+    return true;
+}
+
 void Skybox::draw(const glm::mat4& view, const glm::mat4& projection) {
     // Change depth function so skybox is drawn at max depth
     glDepthFunc(GL_LEQUAL);
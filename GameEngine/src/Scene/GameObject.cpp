@@ -72,8 +72,8 @@ GameObject::~GameObject() {
  * @brief Synchronizes GameObject transform with its physics rigid body.
  *
  * Pulls the current position and rotation from the Bullet physics simulation
- * and updates the GameObject's cached transform. This should be called every
- * frame after physics simulation has stepped.
+ * and updates the GameObject's cached transform. Scene calls this after physics
+ * has stepped, only for objects whose body Bullet moved (see PhysicsMotionState).
  *
  * The flow is:
  * 1. Physics system simulates forces, collisions, constraints
@@ -164,6 +164,21 @@ void GameObject::fixedUpdateScripts(float fixedDt)
             script->onFixedUpdate(fixedDt);
 }
 
+void GameObject::collisionScripts(ContactEventType type, const Collision& collision)
+{
+    for (auto& script : scripts)
+    {
+        if (script->pendingRemoval) continue;
+
+        switch (type)
+        {
+        case ContactEventType::Enter: script->onCollisionEnter(collision); break;
+        case ContactEventType::Stay:  script->onCollisionStay(collision);  break;
+        case ContactEventType::Exit:  script->onCollisionExit(collision);  break;
+        }
+    }
+}
+
 void GameObject::notifyDestroy()
 {
     for (auto& script : scripts)
@@ -38,4 +38,38 @@ void PhysicsComponent::syncFromTransform(const TransformComponent& transform) {
 
     // Wake up the body so changes take effect immediately
     rigidBody->activate(true);
+
+    // Teleported - don't interpolate from the old position
+    resetPoseHistory();
+}
+
+void PhysicsComponent::capturePose() {
+    if (!rigidBody) return;
+
+    // Read the simulated transform directly, not the motion state
+    const btTransform& trans = rigidBody->getWorldTransform();
+    const btVector3& origin = trans.getOrigin();
+    btQuaternion rot = trans.getRotation();
+
+    glm::vec3 position(origin.x(), origin.y(), origin.z());
+    glm::quat rotation(rot.w(), rot.x(), rot.y(), rot.z());
+
+    if (poseHistoryValid) {
+        previousPosition = currentPosition;
+        previousRotation = currentRotation;
+    }
+    else {
+        // First tick after spawn/teleport, nothing to blend from yet
+        previousPosition = position;
+        previousRotation = rotation;
+        poseHistoryValid = true;
+    }
+
+    currentPosition = position;
+    currentRotation = rotation;
+}
+
+void PhysicsComponent::getInterpolatedPose(float alpha, glm::vec3& outPosition, glm::quat& outRotation) const {
+    outPosition = glm::mix(previousPosition, currentPosition, alpha);
+    outRotation = glm::slerp(previousRotation, currentRotation, alpha);
 }
\ No newline at end of file
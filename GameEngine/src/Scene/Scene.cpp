@@ -2,12 +2,17 @@
 #include "../include/Scene/Scene.h"
 #include "../include/Core/GameTime.h"
 #include "../include/Core/Engine.h"
+#include "../include/Core/Profiler.h"
+#include "../include/Core/Log.h"
 #include "../include/Physics/ConstraintRegistry.h"
 #include "../include/Rendering/MeshFactory.h"
+#include "../include/Rendering/Renderer.h"
+#include "../include/Rendering/RenderSnapshot.h"
 #include "../include/Physics/TriggerRegistry.h"
 #include "../include/Physics/Trigger.h" 
 #include "../include/Physics/ForceGeneratorRegistry.h"
 #include "../include/Physics/ForceGenerator.h"
+#include "../include/Physics/CollisionLayers.h"
 #include "../include/Rendering/PointLightRegistry.h"
 #include <unordered_map> 
 #include <iostream>
@@ -27,12 +32,24 @@ using json = nlohmann::json;
  *
  * @param physics Reference to the game's Physics system
  */
-Scene::Scene(Physics& physics, Renderer& renderer) : physicsWorld(physics), renderer(renderer)
-, spatialGrid(std::make_unique<SpatialGrid>(10.0f))//enable by defualt
+Scene::Scene(Physics& physics, Renderer& renderer) : physicsWorld(physics), renderer(&renderer)
+, spatialIndex(createSpatialIndex(SpatialIndexType::UniformGrid, 10.0f))//enable by defualt
 {
     std::cout << "Scene created" << std::endl;
 }
 
+/**
+ * @brief Constructs a headless scene with no renderer.
+ *
+ * Objects spawned into a headless scene get no render mesh and models are
+ * loaded CPU-side only, so no GL context is needed. Used by the headless runner.
+ */
+Scene::Scene(Physics& physics) : physicsWorld(physics), renderer(nullptr)
+, spatialIndex(createSpatialIndex(SpatialIndexType::UniformGrid, 10.0f))
+{
+    std::cout << "Scene created (headless)" << std::endl;
+}
+
 
 /**
  * @brief Destroys the scene and cleans up all game objects.
@@ -56,8 +73,8 @@ void Scene::wireTagCallback(GameObject* obj)
             auto it = tagScriptRegistry.find(tag);
             if (it != tagScriptRegistry.end() && it->second.attach)
             {
-                std::cout << "[TagScript] Attaching script for tag '" << tag
-                    << "' to object '" << obj->getName() << "'" << std::endl;
+                LOG_DEBUG(LogCategory::Scene, "[TagScript] Attaching script for tag '" << tag
+                    << "' to object '" << obj->getName() << "'");
                 it->second.attach(obj);
             }
         });
@@ -67,8 +84,8 @@ void Scene::wireTagCallback(GameObject* obj)
             auto it = tagScriptRegistry.find(tag);
             if (it != tagScriptRegistry.end() && it->second.remove)
             {
-                std::cout << "[TagScript] Removing script for tag '" << tag
-                    << "' from object '" << obj->getName() << "'" << std::endl;
+                LOG_DEBUG(LogCategory::Scene, "[TagScript] Removing script for tag '" << tag
+                    << "' from object '" << obj->getName() << "'");
                 it->second.remove(obj);
             }
         });
@@ -95,8 +112,8 @@ void Scene::applyTagScriptsToExistingObjects()
             auto it = tagScriptRegistry.find(tag);
             if (it != tagScriptRegistry.end() && it->second.attach)
             {
-                std::cout << "[TagScript] Applying script for tag '" << tag
-                    << "' to existing object '" << obj->getName() << "'" << std::endl;
+                LOG_DEBUG(LogCategory::Scene, "[TagScript] Applying script for tag '" << tag
+                    << "' to existing object '" << obj->getName() << "'");
                 it->second.attach(obj.get());
             }
         }
@@ -189,23 +206,26 @@ GameObject* Scene::spawnObject(ShapeType type,
     obj->updateFromPhysics();
 
     // Set render mesh based on shape type
-    switch (type) {
-    case ShapeType::CUBE:
-        obj->getRender().setRenderMesh(renderer.getCubeMesh());
-        break;
-    case ShapeType::SPHERE:
-        obj->getRender().setRenderMesh(renderer.getSphereMesh());
-        break;
-    case ShapeType::CAPSULE:
-        obj->getRender().setRenderMesh(renderer.getCylinderMesh());
-        break;
+    // Headless scenes have no renderer and skip render meshes entirely
+    if (renderer) {
+        switch (type) {
+        case ShapeType::CUBE:
+            obj->getRender().setRenderMesh(renderer->getCubeMesh());
+            break;
+        case ShapeType::SPHERE:
+            obj->getRender().setRenderMesh(renderer->getSphereMesh());
+            break;
+        case ShapeType::CAPSULE:
+            obj->getRender().setRenderMesh(renderer->getCylinderMesh());
+            break;
+        }
     }
 
     GameObject* ptr = obj.get();
     gameObjects.push_back(std::move(obj));
     // Add to spatial grid
-    if (spatialGrid) {
-        spatialGrid->insertObject(ptr);
+    if (spatialIndex) {
+        spatialIndex->insertObject(ptr);
     }
     wireTagCallback(ptr);
     // Log creation
@@ -216,9 +236,9 @@ GameObject* Scene::spawnObject(ShapeType type,
     case ShapeType::CAPSULE: shapeName = "Capsule"; break;
     }
 
-    std::cout << "Spawned " << shapeName << " at ("
+    LOG_DEBUG(LogCategory::Scene, "Spawned " << shapeName << " at ("
         << position.x << ", " << position.y << ", " << position.z
-        << ") with material: " << materialName << std::endl;
+        << ") with material: " << materialName);
 
     return ptr;
 }
@@ -240,16 +260,19 @@ GameObject* Scene::spawnRenderObject(
         obj->getRender().setSpecularTexturePath(specularPath);
     }
 
-    switch (type) {
-    case ShapeType::CUBE:
-        obj->getRender().setRenderMesh(renderer.getCubeMesh());
-        break;
-    case ShapeType::SPHERE:
-        obj->getRender().setRenderMesh(renderer.getSphereMesh());
-        break;
-    case ShapeType::CAPSULE:
-        obj->getRender().setRenderMesh(renderer.getCylinderMesh());
-        break;
+    // Headless scenes have no renderer and skip render meshes entirely
+    if (renderer) {
+        switch (type) {
+        case ShapeType::CUBE:
+            obj->getRender().setRenderMesh(renderer->getCubeMesh());
+            break;
+        case ShapeType::SPHERE:
+            obj->getRender().setRenderMesh(renderer->getSphereMesh());
+            break;
+        case ShapeType::CAPSULE:
+            obj->getRender().setRenderMesh(renderer->getCylinderMesh());
+            break;
+        }
     }
 
 
@@ -257,8 +280,8 @@ GameObject* Scene::spawnRenderObject(
     gameObjects.push_back(std::move(obj));
     wireTagCallback(ptr);
 
-    std::cout << "Spawned Render-Only Object at ("
-        << position.x << ", " << position.y << ", " << position.z << ")\n";
+    LOG_DEBUG(LogCategory::Scene, "Spawned Render-Only Object at ("
+        << position.x << ", " << position.y << ", " << position.z << ")");
 
     return ptr;
 }
@@ -320,8 +343,8 @@ void Scene::setObjectScale(GameObject* obj, const glm::vec3& newScale) {
         newBody->setUserPointer(obj);
         obj->getPhysics()->setRigidBody(newBody);
 
-        if (spatialGrid) {
-            spatialGrid->updateObject(obj);
+        if (spatialIndex) {
+            spatialIndex->updateObject(obj);
         }
 
         std::cout << "Object scale updated successfully" << std::endl;
@@ -343,7 +366,37 @@ void Scene::setObjectScale(GameObject* obj, const glm::vec3& newScale) {
  * 2. Scene::update() syncs GameObject transforms from physics
  * 3. Renderer draws objects at their updated positions
  */
-void Scene::update(EngineMode mode) {
+void Scene::update(EngineMode mode, float interpolationAlpha) {
+    PROFILE_SCOPE("Scene::update");
+    updateObjects(mode);
+    updateRenderInterpolation(mode, interpolationAlpha);
+    updateSpatialGrid();
+}
+
+/**
+ * @brief Fixed-tick half of the script update.
+ *
+ * The engine calls this once per fixed tick, right before the step, so
+ * onFixedUpdate runs as many times as physics does whatever the frame rate.
+ * Contact events from the previous step are delivered first.
+ */
+void Scene::fixedUpdate() {
+    PROFILE_SCOPE("Scene::fixedUpdate");
+    dispatchContactEvents();
+
+    for (auto& obj : gameObjects) {
+        obj->fixedUpdateScripts(fixedTimestep);
+    }
+}
+
+/**
+ * @brief Runs scripts, syncs transforms from physics and destroys pending objects.
+ *
+ * Must run before updateRenderInterpolation() and updateSpatialGrid(), which
+ * only read what this pass leaves behind.
+ */
+void Scene::updateObjects(EngineMode mode) {
+    PROFILE_SCOPE("Scene::updateObjects");
     // Only sync transforms from physics in GAME mode
     if (mode == EngineMode::Game || mode == EngineMode::Test)
     {
@@ -354,17 +407,18 @@ void Scene::update(EngineMode mode) {
         {
             obj->updateScripts(dt);
         }
-		// --- 2. Fixed update for physics-related scripts ---
-        const float fixedDt = 1.0f / 60.0f;
-        for (auto& obj : gameObjects) {
-            obj->fixedUpdateScripts(fixedDt);
-        }
+        // --- 2. Collision events from the last step (earlier steps went out in fixedUpdate) ---
+        dispatchContactEvents();
+
         // --- 3. Sync physics -> transform ---
-        for (auto& obj : gameObjects)
+        // Only the bodies Bullet moved since the last sync (filled by capturePhysicsPoses)
+        for (GameObject* obj : transformSyncList)
         {
-            if (obj->hasPhysics())
-                obj->updateFromPhysics();
+            if (PhysicsComponent* physics = obj->getPhysics())
+                physics->setTransformSyncQueued(false);
+            obj->updateFromPhysics();
         }
+        transformSyncList.clear();
     }
     else
     {
@@ -378,46 +432,247 @@ void Scene::update(EngineMode mode) {
             }
             editorSyncedOnce = true;
         }
-    }
-    // Update spatial grid positions
-    if (spatialGrid) {
-        for (auto& obj : gameObjects) {
-            spatialGrid->updateObject(obj.get());
-        }
+
+        // Scripts don't run in the editor, drop the events so they don't pile up
+        physicsWorld.takeContactEvents(contactEventBuffer);
+        contactEventBuffer.clear();
     }
 
     // --- Process deferred destruction ---
+    // Per-object teardown first, then one pass over gameObjects for all of them.
+    // Indexed loop: onDestroy() scripts may queue more objects while we iterate.
     if (!pendingDestroy.empty())
     {
-        for (GameObject* obj : pendingDestroy)
+        for (size_t i = 0; i < pendingDestroy.size(); i++)
         {
+            GameObject* obj = pendingDestroy[i];
 			// Call onDestroy() on all scripts before removing the object
             obj->notifyDestroy();
             // 1. Remove constraints
             ConstraintRegistry::getInstance().removeConstraintsForObject(obj);
 
             // 2. Remove from spatial grid
-            if (spatialGrid)
-                spatialGrid->removeObject(obj);
+            if (spatialIndex)
+                spatialIndex->removeObject(obj);
 
             // 3. Remove physics body
             if (obj->hasPhysics())
                 physicsWorld.removeRigidBody(obj->getRigidBody());
-
-            // 4. Remove from scene container
-            gameObjects.erase(
-                std::remove_if(gameObjects.begin(), gameObjects.end(),
-                    [obj](const std::unique_ptr<GameObject>& ptr)
-                    {
-                        return ptr.get() == obj;
-                    }),
-                gameObjects.end()
-            );
         }
 
+        // 4. Drop them from the moved-body lists, then from the scene container,
+        // single pass each for the whole batch
+        auto isQueued = [](const GameObject* obj) { return obj->isDestroyQueued(); };
+        transformSyncList.erase(std::remove_if(transformSyncList.begin(), transformSyncList.end(), isQueued), transformSyncList.end());
+        posedLastTick.erase(std::remove_if(posedLastTick.begin(), posedLastTick.end(), isQueued), posedLastTick.end());
+
+        gameObjects.erase(
+            std::remove_if(gameObjects.begin(), gameObjects.end(),
+                [](const std::unique_ptr<GameObject>& ptr)
+                {
+                    return ptr->isDestroyQueued();
+                }),
+            gameObjects.end()
+        );
+
         pendingDestroy.clear();
     }
+}
+
+/**
+ * @brief Delivers the collision events queued by the physics steps since the last call.
+ *
+ * Each event goes to the scripts of both objects, with the other object and
+ * the normal flipped to point towards the receiver. Objects are only destroyed
+ * at the end of updateObjects(), so every pointer in the batch is still alive.
+ */
+void Scene::dispatchContactEvents() {
+    PROFILE_SCOPE("Scene::dispatchContactEvents");
+    physicsWorld.takeContactEvents(contactEventBuffer);
+
+    for (const ContactEvent& event : contactEventBuffer)
+    {
+        Collision collision;
+        collision.point = event.point;
+        collision.impulse = event.impulse;
+
+        if (event.objectA && event.objectA->hasScripts())
+        {
+            collision.other = event.objectB;
+            collision.normal = event.normal;
+            event.objectA->collisionScripts(event.type, collision);
+        }
+        if (event.objectB && event.objectB->hasScripts())
+        {
+            collision.other = event.objectA;
+            collision.normal = -event.normal;
+            event.objectB->collisionScripts(event.type, collision);
+        }
+    }
+    contactEventBuffer.clear();
+}
+
+/**
+ * @brief Blends each object's render pose between the last two physics ticks.
+ *
+ * Gameplay keeps using the latest tick (transform), only drawing is blended.
+ * In editor mode the interpolated poses are dropped so the renderer draws the
+ * transform the gizmo is editing.
+ */
+void Scene::updateRenderInterpolation(EngineMode mode, float interpolationAlpha) {
+    PROFILE_SCOPE("Scene::updateRenderInterpolation");
+    if (mode == EngineMode::Game || mode == EngineMode::Test)
+    {
+        float alpha = std::clamp(interpolationAlpha, 0.0f, 1.0f);
+        for (auto& obj : gameObjects)
+        {
+            PhysicsComponent* physics = obj->getPhysics();
+            if (physics && physics->hasPoseHistory())
+            {
+                glm::vec3 position;
+                glm::quat rotation;
+                physics->getInterpolatedPose(alpha, position, rotation);
+                obj->getRender().setInterpolatedPose(position, rotation);
+            }
+            else
+            {
+                obj->getRender().clearInterpolatedPose();
+            }
+        }
+        renderInterpolationActive = true;
+    }
+    else if (renderInterpolationActive)
+    {
+        for (auto& obj : gameObjects) {
+            obj->getRender().clearInterpolatedPose();
+            if (obj->getPhysics())
+                obj->getPhysics()->resetPoseHistory();
+        }
+        renderInterpolationActive = false;
+    }
+}
+
+/**
+ * @brief Re-bins the objects whose position or scale changed since the last call.
+ *
+ * TransformComponent marks itself dirty when its position or scale changes,
+ * which covers the editor, scripts and the physics sync (only bodies Bullet
+ * moved are synced). Static objects are skipped with a flag check, and
+ * every backend's updateObject() returns early while the object stays in its
+ * cell range, node or fat box, so an idle frame costs one branch per object.
+ */
+void Scene::updateSpatialGrid() {
+    PROFILE_SCOPE("Scene::updateSpatialGrid");
+    if (!spatialIndex)
+        return;
+
+    for (auto& obj : gameObjects) {
+        TransformComponent& transform = obj->getTransform();
+        if (!transform.isSpatialDirty())
+            continue;
+
+        spatialIndex->updateObject(obj.get());
+        transform.clearSpatialDirty();
+    }
+}
+
+/**
+ * @brief Records the pose of every body that moved, for render interpolation.
+ *
+ * Called once per fixed tick (or once per batch of pipelined ticks) right
+ * after physics has stepped. Only bodies in the physics moved list are
+ * visited, so static and sleeping bodies cost nothing here:
+ * - moved bodies capture their pose and are queued for the transform sync
+ *   in updateObjects()
+ * - bodies that moved last tick but not this one capture once more, which
+ *   makes previous == current so the interpolation settles where they stopped
+ * Static bodies never get a pose history and are drawn at their transform.
+ */
+void Scene::capturePhysicsPoses() {
+    PROFILE_SCOPE("Scene::capturePhysicsPoses");
+    poseTick++;
+
+    for (btRigidBody* body : physicsWorld.getMovedBodies())
+    {
+        GameObject* obj = static_cast<GameObject*>(body->getUserPointer());
+        PhysicsComponent* physics = obj ? obj->getPhysics() : nullptr;
+        if (!physics || physics->getRigidBody() != body)
+            continue;
+
+        physics->capturePose();
+        physics->setLastPoseTick(poseTick);
+        posedThisTick.push_back(obj);
+
+        if (!physics->isTransformSyncQueued())
+        {
+            physics->setTransformSyncQueued(true);
+            transformSyncList.push_back(obj);
+        }
+    }
+    physicsWorld.clearMovedBodies();
+
+    for (GameObject* obj : posedLastTick)
+    {
+        PhysicsComponent* physics = obj->getPhysics();
+        if (physics && physics->getLastPoseTick() != poseTick)
+            physics->capturePose();
+    }
 
+    posedLastTick.swap(posedThisTick);
+    posedThisTick.clear();
+}
+
+/**
+ * @brief Fills a render snapshot from the current scene state.
+ *
+ * Called on the main thread once per frame before the physics worker is
+ * kicked. The renderer then draws from the snapshot only.
+ */
+void Scene::buildRenderSnapshot(RenderSnapshot& out,
+    const GameObject* primarySelection,
+    const std::vector<GameObject*>& selectedObjects) const
+{
+    PROFILE_SCOPE("Scene::buildRenderSnapshot");
+    out.objects.reserve(gameObjects.size());
+
+    for (const auto& obj : gameObjects)
+    {
+        RenderSnapshotObject item;
+        item.object = obj.get();
+        item.position = obj->getRenderPosition();
+        item.rotation = obj->getRenderRotation();
+        item.scale = obj->getScale();
+        item.collisionScale = item.scale;
+        // Box shapes carry a margin, the debug wireframe shows the real extents
+        const btRigidBody* body = obj->getRigidBody();
+        if (body && body->getCollisionShape() && body->getCollisionShape()->getShapeType() == BOX_SHAPE_PROXYTYPE)
+        {
+            btVector3 half = static_cast<const btBoxShape*>(body->getCollisionShape())->getHalfExtentsWithMargin();
+            item.collisionScale = glm::vec3(half.x(), half.y(), half.z()) * 2.0f;
+        }
+        item.primarySelection = primarySelection == obj.get();
+        item.selected = !selectedObjects.empty() &&
+            std::find(selectedObjects.begin(), selectedObjects.end(), obj.get()) != selectedObjects.end();
+        out.objects.push_back(item);
+    }
+
+    for (PointLight* light : PointLightRegistry::getInstance().getAllLights())
+    {
+        if (!light || !light->isEnabled()) continue;
+        out.pointLights.push_back({ light->getPosition(), light->getColour(), light->getIntensity(), light->getRadius() });
+    }
+
+    for (Trigger* trigger : TriggerRegistry::getInstance().getAllTriggers())
+    {
+        if (!trigger || !trigger->isEnabled()) continue;
+        out.triggers.push_back({ trigger->getPosition(), trigger->getSize(), trigger->getType() });
+    }
+
+    for (ForceGenerator* generator : ForceGeneratorRegistry::getInstance().getAllGenerators())
+    {
+        if (!generator || !generator->isEnabled()) continue;
+        out.forceGenerators.push_back({ generator->getPosition(), generator->getRadius(), generator->getType() });
+    }
 }
 
 // Spatial Queries
@@ -428,8 +683,8 @@ std::vector<GameObject*> Scene::findObjectsInRadius(
     std::function<bool(GameObject*)> filter) const
 {
     // Use spatial grid if enabled - queries only nearby cells (O(k) where k = objects in range)
-    if (spatialGrid) {
-        return spatialGrid->queryRadius(center, radius, filter);
+    if (spatialIndex) {
+        return spatialIndex->queryRadius(center, radius, filter);
     }
 
     // Fallback: Check every object in scene (O(n) - slower but works for small scenes)
@@ -459,8 +714,8 @@ GameObject* Scene::findNearestObject(
     std::function<bool(GameObject*)> filter) const
 {
     // Use spatial grid if enabled
-    if (spatialGrid) {
-        return spatialGrid->queryNearest(position, maxRadius, filter);
+    if (spatialIndex) {
+        return spatialIndex->queryNearest(position, maxRadius, filter);
     }
 
     // Fallback: Check all objects and track closest
@@ -485,6 +740,42 @@ GameObject* Scene::findNearestObject(
     return nearest;  // Returns nullptr if nothing found
 }
 
+void Scene::findKNearestObjects(
+    const glm::vec3& position,
+    int k,
+    float maxRadius,
+    std::vector<GameObject*>& out,
+    std::function<bool(GameObject*)> filter) const
+{
+    // Use spatial grid if enabled - searches outwards and stops once the k closest are settled
+    if (spatialIndex) {
+        spatialIndex->queryKNearest(position, k, maxRadius, out, filter);
+        return;
+    }
+
+    // Fallback: gather everything in range, keep the k closest
+    out.clear();
+    if (k <= 0) return;
+
+    float maxRadiusSquared = maxRadius * maxRadius;
+    for (const auto& obj : gameObjects) {
+        if (filter && !filter(obj.get())) continue;
+
+        glm::vec3 diff = obj->getPosition() - position;
+        if (glm::dot(diff, diff) <= maxRadiusSquared)
+            out.push_back(obj.get());
+    }
+
+    auto closer = [&position](GameObject* a, GameObject* b) {
+        glm::vec3 da = a->getPosition() - position;
+        glm::vec3 db = b->getPosition() - position;
+        return glm::dot(da, da) < glm::dot(db, db);
+    };
+    size_t keep = std::min(out.size(), static_cast<size_t>(k));
+    std::partial_sort(out.begin(), out.begin() + keep, out.end(), closer);
+    out.resize(keep);
+}
+
 std::vector<GameObject*> Scene::findObjectsByTag(const std::string& tag) const
 {
     std::vector<GameObject*> results;
@@ -499,26 +790,42 @@ std::vector<GameObject*> Scene::findObjectsByTag(const std::string& tag) const
 
 void Scene::setSpatialGridEnabled(bool enabled) {
     // Enabling grid when it doesn't exist
-    if (enabled && !spatialGrid) {
-        spatialGrid = std::make_unique<SpatialGrid>(10.0f);
+    if (enabled && !spatialIndex) {
+        spatialIndex = createSpatialIndex(spatialIndexType, spatialCellSize);
 
         // Populate grid with all existing objects
         for (const auto& obj : gameObjects) {
-            spatialGrid->insertObject(obj.get());
+            spatialIndex->insertObject(obj.get());
         }
         std::cout << "Spatial grid enabled" << std::endl;
     }
     // Disabling grid when it exists
-    else if (!enabled && spatialGrid) {
-        spatialGrid.reset();  // Destroys grid and frees memory
+    else if (!enabled && spatialIndex) {
+        spatialIndex.reset();  // Destroys grid and frees memory
         std::cout << "Spatial grid disabled" << std::endl;
     }
     // else: Already in requested state, do nothing
 }
 
+void Scene::setSpatialIndexType(SpatialIndexType type, float cellSize) {
+    spatialIndexType = type;
+    spatialCellSize = cellSize;
+
+    // Disabled stays disabled, the type is used when it is enabled again
+    if (!spatialIndex)
+        return;
+
+    spatialIndex = createSpatialIndex(type, cellSize);
+    for (const auto& obj : gameObjects) {
+        spatialIndex->insertObject(obj.get());
+        obj->getTransform().clearSpatialDirty();
+    }
+    std::cout << "Spatial index: " << spatialIndexTypeToString(type) << std::endl;
+}
+
 void Scene::printSpatialStats() const {
-    if (spatialGrid) {
-        spatialGrid->printStats();  // Show cell count, objects per cell, memory usage
+    if (spatialIndex) {
+        spatialIndex->printStats();  // Show cells or nodes, objects per cell or node
     }
     else {
         std::cout << "Spatial grid is disabled" << std::endl;
@@ -553,10 +860,13 @@ void Scene::clear() {
         }
     }
 
-    if (spatialGrid) {
-        spatialGrid->clear();
+    if (spatialIndex) {
+        spatialIndex->clear();
     }
 
+    transformSyncList.clear();
+    posedLastTick.clear();
+    posedThisTick.clear();
     gameObjects.clear();
 }
 
@@ -565,9 +875,10 @@ void Scene::requestDestroy(GameObject* obj)
     if (!obj) return;
 
     // Prevent double-queue
-    if (std::find(pendingDestroy.begin(), pendingDestroy.end(), obj) != pendingDestroy.end())
+    if (obj->isDestroyQueued())
         return;
 
+    obj->setDestroyQueued(true);
     pendingDestroy.push_back(obj);
 }
 
@@ -582,15 +893,15 @@ GameObject* Scene::loadAndSpawnModel(const std::string& filepath,
     const std::string& materialName)
 {
     // Load mesh from file
-    Mesh loadedMesh = MeshFactory::loadFromFile(filepath);
+    Mesh loadedMesh = MeshFactory::loadFromFile(filepath, renderer != nullptr);
 
     // Check if load was successful (mesh has vertices)
     if (loadedMesh.getVertexCount() == 0) {
-        std::cerr << "Failed to load model from: " << filepath << std::endl;
+        LOG_ERROR(LogCategory::Scene, "Failed to load model from: " << filepath);
         return nullptr;
     }
 
-    std::cout << "Successfully loaded model: " << filepath << std::endl;
+    LOG_INFO(LogCategory::Scene, "Successfully loaded model: " << filepath);
 
     // Store mesh in static cache
     static std::unordered_map<std::string, Mesh> loadedMeshes;
@@ -606,8 +917,6 @@ GameObject* Scene::loadAndSpawnModel(const std::string& filepath,
 
         glm::vec3 minBounds(FLT_MAX);
         glm::vec3 maxBounds(-FLT_MAX);
-        std::cout << "minBounds Y (raw before normalization): " << minBounds.y << std::endl;
-        std::cout << "maxBounds Y (raw before normalization): " << maxBounds.y << std::endl;
         for (size_t i = 0; i < verts.size(); i += FLOATS_PER_VERTEX)
         {
             glm::vec3 p(verts[i], verts[i + 1], verts[i + 2]);
@@ -630,14 +939,11 @@ GameObject* Scene::loadAndSpawnModel(const std::string& filepath,
             position.z + meshCenter.z
         );
         glm::vec3 fullExtents = halfExtents * 2.0f;
-        // DEBUG 
-        std::cout << "minBounds: " << minBounds.y << std::endl;
-        std::cout << "maxBounds: " << maxBounds.y << std::endl;
-        std::cout << "meshCenter.y: " << meshCenter.y << std::endl;
-        std::cout << "meshScale: " << meshScale.x << ", " << meshScale.y << ", " << meshScale.z << std::endl;
-        std::cout << "scaledMin.y: " << scaledMin.y << std::endl;
-        std::cout << "scaledMax.y: " << scaledMax.y << std::endl;
-        std::cout << "halfExtents (final): " << halfExtents.x << ", " << halfExtents.y << ", " << halfExtents.z << std::endl;
+        LOG_DEBUG(LogCategory::Scene, "Model bounds: min.y=" << minBounds.y << " max.y=" << maxBounds.y
+            << " meshCenter.y=" << meshCenter.y
+            << " meshScale=(" << meshScale.x << ", " << meshScale.y << ", " << meshScale.z << ")"
+            << " scaled y=[" << scaledMin.y << ", " << scaledMax.y << "]"
+            << " halfExtents=(" << halfExtents.x << ", " << halfExtents.y << ", " << halfExtents.z << ")");
         // Create rigid body at adjusted position
         btRigidBody* body = physicsWorld.createRigidBody(
             ShapeType::CUBE,
@@ -669,8 +975,8 @@ GameObject* Scene::loadAndSpawnModel(const std::string& filepath,
         obj = objUnique.get();
         gameObjects.push_back(std::move(objUnique));
 
-        if (spatialGrid) {
-            spatialGrid->insertObject(obj);
+        if (spatialIndex) {
+            spatialIndex->insertObject(obj);
         }
     }
     else {
@@ -685,8 +991,8 @@ GameObject* Scene::loadAndSpawnModel(const std::string& filepath,
         obj = objUnique.get();
         gameObjects.push_back(std::move(objUnique));
 
-        std::cout << "Spawned render-only model at (" << position.x << ", "
-            << position.y << ", " << position.z << ")" << std::endl;
+        LOG_DEBUG(LogCategory::Scene, "Spawned render-only model at (" << position.x << ", "
+            << position.y << ", " << position.z << ")");
     }
     // wire up tag->script callback for model-spawned objects too
     wireTagCallback(obj);
@@ -733,8 +1039,8 @@ void Scene::setObjectPhysicsScale(GameObject* obj, const glm::vec3& newPhysicsSc
         obj->getPhysics()->setRigidBody(newBody);
         obj->setPhysicsScale(newPhysicsScale);
 
-        if (spatialGrid) {
-            spatialGrid->updateObject(obj);
+        if (spatialIndex) {
+            spatialIndex->updateObject(obj);
         }
 
         std::cout << "Physics scale updated successfully" << std::endl;
@@ -744,7 +1050,7 @@ void Scene::setObjectPhysicsScale(GameObject* obj, const glm::vec3& newPhysicsSc
     }
 }
 
-bool Scene::saveToFile(const std::string& path) const
+bool Scene::saveToFile(const std::string& path, bool includeMotion) const
 {
     json sceneJson;
     sceneJson["objects"] = json::array();
@@ -808,6 +1114,25 @@ bool Scene::saveToFile(const std::string& path) const
 
             o["physics"]["mass"] = mass;
             o["physics"]["material"] = obj.getMaterialName();
+            o["physics"]["layer"] = CollisionLayers::getInstance().getLayerName(physicsWorld.getCollisionLayer(rb));
+
+            // Mid-simulation snapshot (input recordings): keep the body's exact pose,
+            // velocities and sleep state so a replay resumes instead of starting at rest
+            if (includeMotion && rb->getInvMass() != 0.0f)
+            {
+                const btTransform& t = rb->getWorldTransform();
+                const btQuaternion r = t.getRotation();
+                const btVector3& lv = rb->getLinearVelocity();
+                const btVector3& av = rb->getAngularVelocity();
+
+                json& m = o["physics"]["motion"];
+                m["position"] = { t.getOrigin().x(), t.getOrigin().y(), t.getOrigin().z() };
+                m["rotation"] = { r.x(), r.y(), r.z(), r.w() };
+                m["linearVelocity"] = { lv.x(), lv.y(), lv.z() };
+                m["angularVelocity"] = { av.x(), av.y(), av.z() };
+                m["activationState"] = rb->getActivationState();
+                m["deactivationTime"] = rb->getDeactivationTime();
+            }
         }
 
         sceneJson["objects"].push_back(o);
@@ -853,6 +1178,7 @@ bool Scene::saveToFile(const std::string& path) const
 
 		// will be empty string for TELEPORT and SPEED_ZONE triggers which have no behaviour tag
         t["behaviourTag"] = trigger->getBehaviourTag();
+        t["layer"] = CollisionLayers::getInstance().getLayerName(trigger->getCollisionLayer());
 
         sceneJson["triggers"].push_back(t);
     }
@@ -931,6 +1257,27 @@ bool Scene::saveToFile(const std::string& path) const
         return false;
     }
 
+    // Collision layer names and, per layer, the layers it collides with
+    const CollisionLayers& layers = CollisionLayers::getInstance();
+    json& cl = sceneJson["collisionLayers"];
+    cl["layers"] = json::array();
+    cl["matrix"] = json::object();
+    for (int a = 0; a < layers.getLayerCount(); a++)
+    {
+        cl["layers"].push_back(layers.getLayerName(a));
+
+        json row = json::array();
+        for (int b = 0; b < layers.getLayerCount(); b++)
+            if (layers.shouldCollide(a, b))
+                row.push_back(layers.getLayerName(b));
+        cl["matrix"][layers.getLayerName(a)] = row;
+    }
+
+    // Spatial index backend, scenes saved without it load with the grid
+    json& si = sceneJson["spatialIndex"];
+    si["type"] = spatialIndexTypeToString(spatialIndexType);
+    si["cellSize"] = spatialCellSize;
+
     // Save directional light settings separately since they aren't GameObjects
     json& dl = sceneJson["directionalLight"];
     dl["direction"] = { savedLightDir.x, savedLightDir.y, savedLightDir.z };
@@ -959,6 +1306,50 @@ bool Scene::loadFromFile(const std::string& path)
     // Remove existing objects
     clear();
 
+    // Collision layers first so bodies can be put on them as they spawn.
+    // Scenes saved before layers existed use the built-in matrix.
+    CollisionLayers& layers = CollisionLayers::getInstance();
+    layers.resetDefaults();
+    if (sceneJson.contains("collisionLayers"))
+    {
+        const auto& cl = sceneJson["collisionLayers"];
+        if (cl.contains("layers"))
+            for (const auto& name : cl["layers"])
+                layers.addLayer(name.get<std::string>());
+
+        if (cl.contains("matrix"))
+        {
+            for (auto it = cl["matrix"].begin(); it != cl["matrix"].end(); ++it)
+            {
+                int a = layers.findLayer(it.key());
+                if (a < 0) continue;
+
+                for (int b = 0; b < layers.getLayerCount(); b++)
+                    layers.setCollides(a, b, false);
+                for (const auto& name : it.value())
+                    layers.setCollides(a, layers.findLayer(name.get<std::string>()), true);
+            }
+        }
+    }
+
+    // Spatial index before the objects so they are inserted once, into the right backend
+    SpatialIndexType indexType = SpatialIndexType::UniformGrid;
+    float cellSize = 10.0f;
+    if (sceneJson.contains("spatialIndex"))
+    {
+        const auto& si = sceneJson["spatialIndex"];
+        if (si.contains("type") && !spatialIndexTypeFromString(si["type"].get<std::string>(), indexType))
+            std::cout << "Unknown spatial index '" << si["type"].get<std::string>() << "', using grid" << std::endl;
+        if (si.contains("cellSize"))
+            cellSize = si["cellSize"].get<float>();
+    }
+    if (indexType != spatialIndexType || cellSize != spatialCellSize)
+        setSpatialIndexType(indexType, cellSize);
+
+    // Bodies saved mid-simulation, restored after the freeze pass below
+    std::vector<std::pair<GameObject*, const json*>> savedMotion;
+    bool layersAssigned = false;
+
     for (const auto& o : sceneJson["objects"])
     {
         ShapeType shape = (ShapeType)o["shape"].get<int>();
@@ -1018,6 +1409,20 @@ bool Scene::loadFromFile(const std::string& path)
                 obj->getPhysics()->syncFromTransform(obj->getTransform());
                 obj->updateFromPhysics();
             }
+
+            if (obj && obj->hasPhysics() && o["physics"].contains("layer"))
+            {
+                // Filters are applied once for all bodies after the loop
+                int layer = layers.findLayer(o["physics"]["layer"].get<std::string>());
+                if (layer >= 0 && layer != physicsWorld.getCollisionLayer(obj->getRigidBody()))
+                {
+                    physicsWorld.assignCollisionLayer(obj->getRigidBody(), layer);
+                    layersAssigned = true;
+                }
+            }
+
+            if (obj && obj->hasPhysics() && o["physics"].contains("motion"))
+                savedMotion.emplace_back(obj, &o["physics"]["motion"]);
         }
         else
         {
@@ -1045,6 +1450,10 @@ bool Scene::loadFromFile(const std::string& path)
                 obj->addTag(tag.get<std::string>());
     }
 
+    // One pass over the pair cache instead of one per re-layered body
+    if (layersAssigned)
+        physicsWorld.refreshCollisionFilters();
+
     std::cout << "Scene loaded from " << path << std::endl;
     if (sceneJson.contains("triggers"))
     {
@@ -1111,7 +1520,14 @@ bool Scene::loadFromFile(const std::string& path)
 
             if (t.contains("behaviourTag"))
                 trigger->setBehaviourTag(t["behaviourTag"].get<std::string>());
-            std::cout << "Loaded trigger: " << name << std::endl;
+
+            if (t.contains("layer"))
+            {
+                int layer = layers.findLayer(t["layer"].get<std::string>());
+                if (layer >= 0)
+                    TriggerRegistry::getInstance().setCollisionLayer(trigger, layer);
+            }
+            LOG_DEBUG(LogCategory::Scene, "Loaded trigger: " << name);
         }
 
         std::cout << "Triggers loaded successfully" << std::endl;
@@ -1195,7 +1611,7 @@ bool Scene::loadFromFile(const std::string& path)
             if (gen)
             {
                 gen->setEnabled(enabled);
-                std::cout << "Loaded force generator: " << name << std::endl;
+                LOG_DEBUG(LogCategory::Scene, "Loaded force generator: " << name);
             }
         }
         std::cout << "Force generators loaded successfully" << std::endl;
@@ -1228,6 +1644,35 @@ bool Scene::loadFromFile(const std::string& path)
         }
     }
 
+    // --- Resume bodies that were moving when the file was saved ---
+    for (const auto& [obj, m] : savedMotion)
+    {
+        btRigidBody* body = obj->getRigidBody();
+        const json& motion = *m;
+
+        btTransform t;
+        t.setOrigin(btVector3(motion["position"][0], motion["position"][1], motion["position"][2]));
+        t.setRotation(btQuaternion(motion["rotation"][0], motion["rotation"][1],
+            motion["rotation"][2], motion["rotation"][3]));
+        body->setWorldTransform(t);
+        body->setInterpolationWorldTransform(t);
+        if (body->getMotionState())
+            body->getMotionState()->setWorldTransform(t);
+
+        btVector3 lv(motion["linearVelocity"][0], motion["linearVelocity"][1], motion["linearVelocity"][2]);
+        btVector3 av(motion["angularVelocity"][0], motion["angularVelocity"][1], motion["angularVelocity"][2]);
+        body->setLinearVelocity(lv);
+        body->setAngularVelocity(av);
+        body->setInterpolationLinearVelocity(lv);
+        body->setInterpolationAngularVelocity(av);
+
+        body->forceActivationState(motion["activationState"].get<int>());
+        body->setDeactivationTime(motion["deactivationTime"].get<btScalar>());
+
+        obj->updateFromPhysics();
+        obj->getPhysics()->resetPoseHistory();
+    }
+
     return true;
 }
 
@@ -1,8 +1,19 @@
 #include "../include/Testing/TestUI.h"
 #include "../External/imgui/core/imgui.h"
 #include "../include/Core/GameTime.h"
+#include "../include/Core/AllocationTracker.h"
+#include "../include/Core/Benchmark.h"
+#include "../include/Misc/FileUtils.h"
+#include <algorithm>
+#include <filesystem>
 
-void TestUI::draw()
+namespace
+{
+    // Same relative layout as the scene folder in SceneSavePanel
+    const char* BenchmarkFolder = "../../assets/benchmarks";
+}
+
+void TestUI::draw(const BenchmarkRecorder& benchmark)
 {
     ImGuiIO& io = ImGui::GetIO();
 
@@ -27,5 +38,108 @@ void TestUI::draw()
         ImGui::TextColored(ImVec4(1, 0, 0, 1), "Status: FAIL");
     }
 
+    ImGui::Separator();
+    ImGui::Text("=== Allocation Test ===");
+
+    if (!AllocationTracker::isCompiledIn())
+    {
+        ImGui::TextDisabled("Build with ENGINE_TRACK_ALLOCATIONS=ON to enable");
+    }
+    else
+    {
+        if (ImGui::InputInt("Budget (allocs/frame)", &allocationBudget))
+        {
+            if (allocationBudget < 0) allocationBudget = 0;
+            AllocationTracker::setFrameBudget(static_cast<uint64_t>(allocationBudget));
+        }
+
+        ImGui::Text("Allocations: %llu (peak %llu)",
+            static_cast<unsigned long long>(AllocationTracker::getFrameAllocations()),
+            static_cast<unsigned long long>(AllocationTracker::getPeakFrameAllocations()));
+
+        if (allocationBudget == 0)
+        {
+            ImGui::TextDisabled("Status: no budget set");
+        }
+        else if (AllocationTracker::getFramesOverBudget() == 0)
+        {
+            ImGui::TextColored(ImVec4(0, 1, 0, 1), "Status: PASS");
+        }
+        else
+        {
+            ImGui::TextColored(ImVec4(1, 0, 0, 1), "Status: FAIL (%llu frames over budget)",
+                static_cast<unsigned long long>(AllocationTracker::getFramesOverBudget()));
+        }
+
+        if (ImGui::Button("Reset"))
+            AllocationTracker::resetBudgetStats();
+    }
+
+    ImGui::Separator();
+    ImGui::Text("=== Benchmark ===");
+
+    if (!scenariosLoaded)
+    {
+        scenarioFiles = FileUtils::getFilesInDirectory(BenchmarkFolder, { ".json" });
+        std::sort(scenarioFiles.begin(), scenarioFiles.end());
+        selectedScenario = 0;
+        scenariosLoaded = true;
+    }
+
+    if (benchmark.isRunning())
+    {
+        ImGui::Text("Running: %s", benchmark.getScenarioName().c_str());
+        float progress = benchmark.getFramesTotal() > 0
+            ? static_cast<float>(benchmark.getFramesDone()) / benchmark.getFramesTotal() : 0.0f;
+        ImGui::ProgressBar(progress);
+    }
+    else if (scenarioFiles.empty())
+    {
+        ImGui::TextDisabled("No scenarios in %s", BenchmarkFolder);
+    }
+    else
+    {
+        if (selectedScenario >= static_cast<int>(scenarioFiles.size()))
+            selectedScenario = 0;
+
+        std::string preview = std::filesystem::path(scenarioFiles[selectedScenario]).stem().string();
+        if (ImGui::BeginCombo("Scenario", preview.c_str()))
+        {
+            for (int i = 0; i < static_cast<int>(scenarioFiles.size()); i++)
+            {
+                std::string label = std::filesystem::path(scenarioFiles[i]).stem().string();
+                if (ImGui::Selectable(label.c_str(), i == selectedScenario))
+                    selectedScenario = i;
+            }
+            ImGui::EndCombo();
+        }
+
+        if (ImGui::Button("Run"))
+            pendingScenario = scenarioFiles[selectedScenario];
+        ImGui::SameLine();
+        if (ImGui::Button("Refresh"))
+            scenariosLoaded = false;
+    }
+
+    if (benchmark.hasLastResult())
+    {
+        const BenchmarkResult& result = benchmark.getLastResult();
+        ImGui::Text("Last: %s (%d frames)", result.scenario.c_str(), result.frames);
+        ImGui::Text("Frame ms avg %.2f  p99 %.2f  max %.2f", result.frameAvgMs, result.frameP99Ms, result.frameMaxMs);
+        ImGui::Text("Physics ms avg %.2f  p99 %.2f", result.physicsAvgMs, result.physicsP99Ms);
+        ImGui::Text("Peak RSS %.1f MB", result.peakResidentMB);
+        ImGui::TextDisabled("Saved to benchmark_results/");
+    }
+
     ImGui::End();
-}
\ No newline at end of file
+}
+
+bool TestUI::consumeBenchmarkRequest(std::string& scenarioPath)
+{
+    if (pendingScenario.empty())
+        return false;
+
+    scenarioPath = pendingScenario;
+    pendingScenario.clear();
+    return true;
+}
@@ -0,0 +1,64 @@
+#include "../include/UI/CollisionLayerPanel.h"
+#include "../include/Physics/CollisionLayers.h"
+#include "../External/imgui/core/imgui.h"
+
+void DrawCollisionLayerPanel(DebugUIContext& context)
+{
+    ImGui::Begin("Collision Layers");
+
+    CollisionLayers& layers = CollisionLayers::getInstance();
+    int count = layers.getLayerCount();
+
+    ImGui::Text("Broadphase Pairs: %d", context.physics.broadphasePairs);
+    ImGui::TextDisabled("Changes apply before the next physics step");
+    ImGui::Separator();
+
+    // Lower triangle of the matrix, the matrix is symmetric
+    if (ImGui::BeginTable("LayerMatrix", count + 1,
+        ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollX))
+    {
+        ImGui::TableSetupColumn("");
+        for (int b = 0; b < count; b++)
+            ImGui::TableSetupColumn(layers.getLayerName(b).c_str());
+        ImGui::TableHeadersRow();
+
+        for (int a = 0; a < count; a++)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(layers.getLayerName(a).c_str());
+
+            for (int b = 0; b <= a; b++)
+            {
+                ImGui::TableSetColumnIndex(b + 1);
+                ImGui::PushID(a * CollisionLayers::MaxLayers + b);
+                bool collide = layers.shouldCollide(a, b);
+                if (ImGui::Checkbox("##collide", &collide))
+                    layers.setCollides(a, b, collide);
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+
+    static char newLayerName[64] = "";
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::InputText("##NewLayer", newLayerName, sizeof(newLayerName));
+    ImGui::SameLine();
+    bool full = count >= CollisionLayers::MaxLayers;
+    if (full) ImGui::BeginDisabled();
+    if (ImGui::Button("Add Layer") && newLayerName[0] != '\0')
+    {
+        layers.addLayer(newLayerName);
+        newLayerName[0] = '\0';
+    }
+    if (full) ImGui::EndDisabled();
+
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Defaults"))
+        layers.resetDefaults();
+
+    ImGui::End();
+}
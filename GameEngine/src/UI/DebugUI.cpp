@@ -7,8 +7,11 @@
 #include "../include/UI/TriggerEditorPanel.h"
 #include "../include/UI/ForceGeneratorPanel.h"
 #include "../include/UI/PointLightPanel.h"
+#include "../include/UI/ProfilerPanel.h"
+#include "../include/UI/CollisionLayerPanel.h"
 #include "../External/imgui/core/imgui.h"
 #include "../External/imgui/core/imgui_internal.h"
+#include <cstdio>
 
 void DebugUI::draw(DebugUIContext& context)
 {
@@ -57,12 +60,62 @@ void DebugUI::draw(DebugUIContext& context)
     // Frame timing information
     ImGui::Text("FPS: %.1f", context.time.fps);
     ImGui::Text("Delta Time: %.4f s", context.time.deltaTime);
+    ImGui::Text("Frame ms p50/p95/p99: %.2f / %.2f / %.2f",
+        context.time.frameTimeP50, context.time.frameTimeP95, context.time.frameTimeP99);
+
+    // Frame pacing jitter (frame time minus target), centre bar = on target
+    if (context.time.jitterHistogram && context.time.jitterBinCount > 0)
+    {
+        float bins[64] = {};
+        int binCount = context.time.jitterBinCount < 64 ? context.time.jitterBinCount : 64;
+        float maxBin = 1.0f;
+        for (int i = 0; i < binCount; i++)
+        {
+            bins[i] = static_cast<float>(context.time.jitterHistogram[i]);
+            if (bins[i] > maxBin) maxBin = bins[i];
+        }
+        float halfRange = context.time.jitterBinWidthMs * (binCount / 2);
+        char label[64];
+        snprintf(label, sizeof(label), "Jitter +-%.1fms", halfRange);
+        ImGui::PlotHistogram("##Jitter", bins, binCount, 0, label, 0.0f, maxBin, ImVec2(0.0f, 50.0f));
+    }
+    ImGui::Text("Pacer spin: %.2f ms (margin %.2f ms)", context.time.lastSpinMs, context.time.spinMarginMs);
 
     ImGui::Separator();
 
     // Physics debug information
     ImGui::Text("Rigid Bodies: %d", context.physics.rigidBodyCount);
+    ImGui::Text("Collision Shapes: %d (shared)", context.physics.collisionShapeCount);
     ImGui::Text("Physics Enabled: %s", context.physics.physicsEnabled ? "Yes" : "No");
+    ImGui::Text("Physics Tick Rate: %.0f Hz", context.physics.tickRate);
+    ImGui::Text("Interpolation Alpha: %.2f", context.physics.interpolationAlpha);
+    ImGui::Text("Pipelined Physics (P): %s", context.physics.pipelined ? "On" : "Off");
+    if (context.physics.multithreaded)
+    {
+        int threads = context.physics.solverThreads;
+        if (ImGui::SliderInt("Physics Threads", &threads, 1, context.physics.maxSolverThreads) && context.setPhysicsThreadCount)
+            context.setPhysicsThreadCount(threads);
+    }
+    else
+    {
+        ImGui::Text("Physics Threads: 1 (single-threaded world)");
+    }
+
+    ImGui::Separator();
+
+    // Heap allocations (needs the ENGINE_TRACK_ALLOCATIONS build option)
+    if (context.memory.trackingCompiledIn)
+    {
+        ImGui::Text("Allocs/frame: %d (%.1f KB), frees %d",
+            context.memory.allocationsPerFrame, context.memory.kilobytesPerFrame, context.memory.freesPerFrame);
+        ImGui::Text("Peak allocs/frame: %d", context.memory.peakAllocationsPerFrame);
+        if (context.memory.allocationBudget > 0)
+            ImGui::Text("Budget: %d, frames over: %d", context.memory.allocationBudget, context.memory.framesOverBudget);
+    }
+    else
+    {
+        ImGui::TextDisabled("Allocation tracking off (ENGINE_TRACK_ALLOCATIONS)");
+    }
 
     ImGui::Separator();
     if (ImGui::Button("Reset Layout"))
@@ -80,6 +133,8 @@ void DebugUI::draw(DebugUIContext& context)
     DrawTriggerEditorPanel(context);
     DrawForceGeneratorPanel(context);
     DrawPointLightPanel(context);
+    DrawProfilerPanel(context);
+    DrawCollisionLayerPanel(context);
 }
 void DebugUI::buildDefaultLayout(ImGuiID dockspaceID, ImGuiViewport* viewport)
 {
@@ -122,6 +177,8 @@ void DebugUI::buildDefaultLayout(ImGuiID dockspaceID, ImGuiViewport* viewport)
     ImGui::DockBuilderDockWindow("Point Lights", dockBottom);
     ImGui::DockBuilderDockWindow("Lighting", dockBottom);
     ImGui::DockBuilderDockWindow("Scene Manager", dockBottom);
+    ImGui::DockBuilderDockWindow("Profiler", dockBottom);
+    ImGui::DockBuilderDockWindow("Collision Layers", dockBottom);
 
     ImGui::DockBuilderFinish(dockspaceID);
 }
\ No newline at end of file
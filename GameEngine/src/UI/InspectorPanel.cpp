@@ -1,6 +1,7 @@
 #include "../include/UI/InspectorPanel.h"
 #include "../include/Physics/Constraint.h"
 #include "../include/Physics/ConstraintRegistry.h"
+#include "../include/Physics/CollisionLayers.h"
 #include "../External/imgui/core/imgui.h"
 #include <glm/gtc/constants.hpp>
 #include <vector>
@@ -172,6 +173,22 @@ void DrawInspectorPanel(DebugUIContext& context)
                         glm::vec3(physScaleArr[0], physScaleArr[1], physScaleArr[2]));
             }
             ImGui::TextDisabled("Collision box scale multiplier");
+
+            const CollisionLayers& layers = CollisionLayers::getInstance();
+            int currentLayer = context.selectedObject->getRigidBody()->getUserIndex2();
+            if (ImGui::BeginCombo("Collision Layer", layers.getLayerName(currentLayer).c_str()))
+            {
+                for (int i = 0; i < layers.getLayerCount(); i++)
+                {
+                    bool selected = (i == currentLayer);
+                    if (ImGui::Selectable(layers.getLayerName(i).c_str(), selected) &&
+                        !selected && context.scene.setObjectCollisionLayer)
+                        context.scene.setObjectCollisionLayer(context.selectedObject, i);
+                    if (selected)
+                        ImGui::SetItemDefaultFocus();
+                }
+                ImGui::EndCombo();
+            }
         }
     }
 
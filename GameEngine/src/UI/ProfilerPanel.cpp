@@ -0,0 +1,254 @@
+#include "../include/UI/ProfilerPanel.h"
+#include "../include/Core/Profiler.h"
+#include "../include/Core/AllocationTracker.h"
+#include "../include/Core/Log.h"
+#include "../External/imgui/core/imgui.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const double FrameBudgetMs = 1000.0 / 60.0;
+
+    // Stable colour per zone name so the same zone looks the same every frame
+    ImU32 zoneColour(const char* name)
+    {
+        unsigned int hash = 2166136261u;
+        for (const char* c = name; *c; ++c)
+            hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+
+        float r = 0.35f + 0.5f * ((hash & 0xFF) / 255.0f);
+        float g = 0.35f + 0.5f * (((hash >> 8) & 0xFF) / 255.0f);
+        float b = 0.35f + 0.5f * (((hash >> 16) & 0xFF) / 255.0f);
+        return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+    }
+
+    struct ZoneTotal
+    {
+        const char* name;
+        int calls;
+        double totalMs;
+        double maxMs;
+        uint64_t allocs;
+        uint64_t allocBytes;
+    };
+
+    // Reused every frame so drawing the panel doesn't allocate once they have grown
+    std::vector<uint32_t> threadDepth;
+    std::vector<ZoneTotal> totals;
+}
+
+void DrawProfilerPanel(DebugUIContext& context)
+{
+    ImGui::Begin("Profiler");
+
+    Profiler& profiler = Profiler::getInstance();
+
+    bool enabled = profiler.isEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+        profiler.setEnabled(enabled);
+
+    // Paused keeps showing a copy of the frame that was on screen
+    static bool paused = false;
+    static std::vector<ProfileZoneEvent> pausedEvents;
+    static uint64_t pausedStart = 0, pausedEnd = 0;
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Pause", &paused) && paused)
+    {
+        pausedEvents = profiler.getLastFrameEvents();
+        pausedStart = profiler.getLastFrameStartNs();
+        pausedEnd = profiler.getLastFrameEndNs();
+    }
+
+    const std::vector<ProfileZoneEvent>& events = paused ? pausedEvents : profiler.getLastFrameEvents();
+    uint64_t frameStart = paused ? pausedStart : profiler.getLastFrameStartNs();
+    uint64_t frameEnd = paused ? pausedEnd : profiler.getLastFrameEndNs();
+    double frameMs = (frameEnd - frameStart) / 1.0e6;
+
+    ImGui::Text("Frame: %.2f ms (budget %.1f ms)", frameMs, FrameBudgetMs);
+    if (profiler.getDroppedZoneCount() > 0)
+    {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.2f, 1.0f), "Dropped zones: %llu",
+            (unsigned long long)profiler.getDroppedZoneCount());
+    }
+
+    // Capture / Chrome trace export
+    static int captureFrames = 120;
+    static char tracePath[256] = "profile_trace.json";
+    ImGui::SetNextItemWidth(100.0f);
+    ImGui::InputInt("Frames", &captureFrames);
+    captureFrames = std::max(1, captureFrames);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200.0f);
+    ImGui::InputText("##TracePath", tracePath, sizeof(tracePath));
+    ImGui::SameLine();
+    if (profiler.isCapturing())
+        ImGui::TextDisabled("Capturing...");
+    else if (ImGui::Button("Capture Trace"))
+        profiler.startCapture(captureFrames, tracePath);
+
+    if (!profiler.getLastCapturePath().empty())
+        ImGui::TextDisabled("Last trace: %s (open in chrome://tracing)", profiler.getLastCapturePath().c_str());
+
+    ImGui::SeparatorText("Flame View");
+
+    if (events.empty() || frameEnd <= frameStart)
+    {
+        ImGui::TextDisabled("No zones recorded");
+        ImGui::End();
+        return;
+    }
+
+    // Timeline spans at least the frame budget so over-budget frames stand out
+    double spanNs = std::max(static_cast<double>(frameEnd - frameStart), FrameBudgetMs * 1.0e6);
+
+    uint32_t threadCount = 0;
+    for (const auto& ev : events)
+        threadCount = std::max(threadCount, ev.threadIndex + 1);
+
+    threadDepth.assign(threadCount, 0);
+    for (const auto& ev : events)
+        threadDepth[ev.threadIndex] = std::max(threadDepth[ev.threadIndex], ev.depth + 1);
+
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const float threadGap = 6.0f;
+    float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+
+    float totalHeight = 0.0f;
+    for (uint32_t t = 0; t < threadCount; t++)
+        if (threadDepth[t] > 0) totalHeight += threadDepth[t] * rowHeight + threadGap;
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##FlameView", ImVec2(width, std::max(totalHeight, rowHeight)));
+    bool viewHovered = ImGui::IsItemHovered();
+    ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    // Budget marker
+    float budgetX = origin.x + static_cast<float>(FrameBudgetMs * 1.0e6 / spanNs) * width;
+    drawList->AddLine(ImVec2(budgetX, origin.y), ImVec2(budgetX, origin.y + totalHeight),
+        ImGui::GetColorU32(ImVec4(1.0f, 0.2f, 0.2f, 0.8f)));
+
+    const ProfileZoneEvent* hoveredZone = nullptr;
+    float threadY = origin.y;
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        if (threadDepth[t] == 0) continue;
+
+        for (const auto& ev : events)
+        {
+            if (ev.threadIndex != t) continue;
+
+            // Zones from worker threads can straddle frame boundaries
+            double start = std::max(static_cast<double>(ev.startNs), static_cast<double>(frameStart)) - frameStart;
+            double end = std::max(static_cast<double>(ev.endNs), static_cast<double>(frameStart)) - frameStart;
+
+            float x0 = origin.x + static_cast<float>(start / spanNs) * width;
+            float x1 = origin.x + static_cast<float>(end / spanNs) * width;
+            x1 = std::max(x1, x0 + 1.0f);
+            float y0 = threadY + ev.depth * rowHeight;
+            float y1 = y0 + rowHeight - 1.0f;
+
+            drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), zoneColour(ev.name));
+
+            if (x1 - x0 > 30.0f)
+            {
+                drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+                drawList->AddText(ImVec2(x0 + 3.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), ev.name);
+                drawList->PopClipRect();
+            }
+
+            if (viewHovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+                hoveredZone = &ev;
+        }
+
+        threadY += threadDepth[t] * rowHeight + threadGap;
+    }
+
+    if (hoveredZone)
+    {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s", hoveredZone->name);
+        ImGui::Text("%.3f ms", (hoveredZone->endNs - hoveredZone->startNs) / 1.0e6);
+        ImGui::TextDisabled("Thread %u, depth %u", hoveredZone->threadIndex, hoveredZone->depth);
+        if (AllocationTracker::isCompiledIn())
+            ImGui::Text("%u allocs, %.1f KB", hoveredZone->allocCount, hoveredZone->allocBytes / 1024.0);
+        ImGui::EndTooltip();
+    }
+
+    // Per-zone totals for the frame, heaviest first
+    ImGui::SeparatorText("Zones");
+
+    totals.clear();
+    for (const auto& ev : events)
+    {
+        double ms = (ev.endNs - ev.startNs) / 1.0e6;
+        auto it = std::find_if(totals.begin(), totals.end(),
+            [&](const ZoneTotal& z) { return std::strcmp(z.name, ev.name) == 0; });
+        if (it == totals.end())
+            totals.push_back({ ev.name, 1, ms, ms, ev.allocCount, ev.allocBytes });
+        else
+        {
+            it->calls++;
+            it->totalMs += ms;
+            it->maxMs = std::max(it->maxMs, ms);
+            it->allocs += ev.allocCount;
+            it->allocBytes += ev.allocBytes;
+        }
+    }
+    std::sort(totals.begin(), totals.end(),
+        [](const ZoneTotal& a, const ZoneTotal& b) { return a.totalMs > b.totalMs; });
+
+    // Allocation columns only mean something when the new/delete hook is compiled in
+    const bool showAllocs = AllocationTracker::isCompiledIn();
+    if (ImGui::BeginTable("ZoneTotals", showAllocs ? 6 : 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Total ms");
+        ImGui::TableSetupColumn("Max ms");
+        if (showAllocs)
+        {
+            ImGui::TableSetupColumn("Allocs");
+            ImGui::TableSetupColumn("KB");
+        }
+        ImGui::TableHeadersRow();
+
+        for (const auto& z : totals)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(z.name);
+            ImGui::TableNextColumn(); ImGui::Text("%d", z.calls);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", z.totalMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", z.maxMs);
+            if (showAllocs)
+            {
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(z.allocs));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", z.allocBytes / 1024.0);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    // Per-category log levels, Debug output is the usual console-bound frame cost
+    if (ImGui::CollapsingHeader("Log Levels"))
+    {
+        static const char* levelNames[] = { "Debug", "Info", "Warning", "Error", "Off" };
+        for (int i = 0; i < static_cast<int>(LogCategory::Count); i++)
+        {
+            LogCategory category = static_cast<LogCategory>(i);
+            int level = static_cast<int>(Log::getLevel(category));
+            ImGui::PushID(i);
+            if (ImGui::Combo(Log::getCategoryName(category), &level, levelNames, IM_ARRAYSIZE(levelNames)))
+                Log::setLevel(category, static_cast<LogLevel>(level));
+            ImGui::PopID();
+        }
+        if (!ENGINE_LOG_DEBUG)
+            ImGui::TextDisabled("Debug messages are compiled out of this build");
+        ImGui::Text("Dropped (ring full): %llu", static_cast<unsigned long long>(Log::getDroppedCount()));
+    }
+
+    ImGui::End();
+}